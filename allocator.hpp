@@ -0,0 +1,457 @@
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#ifdef __linux__
+# include <sys/mman.h>
+#endif
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+# define FT_HUGEPAGES
+#endif
+
+namespace ft {
+
+// Allocators with a reallocate member,
+//     pointer reallocate(pointer p, size_type old_n, size_type new_n);
+// let ft::vector grow trivially relocatable elements without copying them.
+// reallocate returns the grown block holding the old contents, or NULL when
+// it cannot do better than allocate + copy; p stays valid in that case.
+
+// Serves blocks of at least Threshold bytes straight from mmap, so that
+// they can later grow with mremap: the kernel moves the page table entries
+// and no element is copied. Smaller blocks come from operator new and are
+// never reallocated in place. Other systems than Linux always use operator
+// new.
+template <class T, std::size_t Threshold = (std::size_t(1) << 20)>
+class mremap_allocator : public std::allocator<T>
+{
+public:
+    typedef T*          pointer;
+    typedef std::size_t size_type;
+
+    static const size_type threshold = Threshold;
+
+    template <class U>
+    struct rebind { typedef mremap_allocator<U, Threshold> other; };
+
+    mremap_allocator() { }
+    mremap_allocator(const mremap_allocator& other)
+        : std::allocator<T>(other) { }
+    template <class U>
+    mremap_allocator(const mremap_allocator<U, Threshold>&) { }
+
+    pointer allocate(size_type n, const void* = 0)
+    {
+        if (n > this->max_size())
+            throw std::bad_alloc();
+        size_type bytes = n * sizeof(T);
+#ifdef __linux__
+        if (bytes >= Threshold) {
+            void* p = ::mmap(NULL, map_size_(bytes), PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED)
+                throw std::bad_alloc();
+            return static_cast<pointer>(p);
+        }
+#endif
+        return static_cast<pointer>(::operator new(bytes));
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        size_type bytes = n * sizeof(T);
+#ifdef __linux__
+        if (bytes >= Threshold) {
+            ::munmap(p, map_size_(bytes));
+            return;
+        }
+#endif
+        ::operator delete(p);
+    }
+
+    pointer reallocate(pointer p, size_type old_n, size_type new_n)
+    {
+#ifdef __linux__
+        size_type old_bytes = old_n * sizeof(T);
+        size_type new_bytes = new_n * sizeof(T);
+        if (old_bytes >= Threshold && new_bytes >= Threshold) {
+            void* q = ::mremap(p, map_size_(old_bytes), map_size_(new_bytes),
+                               MREMAP_MAYMOVE);
+            return q == MAP_FAILED ? NULL : static_cast<pointer>(q);
+        }
+#else
+        (void)p; (void)old_n; (void)new_n;
+#endif
+        return NULL;
+    }
+
+private:
+    static size_type map_size_(size_type bytes)
+    {
+        const size_type page = 4096;
+        return (bytes + page - 1) / page * page;
+    }
+};
+
+template <class T, std::size_t Threshold>
+const typename mremap_allocator<T, Threshold>::size_type
+mremap_allocator<T, Threshold>::threshold;
+
+template <class T, class U, std::size_t Threshold>
+inline bool operator==(const mremap_allocator<T, Threshold>&,
+                       const mremap_allocator<U, Threshold>&)
+{
+    return true;
+}
+
+template <class T, class U, std::size_t Threshold>
+inline bool operator!=(const mremap_allocator<T, Threshold>&,
+                       const mremap_allocator<U, Threshold>&)
+{
+    return false;
+}
+
+// Serves every block aligned to Align bytes, a power of two no smaller
+// than a pointer: 64 puts elements on cache line boundaries, which aligned
+// SIMD loads and stores rely on.
+template <class T, std::size_t Align = 64>
+class aligned_allocator : public std::allocator<T>
+{
+public:
+    typedef T*          pointer;
+    typedef std::size_t size_type;
+
+    static const size_type alignment = Align;
+
+    template <class U>
+    struct rebind { typedef aligned_allocator<U, Align> other; };
+
+    aligned_allocator() { }
+    aligned_allocator(const aligned_allocator& other)
+        : std::allocator<T>(other) { }
+    template <class U>
+    aligned_allocator(const aligned_allocator<U, Align>&) { }
+
+    pointer allocate(size_type n, const void* = 0)
+    {
+        if (n > this->max_size())
+            throw std::bad_alloc();
+        size_type bytes = n * sizeof(T);
+        void* p = NULL;
+        if (::posix_memalign(&p, Align, bytes ? bytes : 1))
+            throw std::bad_alloc();
+        return static_cast<pointer>(p);
+    }
+
+    void deallocate(pointer p, size_type)
+    {
+        std::free(p);
+    }
+};
+
+template <class T, std::size_t Align>
+const typename aligned_allocator<T, Align>::size_type
+aligned_allocator<T, Align>::alignment;
+
+template <class T, class U, std::size_t Align>
+inline bool operator==(const aligned_allocator<T, Align>&,
+                       const aligned_allocator<U, Align>&)
+{
+    return true;
+}
+
+template <class T, class U, std::size_t Align>
+inline bool operator!=(const aligned_allocator<T, Align>&,
+                       const aligned_allocator<U, Align>&)
+{
+    return false;
+}
+
+static const std::size_t hugepage_size = std::size_t(2) << 20;
+
+// Maps whole hugepages aligned to the hugepage size and asks the kernel to
+// back them with transparent hugepages. madvise is only a hint: with THP
+// disabled the mapping still works with 4 KiB pages.
+inline void* map_hugepages(std::size_t bytes)
+{
+#ifdef FT_HUGEPAGES
+    bytes = (bytes + hugepage_size - 1) / hugepage_size * hugepage_size;
+    void* p = ::mmap(NULL, bytes + hugepage_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        throw std::bad_alloc();
+
+    // trim the mapping to an aligned range
+    char*       raw = static_cast<char*>(p);
+    std::size_t head = (hugepage_size
+        - reinterpret_cast<std::size_t>(raw) % hugepage_size) % hugepage_size;
+    if (head)
+        ::munmap(raw, head);
+    if (hugepage_size - head)
+        ::munmap(raw + head + bytes, hugepage_size - head);
+    ::madvise(raw + head, bytes, MADV_HUGEPAGE);
+    return raw + head;
+#else
+    return ::operator new(bytes);
+#endif
+}
+
+inline void unmap_hugepages(void* p, std::size_t bytes)
+{
+#ifdef FT_HUGEPAGES
+    ::munmap(p, (bytes + hugepage_size - 1) / hugepage_size * hugepage_size);
+#else
+    (void)bytes;
+    ::operator delete(p);
+#endif
+}
+
+// Serves blocks of at least Threshold bytes from hugepage-aligned mappings
+// advised with MADV_HUGEPAGE, so that a large buffer needs one TLB entry
+// per 2 MiB instead of one per 4 KiB. Smaller blocks come from operator new.
+// Without MADV_HUGEPAGE every block comes from operator new.
+template <class T, std::size_t Threshold = hugepage_size>
+class hugepage_allocator : public std::allocator<T>
+{
+public:
+    typedef T*          pointer;
+    typedef std::size_t size_type;
+
+    static const size_type threshold = Threshold;
+
+    template <class U>
+    struct rebind { typedef hugepage_allocator<U, Threshold> other; };
+
+    hugepage_allocator() { }
+    hugepage_allocator(const hugepage_allocator& other)
+        : std::allocator<T>(other) { }
+    template <class U>
+    hugepage_allocator(const hugepage_allocator<U, Threshold>&) { }
+
+    pointer allocate(size_type n, const void* = 0)
+    {
+        if (n > this->max_size())
+            throw std::bad_alloc();
+        size_type bytes = n * sizeof(T);
+        if (bytes >= Threshold)
+            return static_cast<pointer>(map_hugepages(bytes));
+        return static_cast<pointer>(::operator new(bytes));
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        size_type bytes = n * sizeof(T);
+        if (bytes >= Threshold)
+            unmap_hugepages(p, bytes);
+        else
+            ::operator delete(p);
+    }
+};
+
+template <class T, std::size_t Threshold>
+const typename hugepage_allocator<T, Threshold>::size_type
+hugepage_allocator<T, Threshold>::threshold;
+
+template <class T, class U, std::size_t Threshold>
+inline bool operator==(const hugepage_allocator<T, Threshold>&,
+                       const hugepage_allocator<U, Threshold>&)
+{
+    return true;
+}
+
+template <class T, class U, std::size_t Threshold>
+inline bool operator!=(const hugepage_allocator<T, Threshold>&,
+                       const hugepage_allocator<U, Threshold>&)
+{
+    return false;
+}
+
+// Bump allocator over hugepage-backed mappings. Blocks are carved from the
+// current chunk and are not given back one by one: release() unmaps every
+// chunk at once, the destructor does too. The containers using the arena
+// must be gone or cleared before that.
+//
+// Only the most recent block can shrink, grow in place or be handed back,
+// which is what a growing vector does.
+class mmap_arena
+{
+public:
+    static const std::size_t alignment = 16;
+
+    explicit mmap_arena(std::size_t chunk_size = hugepage_size)
+        : chunk_size_(chunk_size)
+        , chunks_(NULL)
+        , cursor_(NULL)
+        , end_(NULL)
+        , last_(NULL)
+        , mapped_(0)
+        , used_(0)
+    { }
+
+    ~mmap_arena() { release(); }
+
+    // The arena of default constructed arena_allocators.
+    static mmap_arena& global()
+    {
+        static mmap_arena arena;
+        return arena;
+    }
+
+    void* allocate(std::size_t bytes)
+    {
+        bytes = round_(bytes ? bytes : 1);
+        if (static_cast<std::size_t>(end_ - cursor_) < bytes)
+            add_chunk_(bytes);
+        last_ = cursor_;
+        cursor_ += bytes;
+        used_ += bytes;
+        return last_;
+    }
+
+    void deallocate(void* p, std::size_t bytes)
+    {
+        if (p && p == last_ && last_ + round_(bytes ? bytes : 1) == cursor_) {
+            used_ -= cursor_ - last_;
+            cursor_ = last_;
+            last_ = NULL;
+        }
+    }
+
+    // Resizes the last block in place; NULL if p is not the last block or
+    // the chunk has no room left.
+    void* reallocate(void* p, std::size_t old_bytes, std::size_t new_bytes)
+    {
+        char* q = static_cast<char*>(p);
+        if (!q || q != last_ || q + round_(old_bytes) != cursor_)
+            return NULL;
+        new_bytes = round_(new_bytes ? new_bytes : 1);
+        if (static_cast<std::size_t>(end_ - q) < new_bytes)
+            return NULL;
+        used_ = used_ - (cursor_ - q) + new_bytes;
+        cursor_ = q + new_bytes;
+        return q;
+    }
+
+    // Unmaps every chunk. All blocks served so far become invalid.
+    void release()
+    {
+        while (chunks_) {
+            chunk_* next = chunks_->next;
+            unmap_hugepages(chunks_, chunks_->size);
+            chunks_ = next;
+        }
+        cursor_ = end_ = last_ = NULL;
+        mapped_ = used_ = 0;
+    }
+
+    std::size_t mapped_bytes() const { return mapped_; }
+    std::size_t used_bytes() const   { return used_; }
+
+private:
+    struct chunk_
+    {
+        chunk_*     next;
+        std::size_t size;
+    };
+
+    mmap_arena(const mmap_arena&);
+    mmap_arena& operator=(const mmap_arena&);
+
+    static std::size_t round_(std::size_t bytes)
+    {
+        return (bytes + alignment - 1) / alignment * alignment;
+    }
+
+    void add_chunk_(std::size_t bytes)
+    {
+        std::size_t header = round_(sizeof(chunk_));
+        std::size_t size = chunk_size_;
+        if (size < header + bytes)
+            size = header + bytes;
+        chunk_* c = static_cast<chunk_*>(map_hugepages(size));
+        c->next = chunks_;
+        c->size = size;
+        chunks_ = c;
+        cursor_ = reinterpret_cast<char*>(c) + header;
+        end_ = reinterpret_cast<char*>(c) + size;
+        last_ = NULL;
+        mapped_ += size;
+    }
+
+    std::size_t chunk_size_;
+    chunk_*     chunks_;
+    char*       cursor_;
+    char*       end_;
+    char*       last_;
+    std::size_t mapped_;
+    std::size_t used_;
+};
+
+// Allocator over an mmap_arena. A default constructed allocator uses
+// mmap_arena::global(), which lives until the program ends; pass an arena
+// to free the memory of a group of containers with one release().
+template <class T>
+class arena_allocator : public std::allocator<T>
+{
+public:
+    typedef T*          pointer;
+    typedef std::size_t size_type;
+
+    template <class U>
+    struct rebind { typedef arena_allocator<U> other; };
+
+    arena_allocator() : arena_(&mmap_arena::global()) { }
+    arena_allocator(mmap_arena& arena) : arena_(&arena) { }
+    arena_allocator(const arena_allocator& other)
+        : std::allocator<T>(other), arena_(other.arena_) { }
+    template <class U>
+    arena_allocator(const arena_allocator<U>& other)
+        : arena_(&other.arena()) { }
+
+    mmap_arena& arena() const { return *arena_; }
+
+    pointer allocate(size_type n, const void* = 0)
+    {
+        if (n > this->max_size())
+            throw std::bad_alloc();
+        return static_cast<pointer>(arena_->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        arena_->deallocate(p, n * sizeof(T));
+    }
+
+    pointer reallocate(pointer p, size_type old_n, size_type new_n)
+    {
+        if (new_n > this->max_size())
+            throw std::bad_alloc();
+        return static_cast<pointer>(
+            arena_->reallocate(p, old_n * sizeof(T), new_n * sizeof(T)));
+    }
+
+private:
+    mmap_arena* arena_;
+};
+
+template <class T, class U>
+inline bool operator==(const arena_allocator<T>& lhs,
+                       const arena_allocator<U>& rhs)
+{
+    return &lhs.arena() == &rhs.arena();
+}
+
+template <class T, class U>
+inline bool operator!=(const arena_allocator<T>& lhs,
+                       const arena_allocator<U>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+}; // namespace ft
+
+#endif // ALLOCATOR_H
@@ -0,0 +1,603 @@
+#ifndef CONCURRENT_VECTOR_H
+#define CONCURRENT_VECTOR_H
+
+#include "utility.hpp"
+
+// Append-only vector for concurrent producers. C++11 only: it needs
+// std::atomic.
+#ifdef FT_CXX11
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#include "iterator.hpp"
+#include "segmented_vector.hpp"
+
+namespace ft {
+
+// Random access iterator over the published elements of a
+// concurrent_vector. Like segmented_iterator it keeps the bounds of the
+// current segment.
+template <class Vec, class T>
+class concurrent_iterator : public iterator<random_access_iterator_tag, T>
+{
+public:
+    typedef concurrent_iterator                                                 iterator_type;
+    typedef typename iterator<random_access_iterator_tag, T>::iterator_category iterator_category;
+    typedef typename iterator<random_access_iterator_tag, T>::value_type        value_type;
+    typedef typename iterator<random_access_iterator_tag, T>::difference_type   difference_type;
+    typedef typename iterator<random_access_iterator_tag, T>::pointer           pointer;
+    typedef typename iterator<random_access_iterator_tag, T>::const_pointer     const_pointer;
+    typedef typename iterator<random_access_iterator_tag, T>::reference         reference;
+    typedef typename iterator<random_access_iterator_tag, T>::const_reference   const_reference;
+
+    concurrent_iterator() : vec_(NULL), i_(0), cur_(NULL), first_(NULL), last_(NULL) {}
+    concurrent_iterator(Vec* vec, std::size_t i) : vec_(vec) { set_(i); }
+    template <class V, class U>
+    concurrent_iterator(const concurrent_iterator<V, U>& other,
+                        typename enable_if<is_same<const U, T>::value, bool>::type = 0)
+        : vec_(other.container())
+    { set_(other.index()); }
+
+    Vec*        container() const { return vec_; }
+    std::size_t index() const     { return i_;   }
+    bool        failed() const    { return vec_->failed(i_); }
+
+// Dereference
+    reference operator*() const                   { return *cur_;        }
+    pointer   operator->() const                  { return cur_;         }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+// Increment/decrement
+    concurrent_iterator& operator++()
+    {
+        ++i_;
+        if (++cur_ == last_) {
+            set_(i_);
+        }
+        return *this;
+    }
+    concurrent_iterator& operator--()
+    {
+        if (cur_ == first_) {
+            set_(i_ - 1);
+        }
+        else {
+            --cur_;
+            --i_;
+        }
+        return *this;
+    }
+    concurrent_iterator  operator++(int) { concurrent_iterator tmp(*this); ++*this; return tmp; }
+    concurrent_iterator  operator--(int) { concurrent_iterator tmp(*this); --*this; return tmp; }
+
+// Arithmetic
+    concurrent_iterator& operator+=(difference_type n) { set_(i_ + n); return *this; }
+    concurrent_iterator& operator-=(difference_type n) { set_(i_ - n); return *this; }
+    concurrent_iterator  operator+(difference_type n) const { return concurrent_iterator(vec_, i_ + n); }
+    concurrent_iterator  operator-(difference_type n) const { return concurrent_iterator(vec_, i_ - n); }
+
+    friend concurrent_iterator operator+(difference_type n, const concurrent_iterator& it)
+    { return it + n; }
+
+private:
+    typedef typename remove_const<Vec>::type::layout_type layout_;
+
+    void set_(std::size_t i)
+    {
+        std::size_t k = layout_::segment(i);
+        i_ = i;
+        first_ = k < layout_::max_segments ? vec_->segment_data_(k) : NULL;
+        if (!first_) {
+            cur_ = last_ = NULL;
+            return;
+        }
+        last_ = first_ + layout_::length(k);
+        cur_ = first_ + layout_::offset(i, k);
+    }
+
+    Vec*        vec_;
+    std::size_t i_;
+    pointer     cur_;
+    pointer     first_;
+    pointer     last_;
+};
+
+template <class V1, class T1, class V2, class T2>
+inline std::ptrdiff_t operator-(const concurrent_iterator<V1, T1>& a, const concurrent_iterator<V2, T2>& b)
+{ return static_cast<std::ptrdiff_t>(a.index() - b.index()); }
+
+template <class V1, class T1, class V2, class T2>
+inline bool operator==(const concurrent_iterator<V1, T1>& a, const concurrent_iterator<V2, T2>& b)
+{ return a.index() == b.index(); }
+template <class V1, class T1, class V2, class T2>
+inline bool operator!=(const concurrent_iterator<V1, T1>& a, const concurrent_iterator<V2, T2>& b)
+{ return a.index() != b.index(); }
+template <class V1, class T1, class V2, class T2>
+inline bool operator< (const concurrent_iterator<V1, T1>& a, const concurrent_iterator<V2, T2>& b)
+{ return a.index() <  b.index(); }
+template <class V1, class T1, class V2, class T2>
+inline bool operator> (const concurrent_iterator<V1, T1>& a, const concurrent_iterator<V2, T2>& b)
+{ return a.index() >  b.index(); }
+template <class V1, class T1, class V2, class T2>
+inline bool operator<=(const concurrent_iterator<V1, T1>& a, const concurrent_iterator<V2, T2>& b)
+{ return a.index() <= b.index(); }
+template <class V1, class T1, class V2, class T2>
+inline bool operator>=(const concurrent_iterator<V1, T1>& a, const concurrent_iterator<V2, T2>& b)
+{ return a.index() >= b.index(); }
+
+// A vector any number of threads can append to at once, without a lock.
+// An append reserves its indices with one fetch_add and constructs the
+// elements in segments laid out as in segmented_vector, which are
+// allocated on first use and never move. Each constructed element sets
+// its bit in a per segment bitmap; size() is the longest prefix whose
+// bits are all set, so [0, size()) can be read while others append.
+//
+// Appends, reads, size(), reserve() and the iterators are safe to use
+// concurrently. Copying, assigning, clear() and destruction are not.
+// An append allocates the segments it needs before it takes its indices,
+// so running out of memory costs no index. An element whose construction
+// throws is marked failed instead: size() steps over it, failed() and
+// iterator::failed() report it and at() throws for it.
+template <class T, class Allocator = std::allocator<T>, std::size_t N = 64>
+class concurrent_vector
+{
+public:
+
+// Member types
+    typedef T                                        value_type;
+    typedef Allocator                                allocator_type;
+    typedef typename allocator_type::reference       reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::pointer         pointer;
+    typedef typename allocator_type::const_pointer   const_pointer;
+    typedef ft::concurrent_iterator<concurrent_vector, value_type>             iterator;
+    typedef ft::concurrent_iterator<const concurrent_vector, const value_type> const_iterator;
+    typedef ft::reverse_iterator<iterator>           reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator>     const_reverse_iterator;
+    typedef typename allocator_type::difference_type difference_type;
+    typedef std::size_t                              size_type;
+    typedef segment_layout<N>                        layout_type;
+
+// Constructors
+    explicit concurrent_vector(const allocator_type& alloc = allocator_type());
+             concurrent_vector(const concurrent_vector& x);
+
+    ~concurrent_vector();
+
+    concurrent_vector& operator=(const concurrent_vector& x);
+
+// Iterators
+    iterator               begin()        { return iterator(this, 0);                  }
+    const_iterator         begin() const  { return const_iterator(this, 0);            }
+    iterator               end()          { return iterator(this, size());             }
+    const_iterator         end() const    { return const_iterator(this, size());       }
+    reverse_iterator       rbegin()       { return reverse_iterator(end());            }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end());      }
+    reverse_iterator       rend()         { return reverse_iterator(begin());          }
+    const_reverse_iterator rend() const   { return const_reverse_iterator(begin());    }
+
+// Capacity
+    size_type size() const     { return published_.load(std::memory_order_acquire); }
+    size_type max_size() const { return alloc_.max_size(); }
+    bool      empty() const    { return !size(); }
+    size_type capacity() const;
+    void      reserve(size_type n);
+
+// Element access
+    reference       operator[](size_type n)       { return *slot_(n); }
+    const_reference operator[](size_type n) const { return *slot_(n); }
+    reference       at(size_type n);
+    const_reference at(size_type n) const;
+    bool            failed(size_type n) const;
+    reference       front()       { return (*this)[0];          }
+    const_reference front() const { return (*this)[0];          }
+    reference       back()        { return (*this)[size() - 1]; }
+    const_reference back() const  { return (*this)[size() - 1]; }
+
+// Modifiers, each returns the index of its first element
+    size_type push_back(const value_type& val)  { return emplace_back(val);            }
+    size_type push_back(value_type&& val)       { return emplace_back(std::move(val)); }
+    template <class... Args>
+    size_type emplace_back(Args&&... args);
+    size_type grow_by(size_type n, const value_type& val = value_type());
+    void      clear();
+
+// Allocator
+    allocator_type get_allocator() const { return alloc_; }
+
+private:
+    template <class V, class U> friend class ft::concurrent_iterator;
+
+    typedef segment_layout<N>                  layout_;
+    // segment_layout indexes with a bit scan, which needs N a power of two
+    typedef char n_must_be_power_of_two_[(N && !(N & (N - 1))) ? 1 : -1];
+    typedef simd::word                         word_type;
+    typedef std::atomic<word_type>             ready_word_;
+    typedef typename allocator_type::template rebind<ready_word_>::other ready_allocator_;
+
+    // a segment's bitmap holds a ready bit per element, then a failed bit
+    // per element; a failed element is also ready, size() passes it
+    static size_type ready_words_(size_type k) { return (layout_::length(k) + 63) / 64; }
+
+    allocator_type             alloc_;
+    // the two counters are written by every append, each gets its own line
+    std::atomic<size_type>     reserved_;
+    char                       pad0_[64 - sizeof(std::atomic<size_type>)];
+    std::atomic<size_type>     published_;
+    char                       pad1_[64 - sizeof(std::atomic<size_type>)];
+    std::atomic<pointer>       values_[layout_::max_segments];
+    std::atomic<ready_word_*>  ready_[layout_::max_segments];
+
+    pointer      segment_data_(size_type k) const { return values_[k].load(std::memory_order_acquire); }
+    pointer      slot_(size_type i) const;
+    size_type    claim_indices_(size_type n);
+    pointer      claim_values_(size_type k);
+    ready_word_* claim_ready_(size_type k);
+    bool         ready_run_(size_type i, size_type& run) const;
+    bool         failed_bit_(size_type i) const;
+    void         set_bits_(size_type first, size_type n, bool failed);
+    void         publish_(size_type first, size_type n);
+    void         fail_(size_type first, size_type n);
+    void         destroy_();
+};
+
+/***** Constructors *****/
+
+template <class T, class Allocator, std::size_t N>
+concurrent_vector<T, Allocator, N>::concurrent_vector(const allocator_type& alloc)
+    : alloc_(alloc)
+    , reserved_(0)
+    , published_(0)
+{
+    for (size_type k = 0; k < layout_::max_segments; ++k) {
+        values_[k].store(NULL, std::memory_order_relaxed);
+        ready_[k].store(NULL, std::memory_order_relaxed);
+    }
+}
+
+template <class T, class Allocator, std::size_t N>
+concurrent_vector<T, Allocator, N>::concurrent_vector(const concurrent_vector& x)
+    : alloc_(x.alloc_)
+    , reserved_(0)
+    , published_(0)
+{
+    for (size_type k = 0; k < layout_::max_segments; ++k) {
+        values_[k].store(NULL, std::memory_order_relaxed);
+        ready_[k].store(NULL, std::memory_order_relaxed);
+    }
+    try {
+        *this = x;
+    }
+    catch (...) {
+        destroy_();
+        throw;
+    }
+}
+
+template <class T, class Allocator, std::size_t N>
+concurrent_vector<T, Allocator, N>::~concurrent_vector()
+{
+    destroy_();
+}
+
+// Copies the elements x had published when the copy started.
+template <class T, class Allocator, std::size_t N>
+concurrent_vector<T, Allocator, N>&
+concurrent_vector<T, Allocator, N>::operator=(const concurrent_vector& x)
+{
+    if (this == &x) {
+        return *this;
+    }
+    clear();
+    size_type n = x.size();
+    reserve(n);
+    for (const_iterator it = x.begin(); n--; ++it) {
+        if (it.failed()) {
+            fail_(claim_indices_(1), 1);
+        } else {
+            push_back(*it);
+        }
+    }
+    return *this;
+}
+
+/***** Capacity *****/
+
+template <class T, class Allocator, std::size_t N>
+typename concurrent_vector<T, Allocator, N>::size_type
+concurrent_vector<T, Allocator, N>::capacity() const
+{
+    size_type k = 0;
+    while (k < layout_::max_segments && segment_data_(k)) {
+        ++k;
+    }
+    return layout_::capacity(k);
+}
+
+// Allocates the segments up front, so the appends that fill them do not.
+template <class T, class Allocator, std::size_t N>
+void concurrent_vector<T, Allocator, N>::reserve(size_type n)
+{
+    for (size_type k = 0; layout_::capacity(k) < n; ++k) {
+        if (k == layout_::max_segments) {
+            throw std::length_error("concurrent_vector");
+        }
+        claim_values_(k);
+        claim_ready_(k);
+    }
+}
+
+/***** Element access *****/
+
+template <class T, class Allocator, std::size_t N>
+typename concurrent_vector<T, Allocator, N>::reference
+concurrent_vector<T, Allocator, N>::at(size_type n)
+{
+    if (n >= size()) {
+        throw std::out_of_range("concurrent_vector");
+    }
+    if (failed_bit_(n)) {
+        throw std::runtime_error("concurrent_vector: element failed to construct");
+    }
+    return (*this)[n];
+}
+
+template <class T, class Allocator, std::size_t N>
+typename concurrent_vector<T, Allocator, N>::const_reference
+concurrent_vector<T, Allocator, N>::at(size_type n) const
+{
+    if (n >= size()) {
+        throw std::out_of_range("concurrent_vector");
+    }
+    if (failed_bit_(n)) {
+        throw std::runtime_error("concurrent_vector: element failed to construct");
+    }
+    return (*this)[n];
+}
+
+// Whether the construction of element n, which must be below size(), threw.
+template <class T, class Allocator, std::size_t N>
+inline bool concurrent_vector<T, Allocator, N>::failed(size_type n) const
+{
+    return failed_bit_(n);
+}
+
+/***** Modifiers *****/
+
+template <class T, class Allocator, std::size_t N>
+    template <class... Args>
+typename concurrent_vector<T, Allocator, N>::size_type
+concurrent_vector<T, Allocator, N>::emplace_back(Args&&... args)
+{
+    size_type i = claim_indices_(1);
+    try {
+        alloc_.construct(slot_(i), std::forward<Args>(args)...);
+    }
+    catch (...) {
+        fail_(i, 1);
+        throw;
+    }
+    publish_(i, 1);
+    return i;
+}
+
+// Takes n indices at once, they may span segments. When a copy throws,
+// that element and the ones after it are marked failed.
+template <class T, class Allocator, std::size_t N>
+typename concurrent_vector<T, Allocator, N>::size_type
+concurrent_vector<T, Allocator, N>::grow_by(size_type n, const value_type& val)
+{
+    size_type first = claim_indices_(n);
+    size_type done = 0;
+    try {
+        for (; done < n; ++done) {
+            alloc_.construct(slot_(first + done), val);
+        }
+    }
+    catch (...) {
+        fail_(first + done, n - done);
+        publish_(first, done);
+        throw;
+    }
+    publish_(first, n);
+    return first;
+}
+
+// Keeps the segments.
+template <class T, class Allocator, std::size_t N>
+void concurrent_vector<T, Allocator, N>::clear()
+{
+    size_type reserved = reserved_.load(std::memory_order_relaxed);
+    for (size_type i = 0; i < reserved; ++i) {
+        size_type run;
+        if (ready_run_(i, run) && !failed_bit_(i)) {
+            alloc_.destroy(slot_(i));
+        }
+    }
+    for (size_type k = 0; k < layout_::max_segments; ++k) {
+        ready_word_* ready = ready_[k].load(std::memory_order_relaxed);
+        for (size_type w = 0; ready && w < 2 * ready_words_(k); ++w) {
+            ready[w].store(0, std::memory_order_relaxed);
+        }
+    }
+    reserved_.store(0, std::memory_order_relaxed);
+    published_.store(0, std::memory_order_relaxed);
+}
+
+/***** private *****/
+
+template <class T, class Allocator, std::size_t N>
+inline typename concurrent_vector<T, Allocator, N>::pointer
+concurrent_vector<T, Allocator, N>::slot_(size_type i) const
+{
+    size_type k = layout_::segment(i);
+    return segment_data_(k) + layout_::offset(i, k);
+}
+
+// Takes the next n indices. The segments behind them are allocated before
+// the indices are taken, so when that throws no index is lost. A thread
+// that loses the race retries with the next free indices, the segments it
+// allocated stay as capacity.
+template <class T, class Allocator, std::size_t N>
+typename concurrent_vector<T, Allocator, N>::size_type
+concurrent_vector<T, Allocator, N>::claim_indices_(size_type n)
+{
+    // the segments hold every index below -N
+    const size_type limit = size_type(0) - N;
+
+    size_type first = reserved_.load(std::memory_order_relaxed);
+    do {
+        if (n > limit - first) {
+            throw std::length_error("concurrent_vector");
+        }
+        if (n) {
+            size_type last = layout_::segment(first + n - 1);
+            for (size_type k = layout_::segment(first); k <= last; ++k) {
+                claim_values_(k);
+                claim_ready_(k);
+            }
+        }
+    } while (!reserved_.compare_exchange_weak(first, first + n, std::memory_order_relaxed));
+    return first;
+}
+
+// Racing threads each allocate the segment, the first to publish it wins
+// and the others free theirs.
+template <class T, class Allocator, std::size_t N>
+typename concurrent_vector<T, Allocator, N>::pointer
+concurrent_vector<T, Allocator, N>::claim_values_(size_type k)
+{
+    pointer current = segment_data_(k);
+    if (current) {
+        return current;
+    }
+    pointer fresh = alloc_.allocate(layout_::length(k));
+    if (values_[k].compare_exchange_strong(current, fresh, std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+        return fresh;
+    }
+    alloc_.deallocate(fresh, layout_::length(k));
+    return current;
+}
+
+template <class T, class Allocator, std::size_t N>
+typename concurrent_vector<T, Allocator, N>::ready_word_*
+concurrent_vector<T, Allocator, N>::claim_ready_(size_type k)
+{
+    ready_word_* current = ready_[k].load(std::memory_order_acquire);
+    if (current) {
+        return current;
+    }
+    ready_allocator_ ready_alloc(alloc_);
+    ready_word_*     fresh = ready_alloc.allocate(2 * ready_words_(k));
+    for (size_type w = 0; w < 2 * ready_words_(k); ++w) {
+        ::new (static_cast<void*>(fresh + w)) ready_word_(0);
+    }
+    if (ready_[k].compare_exchange_strong(current, fresh, std::memory_order_acq_rel,
+                                          std::memory_order_acquire)) {
+        return fresh;
+    }
+    ready_alloc.deallocate(fresh, 2 * ready_words_(k));
+    return current;
+}
+
+// Whether element i is constructed, and how many constructed elements
+// follow it in its bitmap word, i included.
+template <class T, class Allocator, std::size_t N>
+inline bool concurrent_vector<T, Allocator, N>::ready_run_(size_type i, size_type& run) const
+{
+    size_type    k = layout_::segment(i);
+    size_type    off = layout_::offset(i, k);
+    ready_word_* ready = k < layout_::max_segments ? ready_[k].load(std::memory_order_acquire) : NULL;
+    if (!ready) {
+        return false;
+    }
+    word_type bits = ~(ready[off / 64].load() >> off % 64);
+    run = bits ? simd::ctz_word(bits) : 64 - off % 64;
+    return run != 0;
+}
+
+template <class T, class Allocator, std::size_t N>
+inline bool concurrent_vector<T, Allocator, N>::failed_bit_(size_type i) const
+{
+    size_type    k = layout_::segment(i);
+    size_type    off = layout_::offset(i, k);
+    ready_word_* ready = ready_[k].load(std::memory_order_acquire);
+    return (ready[ready_words_(k) + off / 64].load() >> off % 64) & 1;
+}
+
+// Sets the ready or the failed bits of [first, first + n).
+template <class T, class Allocator, std::size_t N>
+void concurrent_vector<T, Allocator, N>::set_bits_(size_type first, size_type n, bool failed)
+{
+    for (size_type i = first; i < first + n; ) {
+        size_type k = layout_::segment(i);
+        size_type off = layout_::offset(i, k);
+        size_type bits = first + n - i;
+        if (bits > layout_::length(k) - off) {
+            bits = layout_::length(k) - off;
+        }
+        if (bits > 64 - off % 64) {
+            bits = 64 - off % 64;
+        }
+        word_type mask = bits == 64 ? ~word_type(0) : ((word_type(1) << bits) - 1) << off % 64;
+        claim_ready_(k)[(failed ? ready_words_(k) : 0) + off / 64].fetch_or(mask);
+        i += bits;
+    }
+}
+
+// Marks [first, first + n) constructed, then moves size() past every
+// element that is. Each thread sets its bits before it scans, so of two
+// appends finishing together at least one sees both and moves size()
+// past them.
+template <class T, class Allocator, std::size_t N>
+void concurrent_vector<T, Allocator, N>::publish_(size_type first, size_type n)
+{
+    set_bits_(first, n, false);
+
+    size_type published = published_.load();
+    size_type run;
+    while (ready_run_(published, run)) {
+        if (published_.compare_exchange_weak(published, published + run)) {
+            published += run;
+        }
+    }
+}
+
+// Marks [first, first + n) failed before publishing them, so a reader
+// that sees them below size() also sees them failed.
+template <class T, class Allocator, std::size_t N>
+void concurrent_vector<T, Allocator, N>::fail_(size_type first, size_type n)
+{
+    set_bits_(first, n, true);
+    publish_(first, n);
+}
+
+template <class T, class Allocator, std::size_t N>
+void concurrent_vector<T, Allocator, N>::destroy_()
+{
+    clear();
+    ready_allocator_ ready_alloc(alloc_);
+    for (size_type k = 0; k < layout_::max_segments; ++k) {
+        pointer      values = values_[k].load(std::memory_order_relaxed);
+        ready_word_* ready = ready_[k].load(std::memory_order_relaxed);
+        if (values) {
+            alloc_.deallocate(values, layout_::length(k));
+        }
+        if (ready) {
+            ready_alloc.deallocate(ready, 2 * ready_words_(k));
+        }
+        values_[k].store(NULL, std::memory_order_relaxed);
+        ready_[k].store(NULL, std::memory_order_relaxed);
+    }
+}
+
+}; // namespace ft
+
+#endif // FT_CXX11
+
+#endif // CONCURRENT_VECTOR_H
@@ -0,0 +1,784 @@
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+#include "iterator.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+// Blocks hold a power of two number of elements, about 4 KiB worth and at
+// least 16, so that an element is found with a shift and a mask.
+
+template <class T>
+struct deque_block
+{
+    static const std::size_t shift = log2_<(4096 / sizeof(T) > 16 ? 4096 / sizeof(T) : 16)>::value;
+    static const std::size_t size = std::size_t(1) << shift;
+    static const std::size_t mask = size - 1;
+};
+
+// Position p of a deque lives in block p >> shift of the block map, at
+// p & mask. Iterators keep the map they were made from: a push that
+// reallocates the map invalidates them, the elements never move.
+template <class T>
+class deque_iterator : public iterator<random_access_iterator_tag, T>
+{
+public:
+    typedef deque_iterator                                                      iterator_type;
+    typedef typename iterator<random_access_iterator_tag, T>::iterator_category iterator_category;
+    typedef typename iterator<random_access_iterator_tag, T>::value_type        value_type;
+    typedef typename iterator<random_access_iterator_tag, T>::difference_type   difference_type;
+    typedef typename iterator<random_access_iterator_tag, T>::pointer           pointer;
+    typedef typename iterator<random_access_iterator_tag, T>::const_pointer     const_pointer;
+    typedef typename iterator<random_access_iterator_tag, T>::reference         reference;
+    typedef typename iterator<random_access_iterator_tag, T>::const_reference   const_reference;
+    typedef T* const*                                                           map_pointer;
+
+    deque_iterator() : map_(NULL), pos_(0) {}
+    deque_iterator(map_pointer map, std::size_t pos) : map_(map), pos_(pos) {}
+    template <class U>
+    deque_iterator(const deque_iterator<U>& other,
+                   typename enable_if<is_same<const U, T>::value, bool>::type = 0)
+        : map_(other.map()), pos_(other.position()) {}
+
+    map_pointer map() const      { return map_; }
+    std::size_t position() const { return pos_; }
+
+// Dereference
+    reference operator*() const                   { return at_(pos_);      }
+    pointer   operator->() const                  { return &at_(pos_);     }
+    reference operator[](difference_type n) const { return at_(pos_ + n);  }
+
+// Increment/decrement
+    deque_iterator& operator++()    {                           ++pos_; return *this; }
+    deque_iterator& operator--()    {                           --pos_; return *this; }
+    deque_iterator  operator++(int) { deque_iterator tmp(*this); ++pos_; return tmp;   }
+    deque_iterator  operator--(int) { deque_iterator tmp(*this); --pos_; return tmp;   }
+
+// Arithmetic
+    deque_iterator& operator+=(difference_type n)      { pos_ += n; return *this; }
+    deque_iterator& operator-=(difference_type n)      { pos_ -= n; return *this; }
+    deque_iterator  operator+(difference_type n) const { return deque_iterator(map_, pos_ + n); }
+    deque_iterator  operator-(difference_type n) const { return deque_iterator(map_, pos_ - n); }
+
+    friend deque_iterator operator+(difference_type n, const deque_iterator& it)
+    { return it + n; }
+
+private:
+    typedef deque_block<typename remove_const<T>::type> block_;
+
+    reference at_(std::size_t pos) const
+    { return map_[pos >> block_::shift][pos & block_::mask]; }
+
+    map_pointer map_;
+    std::size_t pos_;
+};
+
+template <class T, class U>
+inline typename deque_iterator<T>::difference_type
+operator-(const deque_iterator<T>& a, const deque_iterator<U>& b)
+{ return static_cast<std::ptrdiff_t>(a.position() - b.position()); }
+
+template <class T, class U>
+inline bool operator==(const deque_iterator<T>& a, const deque_iterator<U>& b)
+{ return a.position() == b.position(); }
+template <class T, class U>
+inline bool operator!=(const deque_iterator<T>& a, const deque_iterator<U>& b)
+{ return a.position() != b.position(); }
+template <class T, class U>
+inline bool operator< (const deque_iterator<T>& a, const deque_iterator<U>& b)
+{ return a.position() <  b.position(); }
+template <class T, class U>
+inline bool operator> (const deque_iterator<T>& a, const deque_iterator<U>& b)
+{ return a.position() >  b.position(); }
+template <class T, class U>
+inline bool operator<=(const deque_iterator<T>& a, const deque_iterator<U>& b)
+{ return a.position() <= b.position(); }
+template <class T, class U>
+inline bool operator>=(const deque_iterator<T>& a, const deque_iterator<U>& b)
+{ return a.position() >= b.position(); }
+
+// Double ended queue over fixed size blocks and a central map of block
+// pointers. Pushing and popping at either end never moves an element, so
+// references stay valid. Blocks emptied by pops stay in the map for the
+// next pushes until shrink_to_fit.
+template <class T, class Allocator = std::allocator<T> >
+class deque
+{
+public:
+
+// Member types
+    typedef T                                        value_type;
+    typedef Allocator                                allocator_type;
+    typedef typename allocator_type::reference       reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::pointer         pointer;
+    typedef typename allocator_type::const_pointer   const_pointer;
+    typedef ft::deque_iterator<value_type>           iterator;
+    typedef ft::deque_iterator<const value_type>     const_iterator;
+    typedef ft::reverse_iterator<iterator>           reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator>     const_reverse_iterator;
+    typedef typename allocator_type::difference_type difference_type;
+    typedef std::size_t                              size_type;
+
+    static const size_type block_size = deque_block<T>::size;
+
+// Constructors
+    explicit deque(const allocator_type& alloc = allocator_type());
+    explicit deque(size_type n, const value_type& val = value_type(),
+                   const allocator_type& alloc = allocator_type());
+    template <class InputIterator>
+             deque(InputIterator first, InputIterator last,
+                   const allocator_type& alloc = allocator_type(),
+                   typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type = 0);
+             deque(const deque& x);
+#ifdef FT_CXX11
+             deque(deque&& x);
+#endif
+
+    ~deque();
+
+    deque& operator=(const deque& x);
+#ifdef FT_CXX11
+    deque& operator=(deque&& x);
+#endif
+
+// Iterators
+    iterator               begin()        { return iterator(map_, begin_);                }
+    const_iterator         begin() const  { return const_iterator(map_, begin_);          }
+    iterator               end()          { return iterator(map_, begin_ + size_);        }
+    const_iterator         end() const    { return const_iterator(map_, begin_ + size_);  }
+    reverse_iterator       rbegin()       { return reverse_iterator(end());               }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end());         }
+    reverse_iterator       rend()         { return reverse_iterator(begin());             }
+    const_reverse_iterator rend() const   { return const_reverse_iterator(begin());       }
+
+// Capacity
+    size_type size() const      { return size_; }
+    size_type max_size() const  { return alloc_.max_size(); }
+    void      resize(size_type n, value_type val = value_type());
+    bool      empty() const     { return !size_; }
+    void      shrink_to_fit();
+
+// Element access
+    reference       operator[](size_type n)       { return at_(begin_ + n); }
+    const_reference operator[](size_type n) const { return at_(begin_ + n); }
+    reference       at(size_type n);
+    const_reference at(size_type n) const;
+    reference       front()       { return at_(begin_); }
+    const_reference front() const { return at_(begin_); }
+    reference       back()        { return at_(begin_ + size_ - 1); }
+    const_reference back() const  { return at_(begin_ + size_ - 1); }
+
+// Modifiers
+    template <class InputIterator>
+    void     assign(InputIterator first, InputIterator last,
+                    typename ft::enable_if<
+                    !ft::is_integral<InputIterator>::value, bool>::type = 0);
+    void     assign(size_type n, const value_type& val);
+    void     push_back(const value_type& val);
+    void     push_front(const value_type& val);
+    void     pop_back();
+    void     pop_front();
+    iterator insert(iterator position, const value_type& val);
+    void     insert(iterator position, size_type n, const value_type& val);
+    template <class InputIterator>
+    void     insert(iterator position, InputIterator first, InputIterator last,
+                    typename ft::enable_if<
+                    !ft::is_integral<InputIterator>::value, bool>::type = 0);
+#ifdef FT_CXX11
+    void     push_back(value_type&& val)  { emplace_back(std::move(val));  }
+    void     push_front(value_type&& val) { emplace_front(std::move(val)); }
+    template <class... Args>
+    void     emplace_back(Args&&... args);
+    template <class... Args>
+    void     emplace_front(Args&&... args);
+#endif
+    iterator erase (iterator position);
+    iterator erase (iterator first, iterator last);
+    void     swap  (deque& x);
+    void     clear();
+
+// Allocator
+    allocator_type get_allocator() const { return alloc_; }
+
+private:
+    typedef deque_block<T>                                      block_;
+    typedef typename allocator_type::template rebind<pointer>::other map_allocator_;
+
+    allocator_type alloc_;
+    pointer*       map_;
+    size_type      map_size_;
+    size_type      begin_;
+    size_type      size_;
+
+    reference at_(size_type pos) const
+    { return map_[pos >> block_::shift][pos & block_::mask]; }
+
+    // address of position pos, the block and map allocation kept out of line
+    pointer slot_(size_type pos)
+    {
+        if ((pos >> block_::shift) < map_size_) {
+            pointer block = map_[pos >> block_::shift];
+            if (block) {
+                return block + (pos & block_::mask);
+            }
+        }
+        return new_slot_(pos);
+    }
+
+    pointer new_slot_(size_type pos);
+    void    insert_range_(size_type i, const_pointer src, size_type n);
+    void    remap_(size_type front, size_type back);
+    void    rollback_back_(size_type n);
+    void    rollback_front_(size_type n);
+    void    destroy_();
+};
+
+template <class T, class Allocator>
+const typename deque<T, Allocator>::size_type deque<T, Allocator>::block_size;
+
+/***** Constructors *****/
+
+template <class T, class Allocator>
+deque<T, Allocator>::deque(const allocator_type& alloc)
+    : alloc_(alloc)
+    , map_(NULL)
+    , map_size_(0)
+    , begin_(0)
+    , size_(0)
+{
+}
+
+template <class T, class Allocator>
+deque<T, Allocator>::deque(size_type n, const value_type& val,
+                           const allocator_type& alloc)
+    : alloc_(alloc)
+    , map_(NULL)
+    , map_size_(0)
+    , begin_(0)
+    , size_(0)
+{
+    try {
+        insert(end(), n, val);
+    }
+    catch (...) {
+        destroy_();
+        throw;
+    }
+}
+
+template <class T, class Allocator>
+    template <class InputIterator>
+deque<T, Allocator>::deque(InputIterator first, InputIterator last,
+const allocator_type& alloc,
+typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type)
+    : alloc_(alloc)
+    , map_(NULL)
+    , map_size_(0)
+    , begin_(0)
+    , size_(0)
+{
+    try {
+        insert(end(), first, last);
+    }
+    catch (...) {
+        destroy_();
+        throw;
+    }
+}
+
+template <class T, class Allocator>
+deque<T, Allocator>::deque(const deque& x)
+    : alloc_(x.alloc_)
+    , map_(NULL)
+    , map_size_(0)
+    , begin_(0)
+    , size_(0)
+{
+    try {
+        insert(end(), x.begin(), x.end());
+    }
+    catch (...) {
+        destroy_();
+        throw;
+    }
+}
+
+#ifdef FT_CXX11
+template <class T, class Allocator>
+deque<T, Allocator>::deque(deque&& x)
+    : alloc_(std::move(x.alloc_))
+    , map_(x.map_)
+    , map_size_(x.map_size_)
+    , begin_(x.begin_)
+    , size_(x.size_)
+{
+    x.map_ = NULL;
+    x.map_size_ = 0;
+    x.begin_ = 0;
+    x.size_ = 0;
+}
+#endif
+
+template <class T, class Allocator>
+deque<T, Allocator>::~deque()
+{
+    destroy_();
+}
+
+template <class T, class Allocator>
+deque<T, Allocator>& deque<T, Allocator>::operator=(const deque& x)
+{
+    if (this != &x) {
+        clear();
+        insert(end(), x.begin(), x.end());
+    }
+    return *this;
+}
+
+#ifdef FT_CXX11
+template <class T, class Allocator>
+deque<T, Allocator>& deque<T, Allocator>::operator=(deque&& x)
+{
+    if (this != &x) {
+        destroy_();
+        map_ = NULL;
+        map_size_ = begin_ = size_ = 0;
+        swap(x);
+    }
+    return *this;
+}
+#endif
+
+/***** Capacity *****/
+
+template <class T, class Allocator>
+void deque<T, Allocator>::resize(size_type n, value_type val)
+{
+    while (size_ > n) {
+        pop_back();
+    }
+    if (size_ < n) {
+        insert(end(), n - size_, val);
+    }
+}
+
+// Gives back the blocks that hold no element and the map when it is empty.
+template <class T, class Allocator>
+void deque<T, Allocator>::shrink_to_fit()
+{
+    if (!map_) {
+        return;
+    }
+    const size_type first = begin_ >> block_::shift;
+    const size_type last = size_ ? ((begin_ + size_ - 1) >> block_::shift) + 1 : first;
+    for (size_type i = 0; i < map_size_; ++i) {
+        if (map_[i] && (i < first || i >= last)) {
+            alloc_.deallocate(map_[i], block_::size);
+            map_[i] = NULL;
+        }
+    }
+    if (!size_) {
+        map_allocator_(alloc_).deallocate(map_, map_size_);
+        map_ = NULL;
+        map_size_ = begin_ = 0;
+    }
+}
+
+/***** Element access *****/
+
+template <class T, class Allocator>
+typename deque<T, Allocator>::reference deque<T, Allocator>::at(size_type n)
+{
+    if (n >= size_) {
+        throw std::out_of_range("deque");
+    }
+    return (*this)[n];
+}
+
+template <class T, class Allocator>
+typename deque<T, Allocator>::const_reference deque<T, Allocator>::at(size_type n) const
+{
+    if (n >= size_) {
+        throw std::out_of_range("deque");
+    }
+    return (*this)[n];
+}
+
+/***** Modifiers *****/
+
+template <class T, class Allocator>
+    template <class InputIterator>
+void deque<T, Allocator>::assign(InputIterator first, InputIterator last,
+typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type)
+{
+    clear();
+    insert(end(), first, last);
+}
+
+template <class T, class Allocator>
+void deque<T, Allocator>::assign(size_type n, const value_type& val)
+{
+    value_type copy(val);
+    clear();
+    insert(end(), n, copy);
+}
+
+template <class T, class Allocator>
+void deque<T, Allocator>::push_back(const value_type& val)
+{
+    alloc_.construct(slot_(begin_ + size_), val);
+    ++size_;
+}
+
+template <class T, class Allocator>
+void deque<T, Allocator>::push_front(const value_type& val)
+{
+    if (!begin_) {
+        remap_(1, 0);
+    }
+    alloc_.construct(slot_(begin_ - 1), val);
+    --begin_;
+    ++size_;
+}
+
+#ifdef FT_CXX11
+template <class T, class Allocator>
+    template <class... Args>
+void deque<T, Allocator>::emplace_back(Args&&... args)
+{
+    alloc_.construct(slot_(begin_ + size_), std::forward<Args>(args)...);
+    ++size_;
+}
+
+template <class T, class Allocator>
+    template <class... Args>
+void deque<T, Allocator>::emplace_front(Args&&... args)
+{
+    if (!begin_) {
+        remap_(1, 0);
+    }
+    alloc_.construct(slot_(begin_ - 1), std::forward<Args>(args)...);
+    --begin_;
+    ++size_;
+}
+#endif
+
+template <class T, class Allocator>
+void deque<T, Allocator>::pop_back()
+{
+    --size_;
+    alloc_.destroy(&at_(begin_ + size_));
+}
+
+template <class T, class Allocator>
+void deque<T, Allocator>::pop_front()
+{
+    alloc_.destroy(&at_(begin_));
+    ++begin_;
+    --size_;
+}
+
+template <class T, class Allocator>
+typename deque<T, Allocator>::iterator
+deque<T, Allocator>::insert(iterator position, const value_type& val)
+{
+    size_type i = position - begin();
+    insert(position, 1, val);
+    return begin() + i;
+}
+
+template <class T, class Allocator>
+void deque<T, Allocator>::insert(iterator position, size_type n, const value_type& val)
+{
+    size_type i = position - begin();
+
+    if (i == size_) {
+        size_type old_size = size_;
+        try {
+            while (n--) {
+                push_back(val);
+            }
+        }
+        catch (...) {
+            rollback_back_(size_ - old_size);
+            throw;
+        }
+        return;
+    }
+    ft::vector<value_type> tmp(n, val);
+    if (n) {
+        insert_range_(i, &tmp[0], n);
+    }
+}
+
+// Appends single pass ranges directly; in the middle the range is copied
+// aside first, so that it can be walked from both ends.
+template <class T, class Allocator>
+    template <class InputIterator>
+void deque<T, Allocator>::insert(iterator position, InputIterator first, InputIterator last,
+typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type)
+{
+    size_type i = position - begin();
+
+    if (i == size_) {
+        size_type old_size = size_;
+        try {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+        catch (...) {
+            rollback_back_(size_ - old_size);
+            throw;
+        }
+        return;
+    }
+    ft::vector<value_type> tmp(first, last);
+    if (!tmp.empty()) {
+        insert_range_(i, &tmp[0], tmp.size());
+    }
+}
+
+template <class T, class Allocator>
+typename deque<T, Allocator>::iterator deque<T, Allocator>::erase(iterator position)
+{
+    return erase(position, position + 1);
+}
+
+// Shifts the shorter side over the gap and pops the freed end.
+template <class T, class Allocator>
+typename deque<T, Allocator>::iterator
+deque<T, Allocator>::erase(iterator first, iterator last)
+{
+    size_type i = first - begin();
+    size_type n = last - first;
+
+    if (i < size_ - i - n) {
+        std::copy_backward(begin(), first, last);
+        for (size_type k = 0; k < n; ++k) {
+            pop_front();
+        }
+    }
+    else {
+        std::copy(last, end(), first);
+        for (size_type k = 0; k < n; ++k) {
+            pop_back();
+        }
+    }
+    return begin() + i;
+}
+
+template <class T, class Allocator>
+void deque<T, Allocator>::swap(deque& x)
+{
+    ft::swap(map_, x.map_);
+    ft::swap(map_size_, x.map_size_);
+    ft::swap(begin_, x.begin_);
+    ft::swap(size_, x.size_);
+}
+
+template <class T, class Allocator>
+void deque<T, Allocator>::clear()
+{
+    while (size_) {
+        pop_back();
+    }
+}
+
+/***** Private member functions *****/
+
+// Allocates the block of position pos on first use. Grows the map when pos
+// is past its end.
+template <class T, class Allocator>
+typename deque<T, Allocator>::pointer deque<T, Allocator>::new_slot_(size_type pos)
+{
+    if ((pos >> block_::shift) >= map_size_) {
+        remap_(0, 1);
+        pos = begin_ + size_;
+    }
+    pointer& block = map_[pos >> block_::shift];
+    if (!block) {
+        block = alloc_.allocate(block_::size);
+    }
+    return block + (pos & block_::mask);
+}
+
+// Inserts src[0, n) before position i, growing the end nearer to it: the
+// elements between i and that end are pushed or shifted by n, then src is
+// copied into the gap. Pushes that throw are rolled back.
+template <class T, class Allocator>
+void deque<T, Allocator>::insert_range_(size_type i, const_pointer src, size_type n)
+{
+    const size_type old_size = size_;
+
+    if (i >= size_ / 2) {
+        const size_type tail = size_ - i;
+        try {
+            if (n <= tail) {
+                for (size_type k = old_size - n; k < old_size; ++k) {
+                    push_back((*this)[k]);
+                }
+                std::copy_backward(begin() + i, begin() + (old_size - n),
+                                   begin() + old_size);
+                std::copy(src, src + n, begin() + i);
+            }
+            else {
+                for (size_type k = tail; k < n; ++k) {
+                    push_back(src[k]);
+                }
+                for (size_type k = i; k < old_size; ++k) {
+                    push_back((*this)[k]);
+                }
+                std::copy(src, src + tail, begin() + i);
+            }
+        }
+        catch (...) {
+            rollback_back_(size_ - old_size);
+            throw;
+        }
+        return;
+    }
+
+    // the first n or i cells are pushed in front, each one a copy of
+    // what is then at index n - 1
+    try {
+        if (n <= i) {
+            for (size_type k = 0; k < n; ++k) {
+                push_front((*this)[n - 1]);
+            }
+            std::copy(begin() + 2 * n, begin() + i + n, begin() + n);
+            std::copy(src, src + n, begin() + i);
+        }
+        else {
+            for (size_type k = n - i; k-- > 0; ) {
+                push_front(src[k]);
+            }
+            for (size_type k = 0; k < i; ++k) {
+                push_front((*this)[n - 1]);
+            }
+            std::copy(src + (n - i), src + n, begin() + n);
+        }
+    }
+    catch (...) {
+        rollback_front_(size_ - old_size);
+        throw;
+    }
+}
+
+// Makes room for `front` more blocks before the elements and `back` more
+// after them. The used blocks are recentred in a map that is at least twice
+// their number; blocks that hold no element move along with them.
+template <class T, class Allocator>
+void deque<T, Allocator>::remap_(size_type front, size_type back)
+{
+    const size_type first = begin_ >> block_::shift;
+    const size_type used = size_ ? ((begin_ + size_ - 1) >> block_::shift) - first + 1 : 0;
+    const size_type needed = used + front + back;
+
+    size_type new_size = map_size_;
+    if (needed * 2 > new_size) {
+        new_size = std::max(std::max(map_size_ * 2, needed * 2), size_type(8));
+    }
+    map_allocator_ map_alloc(alloc_);
+    pointer*       map = map_alloc.allocate(new_size);
+    std::memset(static_cast<void*>(map), 0, new_size * sizeof(pointer));
+
+    const size_type new_first = (new_size - needed) / 2 + front;
+    for (size_type k = 0; k < map_size_; ++k) {
+        map[(new_first + k) % new_size] = map_[(first + k) % map_size_];
+    }
+    if (map_) {
+        map_alloc.deallocate(map_, map_size_);
+    }
+    map_ = map;
+    map_size_ = new_size;
+    begin_ = (new_first << block_::shift) + (size_ ? begin_ & block_::mask : 0);
+}
+
+template <class T, class Allocator>
+void deque<T, Allocator>::rollback_back_(size_type n)
+{
+    while (n--) {
+        pop_back();
+    }
+}
+
+template <class T, class Allocator>
+void deque<T, Allocator>::rollback_front_(size_type n)
+{
+    while (n--) {
+        pop_front();
+    }
+}
+
+template <class T, class Allocator>
+void deque<T, Allocator>::destroy_()
+{
+    if (!map_) {
+        return;
+    }
+    clear();
+    for (size_type i = 0; i < map_size_; ++i) {
+        if (map_[i]) {
+            alloc_.deallocate(map_[i], block_::size);
+        }
+    }
+    map_allocator_(alloc_).deallocate(map_, map_size_);
+}
+
+/***** Non-member function overloads *****/
+
+template <class T, class Alloc>
+inline void swap(deque<T, Alloc>& x, deque<T, Alloc>& y)
+{
+    x.swap(y);
+}
+
+template <class T, class Alloc>
+inline bool operator==(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs)
+{
+    return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Alloc>
+inline bool operator!=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class T, class Alloc>
+inline bool operator<(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs)
+{
+    return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, class Alloc>
+inline bool operator<=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <class T, class Alloc>
+inline bool operator>(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs)
+{
+    return rhs < lhs;
+}
+
+template <class T, class Alloc>
+inline bool operator>=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs)
+{
+    return !(lhs < rhs);
+}
+
+}; // namespace ft
+
+#endif // DEQUE_H
@@ -0,0 +1,118 @@
+#ifndef GROWTH_POLICY_H
+#define GROWTH_POLICY_H
+
+#include <cstddef>
+
+namespace ft {
+
+// Growth policies decide the capacity ft::vector reallocates to.
+//
+// A policy is a default constructible class with two members:
+//     size_t grow(size_t capacity, size_t needed, size_t elem_size) const;
+//         returns the new capacity in elements, never less than needed;
+//     void reallocated(size_t bytes_copied);
+//         called after every reallocation with the bytes that were moved.
+
+// Rounds a capacity of n elements up so that it fills whole granules.
+inline std::size_t
+round_capacity(std::size_t n, std::size_t elem_size, std::size_t granule)
+{
+    std::size_t bytes = n * elem_size;
+    bytes = (bytes + granule - 1) / granule * granule;
+    return bytes / elem_size;
+}
+
+// Doubles the capacity, the default.
+struct growth_2x
+{
+    std::size_t grow(std::size_t capacity, std::size_t needed, std::size_t) const
+    {
+        if (capacity && needed < capacity << 1)
+            return capacity << 1;
+        return needed;
+    }
+
+    void reallocated(std::size_t) { }
+};
+
+// Grows by half of the capacity: at most a third of the buffer is unused.
+struct growth_1_5x
+{
+    std::size_t grow(std::size_t capacity, std::size_t needed, std::size_t) const
+    {
+        std::size_t next = capacity + (capacity + 1) / 2;
+        return needed < next ? next : needed;
+    }
+
+    void reallocated(std::size_t) { }
+};
+
+// Grows by 1.5x and rounds the buffer up to whole pages, so no allocation
+// ends in a partially used page.
+struct growth_page
+{
+    static const std::size_t page_size = 4096;
+
+    std::size_t grow(std::size_t capacity, std::size_t needed,
+                     std::size_t elem_size) const
+    {
+        return round_capacity(growth_1_5x().grow(capacity, needed, elem_size),
+                              elem_size, page_size);
+    }
+
+    void reallocated(std::size_t) { }
+};
+
+// Doubles small buffers. Past Threshold bytes it grows by 1.5x and rounds
+// up to whole 2 MiB hugepages.
+template <std::size_t Threshold = (std::size_t(64) << 20)>
+struct growth_hugepage
+{
+    static const std::size_t hugepage_size = std::size_t(2) << 20;
+    static const std::size_t threshold = Threshold;
+
+    std::size_t grow(std::size_t capacity, std::size_t needed,
+                     std::size_t elem_size) const
+    {
+        if (needed * elem_size < Threshold)
+            return growth_2x().grow(capacity, needed, elem_size);
+        return round_capacity(growth_1_5x().grow(capacity, needed, elem_size),
+                              elem_size, hugepage_size);
+    }
+
+    void reallocated(std::size_t) { }
+};
+
+// Wraps a policy and records how often the vector reallocated and how many
+// bytes it moved doing so.
+template <class Policy = growth_2x>
+class growth_stats : public Policy
+{
+public:
+    growth_stats() : reallocations_(0), bytes_copied_(0) { }
+
+    void reallocated(std::size_t bytes_copied)
+    {
+        ++reallocations_;
+        bytes_copied_ += bytes_copied;
+        Policy::reallocated(bytes_copied);
+    }
+
+    std::size_t reallocations() const { return reallocations_; }
+    std::size_t bytes_copied() const  { return bytes_copied_; }
+    void        reset_stats()         { reallocations_ = bytes_copied_ = 0; }
+
+private:
+    std::size_t reallocations_;
+    std::size_t bytes_copied_;
+};
+
+template <std::size_t Threshold>
+const std::size_t growth_hugepage<Threshold>::hugepage_size;
+
+template <std::size_t Threshold>
+const std::size_t growth_hugepage<Threshold>::threshold;
+
+}; // namespace ft
+
+#endif // GROWTH_POLICY_H
@@ -1,7 +1,11 @@
 #ifndef ITERATOR_H
 #define ITERATOR_H
 
-// #include <iterator>
+#include <cstddef>
+#include <iterator>
+
+#include "utility.hpp"
+
 namespace ft {
 
 using std::input_iterator_tag;
@@ -90,6 +94,8 @@ public:
         return *this;
     }
 
+    pointer base() const { return ptr_; }
+
 // Dereference
     reference       operator*()                         { return *ptr_;   }
     const reference operator*() const                   { return *ptr_;   }
@@ -137,6 +143,13 @@ private:
     pointer ptr_;
 };
 
+template <class T>
+struct contiguous_iterator<ra_iter<T> > : public true_type
+{
+    typedef T element_type;
+    static T* address(const ra_iter<T>& it) { return it.base(); }
+};
+
 template <class Iter>
 class reverse_iterator
 {
@@ -321,6 +334,42 @@ const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs)
     return rhs.it_ - lhs.it_;
 }
 
+// iterator_category / distance
+// Work for std iterators too, which have no const_reference for
+// ft::iterator_traits.
+
+template <class Iter>
+inline typename std::iterator_traits<Iter>::iterator_category
+iterator_category(const Iter&)
+{
+    return typename std::iterator_traits<Iter>::iterator_category();
+}
+
+template <class Iter>
+inline typename std::iterator_traits<Iter>::difference_type
+distance(Iter first, Iter last, input_iterator_tag)
+{
+    typename std::iterator_traits<Iter>::difference_type n = 0;
+    for (; first != last; ++first) {
+        ++n;
+    }
+    return n;
+}
+
+template <class Iter>
+inline typename std::iterator_traits<Iter>::difference_type
+distance(Iter first, Iter last, random_access_iterator_tag)
+{
+    return last - first;
+}
+
+template <class Iter>
+inline typename std::iterator_traits<Iter>::difference_type
+distance(Iter first, Iter last)
+{
+    return ft::distance(first, last, ft::iterator_category(first));
+}
+
 }; // namespace ft
 
 #endif // ITERATOR_H
@@ -0,0 +1,150 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "utility.hpp"
+
+// Thread pool behind the parallel vector members. C++11 only: it needs
+// std::thread and std::exception_ptr to hand failures back to the caller.
+#ifdef FT_CXX11
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ft {
+
+class thread_pool
+{
+public:
+    // threads counts the calling thread, which takes part in every run.
+    explicit thread_pool(std::size_t threads = std::thread::hardware_concurrency())
+        : generation_(0)
+        , tasks_(0)
+        , busy_(0)
+        , stop_(false)
+    {
+        for (std::size_t i = 1; i < threads; ++i) {
+            workers_.push_back(std::thread(&thread_pool::work_, this));
+        }
+    }
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::size_t i = 0; i < workers_.size(); ++i) {
+            workers_[i].join();
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    std::size_t size() const { return workers_.size() + 1; }
+
+    // Calls fn(i) for every i in [0, tasks) and returns once all calls are
+    // done. The first exception a call throws is rethrown here, after the
+    // other calls finished.
+    template <class Fn>
+    void run(std::size_t tasks, Fn fn)
+    {
+        std::lock_guard<std::mutex> serial(run_mutex_);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = fn;
+            tasks_ = tasks;
+            next_ = 0;
+            error_ = std::exception_ptr();
+            busy_ = workers_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+        take_tasks_();
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [this] { return busy_ == 0; });
+            job_ = nullptr;
+        }
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+private:
+    void work_()
+    {
+        std::size_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) {
+                    return;
+                }
+                seen = generation_;
+            }
+            take_tasks_();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --busy_;
+            }
+            done_.notify_one();
+        }
+    }
+
+    void take_tasks_()
+    {
+        for (std::size_t i; (i = next_.fetch_add(1)) < tasks_; ) {
+            try {
+                job_(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+        }
+    }
+
+    std::vector<std::thread>          workers_;
+    std::mutex                        run_mutex_;
+    std::mutex                        mutex_;
+    std::condition_variable           wake_;
+    std::condition_variable           done_;
+    std::function<void(std::size_t)>  job_;
+    std::size_t                       generation_;
+    std::size_t                       tasks_;
+    std::atomic<std::size_t>          next_;
+    std::size_t                       busy_;
+    std::exception_ptr                error_;
+    bool                              stop_;
+};
+
+// Opt-in argument of the parallel vector members: operations on fewer than
+// threshold bytes stay on the calling thread.
+struct parallel_policy
+{
+    explicit parallel_policy(thread_pool& p,
+                             std::size_t min_bytes = std::size_t(16) << 20)
+        : pool(&p)
+        , threshold(min_bytes)
+    { }
+
+    thread_pool* pool;
+    std::size_t  threshold;
+};
+
+}; // namespace ft
+
+#endif // FT_CXX11
+
+#endif // PARALLEL_H
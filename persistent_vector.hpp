@@ -0,0 +1,826 @@
+#ifndef PERSISTENT_VECTOR_H
+#define PERSISTENT_VECTOR_H
+
+#include "utility.hpp"
+
+// Persistent vector with structural sharing. C++11 only: versions share
+// nodes, possibly across threads, through atomic reference counts.
+#ifdef FT_CXX11
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#include "iterator.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+// The elements live in a 32 way trie of full leaves plus a tail leaf that
+// holds the last 1 to 32 elements, as in Clojure's PersistentVector.
+// Updates copy the path from the root to the leaf they touch and share
+// everything else. A node reached only by the vector being edited, which
+// its reference count shows, is updated in place instead: that is how a
+// transient batches edits and how push_back on a temporary avoids copies.
+namespace persistent_trie {
+
+static const std::size_t bits = 5;
+static const std::size_t width = std::size_t(1) << bits;
+static const std::size_t mask = width - 1;
+
+struct node
+{
+    node() : refs(1) {}
+    std::atomic<std::size_t> refs;
+};
+
+struct inner : public node
+{
+    inner()
+    {
+        for (std::size_t i = 0; i < width; ++i) {
+            child[i] = NULL;
+        }
+    }
+    node* child[width];
+};
+
+template <class T>
+struct leaf : public node
+{
+    T*       values()       { return reinterpret_cast<T*>(&storage);       }
+    const T* values() const { return reinterpret_cast<const T*>(&storage); }
+
+    typename std::aligned_storage<sizeof(T) * width, alignof(T)>::type storage;
+};
+
+}; // namespace persistent_trie
+
+// Random access iterator over a persistent_vector, which it never
+// modifies. It keeps the leaf of its position, so stepping within a leaf
+// is an index increment.
+template <class Vec>
+class persistent_iterator
+    : public iterator<random_access_iterator_tag, const typename Vec::value_type>
+{
+    typedef iterator<random_access_iterator_tag, const typename Vec::value_type> base_;
+
+public:
+    typedef persistent_iterator                  iterator_type;
+    typedef typename base_::iterator_category    iterator_category;
+    typedef typename base_::value_type           value_type;
+    typedef typename base_::difference_type      difference_type;
+    typedef typename base_::pointer              pointer;
+    typedef typename base_::const_pointer        const_pointer;
+    typedef typename base_::reference            reference;
+    typedef typename base_::const_reference      const_reference;
+
+    persistent_iterator() : vec_(NULL), i_(0), leaf_(NULL) {}
+    persistent_iterator(const Vec* vec, std::size_t i) : vec_(vec) { set_(i); }
+
+    std::size_t index() const { return i_; }
+
+// Dereference
+    reference operator*() const                   { return leaf_[i_ & persistent_trie::mask]; }
+    pointer   operator->() const                  { return &**this;                           }
+    reference operator[](difference_type n) const { return *(*this + n);                      }
+
+// Increment/decrement
+    persistent_iterator& operator++()
+    {
+        if ((++i_ & persistent_trie::mask) == 0) {
+            set_(i_);
+        }
+        return *this;
+    }
+    persistent_iterator& operator--()
+    {
+        if ((i_ & persistent_trie::mask) == 0 || !leaf_) {
+            set_(i_ - 1);
+        }
+        else {
+            --i_;
+        }
+        return *this;
+    }
+    persistent_iterator  operator++(int) { persistent_iterator tmp(*this); ++*this; return tmp; }
+    persistent_iterator  operator--(int) { persistent_iterator tmp(*this); --*this; return tmp; }
+
+// Arithmetic
+    persistent_iterator& operator+=(difference_type n) { set_(i_ + n); return *this; }
+    persistent_iterator& operator-=(difference_type n) { set_(i_ - n); return *this; }
+    persistent_iterator  operator+(difference_type n) const { return persistent_iterator(vec_, i_ + n); }
+    persistent_iterator  operator-(difference_type n) const { return persistent_iterator(vec_, i_ - n); }
+
+    friend persistent_iterator operator+(difference_type n, const persistent_iterator& it)
+    { return it + n; }
+    friend difference_type operator-(const persistent_iterator& a, const persistent_iterator& b)
+    { return static_cast<difference_type>(a.i_ - b.i_); }
+
+    friend bool operator==(const persistent_iterator& a, const persistent_iterator& b) { return a.i_ == b.i_; }
+    friend bool operator!=(const persistent_iterator& a, const persistent_iterator& b) { return a.i_ != b.i_; }
+    friend bool operator< (const persistent_iterator& a, const persistent_iterator& b) { return a.i_ <  b.i_; }
+    friend bool operator> (const persistent_iterator& a, const persistent_iterator& b) { return a.i_ >  b.i_; }
+    friend bool operator<=(const persistent_iterator& a, const persistent_iterator& b) { return a.i_ <= b.i_; }
+    friend bool operator>=(const persistent_iterator& a, const persistent_iterator& b) { return a.i_ >= b.i_; }
+
+private:
+    // past the end there is no leaf to keep
+    void set_(std::size_t i)
+    {
+        i_ = i;
+        leaf_ = i < vec_->size() ? vec_->leaf_values_(i) : NULL;
+    }
+
+    const Vec*        vec_;
+    std::size_t       i_;
+    const value_type* leaf_;
+};
+
+template <class T, class Allocator = std::allocator<T> >
+class persistent_vector
+{
+public:
+
+// Member types
+    typedef T                                        value_type;
+    typedef Allocator                                allocator_type;
+    typedef const value_type&                        reference;
+    typedef const value_type&                        const_reference;
+    typedef const value_type*                        pointer;
+    typedef const value_type*                        const_pointer;
+    typedef ft::persistent_iterator<persistent_vector> iterator;
+    typedef iterator                                 const_iterator;
+    typedef ft::reverse_iterator<iterator>           reverse_iterator;
+    typedef reverse_iterator                         const_reverse_iterator;
+    typedef std::ptrdiff_t                           difference_type;
+    typedef std::size_t                              size_type;
+
+    class transient_type;
+
+// Constructors
+    explicit persistent_vector(const allocator_type& alloc = allocator_type());
+    template <class InputIterator>
+             persistent_vector(InputIterator first, InputIterator last,
+                               const allocator_type& alloc = allocator_type(),
+                               typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type = 0);
+    template <class A, class G>
+    explicit persistent_vector(const ft::vector<T, A, G>& v,
+                               const allocator_type& alloc = allocator_type());
+             persistent_vector(const persistent_vector& x);
+             persistent_vector(persistent_vector&& x);
+
+    ~persistent_vector();
+
+    persistent_vector& operator=(const persistent_vector& x);
+    persistent_vector& operator=(persistent_vector&& x);
+
+// Iterators
+    const_iterator         begin() const  { return const_iterator(this, 0);         }
+    const_iterator         end() const    { return const_iterator(this, size_);     }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end());   }
+    const_reverse_iterator rend() const   { return const_reverse_iterator(begin()); }
+
+// Capacity
+    size_type size() const     { return size_;  }
+    size_type max_size() const { return alloc_.max_size(); }
+    bool      empty() const    { return !size_; }
+
+// Element access
+    const_reference operator[](size_type n) const { return leaf_values_(n)[n & persistent_trie::mask]; }
+    const_reference at(size_type n) const;
+    const_reference front() const { return (*this)[0];         }
+    const_reference back() const  { return (*this)[size_ - 1]; }
+
+// Updates, each returns the new version and leaves this one as it was
+    persistent_vector set(size_type n, const value_type& val) const &;
+    persistent_vector set(size_type n, const value_type& val) &&;
+    persistent_vector push_back(const value_type& val) const &;
+    persistent_vector push_back(const value_type& val) &&;
+    persistent_vector pop_back() const &;
+    persistent_vector pop_back() &&;
+
+    transient_type    transient() const { return transient_type(*this); }
+    void              swap(persistent_vector& x);
+
+// Conversion
+    ft::vector<T, Allocator> to_vector() const
+    { return ft::vector<T, Allocator>(begin(), end(), alloc_); }
+
+// Allocator
+    allocator_type get_allocator() const { return alloc_; }
+
+private:
+    friend class ft::persistent_iterator<persistent_vector>;
+
+    typedef persistent_trie::node                                          node_;
+    typedef persistent_trie::inner                                         inner_;
+    typedef persistent_trie::leaf<T>                                       leaf_;
+    typedef typename allocator_type::template rebind<inner_>::other        inner_allocator_;
+    typedef typename allocator_type::template rebind<leaf_>::other         leaf_allocator_;
+
+    allocator_type alloc_;
+    inner_*        root_;  // NULL while the tail holds everything
+    leaf_*         tail_;  // NULL when empty
+    size_type      size_;
+    size_type      shift_; // level of the root, a multiple of bits
+
+    size_type    tail_offset_() const { return size_ ? (size_ - 1) & ~persistent_trie::mask : 0; }
+    size_type    tail_size_() const   { return size_ - tail_offset_(); }
+    leaf_*       leaf_for_(size_type i) const;
+    const T*     leaf_values_(size_type i) const { return leaf_for_(i)->values(); }
+
+    void         set_(size_type n, const value_type& val);
+    void         push_back_(const value_type& val);
+    void         pop_back_();
+    void         push_tail_(leaf_* full);
+    void         push_tail_into_(inner_* parent, size_type level, leaf_* full);
+    bool         pop_tail_from_(inner_* parent, size_type level);
+    node_*       new_path_(size_type level, leaf_* l);
+
+    inner_*      new_inner_();
+    leaf_*       new_leaf_();
+    void         unique_inner_(inner_*& p, size_type level);
+    void         unique_leaf_(leaf_*& p, size_type count);
+    void         release_inner_(inner_* p, size_type level);
+    void         release_leaf_(leaf_* p, size_type count);
+    static void  retain_(node_* p) { if (p) { p->refs.fetch_add(1, std::memory_order_relaxed); } }
+    void         clear_();
+};
+
+// Mutable handle on a version, for batches of edits: nodes it already
+// copied are updated in place. The versions it hands out with
+// persistent() are never modified by later edits.
+template <class T, class Allocator>
+class persistent_vector<T, Allocator>::transient_type
+{
+public:
+    explicit transient_type(const persistent_vector& v) : v_(v) {}
+
+    size_type       size() const                  { return v_.size();  }
+    bool            empty() const                 { return v_.empty(); }
+    const_reference operator[](size_type n) const { return v_[n];      }
+    const_reference back() const                  { return v_.back();  }
+
+    transient_type& set(size_type n, const value_type& val)
+    {
+        if (n >= v_.size_) {
+            throw std::out_of_range("persistent_vector");
+        }
+        v_.set_(n, val);
+        return *this;
+    }
+    transient_type& push_back(const value_type& val) { v_.push_back_(val); return *this; }
+    transient_type& pop_back()                       { v_.pop_back_();     return *this; }
+
+    persistent_vector persistent() const { return v_; }
+
+private:
+    persistent_vector v_;
+};
+
+/***** Constructors *****/
+
+template <class T, class Allocator>
+persistent_vector<T, Allocator>::persistent_vector(const allocator_type& alloc)
+    : alloc_(alloc)
+    , root_(NULL)
+    , tail_(NULL)
+    , size_(0)
+    , shift_(persistent_trie::bits)
+{
+}
+
+template <class T, class Allocator>
+    template <class InputIterator>
+persistent_vector<T, Allocator>::persistent_vector(InputIterator first, InputIterator last,
+const allocator_type& alloc,
+typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type)
+    : alloc_(alloc)
+    , root_(NULL)
+    , tail_(NULL)
+    , size_(0)
+    , shift_(persistent_trie::bits)
+{
+    try {
+        for (; first != last; ++first) {
+            push_back_(*first);
+        }
+    }
+    catch (...) {
+        clear_();
+        throw;
+    }
+}
+
+template <class T, class Allocator>
+    template <class A, class G>
+persistent_vector<T, Allocator>::persistent_vector(const ft::vector<T, A, G>& v,
+                                                   const allocator_type& alloc)
+    : alloc_(alloc)
+    , root_(NULL)
+    , tail_(NULL)
+    , size_(0)
+    , shift_(persistent_trie::bits)
+{
+    try {
+        for (size_type i = 0; i < v.size(); ++i) {
+            push_back_(v[i]);
+        }
+    }
+    catch (...) {
+        clear_();
+        throw;
+    }
+}
+
+template <class T, class Allocator>
+persistent_vector<T, Allocator>::persistent_vector(const persistent_vector& x)
+    : alloc_(x.alloc_)
+    , root_(x.root_)
+    , tail_(x.tail_)
+    , size_(x.size_)
+    , shift_(x.shift_)
+{
+    retain_(root_);
+    retain_(tail_);
+}
+
+template <class T, class Allocator>
+persistent_vector<T, Allocator>::persistent_vector(persistent_vector&& x)
+    : alloc_(std::move(x.alloc_))
+    , root_(x.root_)
+    , tail_(x.tail_)
+    , size_(x.size_)
+    , shift_(x.shift_)
+{
+    x.root_ = NULL;
+    x.tail_ = NULL;
+    x.size_ = 0;
+    x.shift_ = persistent_trie::bits;
+}
+
+template <class T, class Allocator>
+persistent_vector<T, Allocator>::~persistent_vector()
+{
+    clear_();
+}
+
+template <class T, class Allocator>
+persistent_vector<T, Allocator>&
+persistent_vector<T, Allocator>::operator=(const persistent_vector& x)
+{
+    persistent_vector tmp(x);
+    swap(tmp);
+    return *this;
+}
+
+template <class T, class Allocator>
+persistent_vector<T, Allocator>&
+persistent_vector<T, Allocator>::operator=(persistent_vector&& x)
+{
+    if (this != &x) {
+        clear_();
+        swap(x);
+    }
+    return *this;
+}
+
+/***** Element access *****/
+
+template <class T, class Allocator>
+typename persistent_vector<T, Allocator>::const_reference
+persistent_vector<T, Allocator>::at(size_type n) const
+{
+    if (n >= size_) {
+        throw std::out_of_range("persistent_vector");
+    }
+    return (*this)[n];
+}
+
+/***** Updates *****/
+
+template <class T, class Allocator>
+persistent_vector<T, Allocator>
+persistent_vector<T, Allocator>::set(size_type n, const value_type& val) const &
+{
+    return persistent_vector(*this).set(n, val);
+}
+
+template <class T, class Allocator>
+persistent_vector<T, Allocator>
+persistent_vector<T, Allocator>::set(size_type n, const value_type& val) &&
+{
+    if (n >= size_) {
+        throw std::out_of_range("persistent_vector");
+    }
+    set_(n, val);
+    return std::move(*this);
+}
+
+template <class T, class Allocator>
+persistent_vector<T, Allocator>
+persistent_vector<T, Allocator>::push_back(const value_type& val) const &
+{
+    return persistent_vector(*this).push_back(val);
+}
+
+template <class T, class Allocator>
+persistent_vector<T, Allocator>
+persistent_vector<T, Allocator>::push_back(const value_type& val) &&
+{
+    push_back_(val);
+    return std::move(*this);
+}
+
+template <class T, class Allocator>
+persistent_vector<T, Allocator>
+persistent_vector<T, Allocator>::pop_back() const &
+{
+    return persistent_vector(*this).pop_back();
+}
+
+template <class T, class Allocator>
+persistent_vector<T, Allocator>
+persistent_vector<T, Allocator>::pop_back() &&
+{
+    pop_back_();
+    return std::move(*this);
+}
+
+template <class T, class Allocator>
+void persistent_vector<T, Allocator>::swap(persistent_vector& x)
+{
+    ft::swap(alloc_, x.alloc_);
+    ft::swap(root_, x.root_);
+    ft::swap(tail_, x.tail_);
+    ft::swap(size_, x.size_);
+    ft::swap(shift_, x.shift_);
+}
+
+/***** Non-member function overloads *****/
+
+template <class T, class Alloc>
+inline void swap(persistent_vector<T, Alloc>& x, persistent_vector<T, Alloc>& y)
+{
+    x.swap(y);
+}
+
+template <class T, class Alloc>
+inline bool operator==(const persistent_vector<T, Alloc>& lhs,
+                       const persistent_vector<T, Alloc>& rhs)
+{
+    return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Alloc>
+inline bool operator!=(const persistent_vector<T, Alloc>& lhs,
+                       const persistent_vector<T, Alloc>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class T, class Alloc>
+inline bool operator<(const persistent_vector<T, Alloc>& lhs,
+                      const persistent_vector<T, Alloc>& rhs)
+{
+    return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, class Alloc>
+inline bool operator<=(const persistent_vector<T, Alloc>& lhs,
+                       const persistent_vector<T, Alloc>& rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <class T, class Alloc>
+inline bool operator>(const persistent_vector<T, Alloc>& lhs,
+                      const persistent_vector<T, Alloc>& rhs)
+{
+    return rhs < lhs;
+}
+
+template <class T, class Alloc>
+inline bool operator>=(const persistent_vector<T, Alloc>& lhs,
+                       const persistent_vector<T, Alloc>& rhs)
+{
+    return !(lhs < rhs);
+}
+
+/***** private *****/
+
+template <class T, class Allocator>
+typename persistent_vector<T, Allocator>::leaf_*
+persistent_vector<T, Allocator>::leaf_for_(size_type i) const
+{
+    if (i >= tail_offset_()) {
+        return tail_;
+    }
+    node_* n = root_;
+    for (size_type level = shift_; level > 0; level -= persistent_trie::bits) {
+        n = static_cast<inner_*>(n)->child[(i >> level) & persistent_trie::mask];
+    }
+    return static_cast<leaf_*>(n);
+}
+
+template <class T, class Allocator>
+void persistent_vector<T, Allocator>::set_(size_type n, const value_type& val)
+{
+    if (n >= tail_offset_()) {
+        unique_leaf_(tail_, tail_size_());
+        tail_->values()[n & persistent_trie::mask] = val;
+        return;
+    }
+    unique_inner_(root_, shift_);
+    inner_* parent = root_;
+    for (size_type level = shift_; level > persistent_trie::bits; level -= persistent_trie::bits) {
+        node_*& slot = parent->child[(n >> level) & persistent_trie::mask];
+        inner_* child = static_cast<inner_*>(slot);
+        unique_inner_(child, level - persistent_trie::bits);
+        slot = child;
+        parent = child;
+    }
+    node_*& slot = parent->child[(n >> persistent_trie::bits) & persistent_trie::mask];
+    leaf_*  l = static_cast<leaf_*>(slot);
+    unique_leaf_(l, persistent_trie::width);
+    slot = l;
+    l->values()[n & persistent_trie::mask] = val;
+}
+
+// A full tail moves into the trie as it is and a new tail starts.
+template <class T, class Allocator>
+void persistent_vector<T, Allocator>::push_back_(const value_type& val)
+{
+    size_type count = tail_size_();
+    if (size_ && count < persistent_trie::width) {
+        unique_leaf_(tail_, count);
+        alloc_.construct(tail_->values() + count, val);
+        ++size_;
+        return;
+    }
+    leaf_* l = new_leaf_();
+    try {
+        alloc_.construct(l->values(), val);
+    }
+    catch (...) {
+        leaf_allocator_(alloc_).deallocate(l, 1);
+        throw;
+    }
+    if (size_) {
+        try {
+            push_tail_(tail_);
+        }
+        catch (...) {
+            release_leaf_(l, 1);
+            throw;
+        }
+    }
+    tail_ = l;
+    ++size_;
+}
+
+// The last tree leaf becomes the tail when the tail runs out.
+template <class T, class Allocator>
+void persistent_vector<T, Allocator>::pop_back_()
+{
+    size_type count = tail_size_();
+    if (size_ == 1) {
+        clear_();
+        return;
+    }
+    if (count > 1) {
+        unique_leaf_(tail_, count);
+        alloc_.destroy(tail_->values() + count - 1);
+        --size_;
+        return;
+    }
+    leaf_* l = leaf_for_(size_ - 2);
+    retain_(l);
+    try {
+        unique_inner_(root_, shift_);
+        pop_tail_from_(root_, shift_);
+    }
+    catch (...) {
+        release_leaf_(l, persistent_trie::width);
+        throw;
+    }
+    release_leaf_(tail_, 1);
+    tail_ = l;
+    --size_;
+    if (size_ == persistent_trie::width) {
+        release_inner_(root_, shift_);
+        root_ = NULL;
+    }
+    else if (shift_ > persistent_trie::bits && !root_->child[1]) {
+        inner_* child = static_cast<inner_*>(root_->child[0]);
+        root_->child[0] = NULL;
+        release_inner_(root_, shift_);
+        root_ = child;
+        shift_ -= persistent_trie::bits;
+    }
+}
+
+// size_ still counts the full tail being pushed. A trie that is full at
+// its height gets a new root above it, allocated before the path so that
+// a failure leaves nothing behind.
+template <class T, class Allocator>
+void persistent_vector<T, Allocator>::push_tail_(leaf_* full)
+{
+    if (!root_) {
+        root_ = new_inner_();
+    }
+    if ((size_ >> persistent_trie::bits) > (size_type(1) << shift_)) {
+        inner_* root = new_inner_();
+        node_*  path;
+        try {
+            path = new_path_(shift_, full);
+        }
+        catch (...) {
+            inner_allocator_(alloc_).deallocate(root, 1);
+            throw;
+        }
+        root->child[0] = root_;
+        root->child[1] = path;
+        root_ = root;
+        shift_ += persistent_trie::bits;
+        return;
+    }
+    unique_inner_(root_, shift_);
+    push_tail_into_(root_, shift_, full);
+}
+
+template <class T, class Allocator>
+void persistent_vector<T, Allocator>::push_tail_into_(inner_* parent, size_type level,
+                                                      leaf_* full)
+{
+    node_*& slot = parent->child[((size_ - 1) >> level) & persistent_trie::mask];
+    if (level == persistent_trie::bits) {
+        slot = full;
+    }
+    else if (slot) {
+        inner_* child = static_cast<inner_*>(slot);
+        unique_inner_(child, level - persistent_trie::bits);
+        slot = child;
+        push_tail_into_(child, level - persistent_trie::bits, full);
+    }
+    else {
+        slot = new_path_(level - persistent_trie::bits, full);
+    }
+}
+
+// Unlinks the leaf of element size_ - 2 from a parent this version owns,
+// true when the parent is left empty: the slot was its first and nothing
+// is left below it.
+template <class T, class Allocator>
+bool persistent_vector<T, Allocator>::pop_tail_from_(inner_* parent, size_type level)
+{
+    size_type sub = ((size_ - 2) >> level) & persistent_trie::mask;
+    node_*&   slot = parent->child[sub];
+
+    if (level > persistent_trie::bits) {
+        inner_* child = static_cast<inner_*>(slot);
+        unique_inner_(child, level - persistent_trie::bits);
+        slot = child;
+        if (pop_tail_from_(child, level - persistent_trie::bits)) {
+            release_inner_(child, level - persistent_trie::bits);
+            slot = NULL;
+        }
+    }
+    else {
+        release_leaf_(static_cast<leaf_*>(slot), persistent_trie::width);
+        slot = NULL;
+    }
+    return sub == 0 && !slot;
+}
+
+// A chain of single child inner nodes from level down to the leaf l.
+template <class T, class Allocator>
+typename persistent_vector<T, Allocator>::node_*
+persistent_vector<T, Allocator>::new_path_(size_type level, leaf_* l)
+{
+    node_* path = l;
+    try {
+        for (size_type lvl = persistent_trie::bits; lvl <= level; lvl += persistent_trie::bits) {
+            inner_* n = new_inner_();
+            n->child[0] = path;
+            path = n;
+        }
+    }
+    catch (...) {
+        while (path != l) {
+            inner_* n = static_cast<inner_*>(path);
+            path = n->child[0];
+            inner_allocator_(alloc_).deallocate(n, 1);
+        }
+        throw;
+    }
+    return path;
+}
+
+template <class T, class Allocator>
+typename persistent_vector<T, Allocator>::inner_*
+persistent_vector<T, Allocator>::new_inner_()
+{
+    inner_* p = inner_allocator_(alloc_).allocate(1);
+    return ::new (static_cast<void*>(p)) inner_();
+}
+
+template <class T, class Allocator>
+typename persistent_vector<T, Allocator>::leaf_*
+persistent_vector<T, Allocator>::new_leaf_()
+{
+    leaf_* p = leaf_allocator_(alloc_).allocate(1);
+    return ::new (static_cast<void*>(p)) leaf_();
+}
+
+// Makes p a node only this version reaches, copying it when it is shared.
+template <class T, class Allocator>
+void persistent_vector<T, Allocator>::unique_inner_(inner_*& p, size_type level)
+{
+    if (p->refs.load(std::memory_order_acquire) == 1) {
+        return;
+    }
+    inner_* copy = new_inner_();
+    for (size_type i = 0; i < persistent_trie::width; ++i) {
+        copy->child[i] = p->child[i];
+        retain_(copy->child[i]);
+    }
+    release_inner_(p, level);
+    p = copy;
+}
+
+template <class T, class Allocator>
+void persistent_vector<T, Allocator>::unique_leaf_(leaf_*& p, size_type count)
+{
+    if (p->refs.load(std::memory_order_acquire) == 1) {
+        return;
+    }
+    leaf_*    copy = new_leaf_();
+    size_type i = 0;
+    try {
+        for (; i < count; ++i) {
+            alloc_.construct(copy->values() + i, p->values()[i]);
+        }
+    }
+    catch (...) {
+        while (i) {
+            alloc_.destroy(copy->values() + --i);
+        }
+        leaf_allocator_(alloc_).deallocate(copy, 1);
+        throw;
+    }
+    release_leaf_(p, count);
+    p = copy;
+}
+
+template <class T, class Allocator>
+void persistent_vector<T, Allocator>::release_inner_(inner_* p, size_type level)
+{
+    if (!p || p->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    for (size_type i = 0; i < persistent_trie::width; ++i) {
+        if (level == persistent_trie::bits) {
+            release_leaf_(static_cast<leaf_*>(p->child[i]), persistent_trie::width);
+        }
+        else {
+            release_inner_(static_cast<inner_*>(p->child[i]), level - persistent_trie::bits);
+        }
+    }
+    p->~inner_();
+    inner_allocator_(alloc_).deallocate(p, 1);
+}
+
+template <class T, class Allocator>
+void persistent_vector<T, Allocator>::release_leaf_(leaf_* p, size_type count)
+{
+    if (!p || p->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    for (size_type i = 0; i < count; ++i) {
+        alloc_.destroy(p->values() + i);
+    }
+    p->~leaf_();
+    leaf_allocator_(alloc_).deallocate(p, 1);
+}
+
+template <class T, class Allocator>
+void persistent_vector<T, Allocator>::clear_()
+{
+    release_leaf_(tail_, tail_size_());
+    release_inner_(root_, shift_);
+    root_ = NULL;
+    tail_ = NULL;
+    size_ = 0;
+    shift_ = persistent_trie::bits;
+}
+
+}; // namespace ft
+
+#endif // FT_CXX11
+
+#endif // PERSISTENT_VECTOR_H
@@ -0,0 +1,640 @@
+#ifndef SEGMENTED_VECTOR_H
+#define SEGMENTED_VECTOR_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+#include "iterator.hpp"
+#include "utility.hpp"
+
+namespace ft {
+
+// Segment k of a segmented_vector holds N << k elements, so the segments
+// before it hold (N << k) - N. Element i is in segment
+// floor(log2(i + N)) - log2(N), which is one bit scan.
+template <std::size_t N>
+struct segment_layout
+{
+    static const std::size_t shift = log2_<N>::value;
+    static const std::size_t max_segments = sizeof(std::size_t) * 8 - shift;
+
+    static std::size_t segment(std::size_t i)
+    {
+        std::size_t j = i + N;
+#if defined(__GNUC__) || defined(__clang__)
+        return sizeof(unsigned long) * 8 - 1 - __builtin_clzl(j) - shift;
+#else
+        std::size_t k = 0;
+        while (j >>= 1) {
+            ++k;
+        }
+        return k - shift;
+#endif
+    }
+
+    static std::size_t offset(std::size_t i, std::size_t k) { return i + N - (N << k); }
+    static std::size_t length(std::size_t k)                { return N << k;           }
+    static std::size_t capacity(std::size_t segments)       { return (N << segments) - N; }
+};
+
+// Random access iterator over a segmented_vector. It keeps the bounds of
+// the current segment, so stepping through a segment is a pointer
+// increment.
+template <class T, std::size_t N>
+class segmented_iterator : public iterator<random_access_iterator_tag, T>
+{
+public:
+    typedef segmented_iterator                                                  iterator_type;
+    typedef typename iterator<random_access_iterator_tag, T>::iterator_category iterator_category;
+    typedef typename iterator<random_access_iterator_tag, T>::value_type        value_type;
+    typedef typename iterator<random_access_iterator_tag, T>::difference_type   difference_type;
+    typedef typename iterator<random_access_iterator_tag, T>::pointer           pointer;
+    typedef typename iterator<random_access_iterator_tag, T>::const_pointer     const_pointer;
+    typedef typename iterator<random_access_iterator_tag, T>::reference         reference;
+    typedef typename iterator<random_access_iterator_tag, T>::const_reference   const_reference;
+    typedef T* const*                                                           table_pointer;
+
+    segmented_iterator() : table_(NULL), segments_(0), i_(0), cur_(NULL), first_(NULL), last_(NULL) {}
+    segmented_iterator(table_pointer table, std::size_t segments, std::size_t i)
+        : table_(table), segments_(segments)
+    { set_(i); }
+    template <class U>
+    segmented_iterator(const segmented_iterator<U, N>& other,
+                       typename enable_if<is_same<const U, T>::value, bool>::type = 0)
+        : table_(other.table()), segments_(other.segments())
+    { set_(other.index()); }
+
+    table_pointer table() const    { return table_;    }
+    std::size_t   segments() const { return segments_; }
+    std::size_t   index() const    { return i_;        }
+
+// Dereference
+    reference operator*() const                   { return *cur_;               }
+    pointer   operator->() const                  { return cur_;                }
+    reference operator[](difference_type n) const { return *(*this + n);        }
+
+// Increment/decrement
+    segmented_iterator& operator++()
+    {
+        ++i_;
+        if (++cur_ == last_) {
+            set_(i_);
+        }
+        return *this;
+    }
+    segmented_iterator& operator--()
+    {
+        if (cur_ == first_) {
+            set_(i_ - 1);
+        }
+        else {
+            --cur_;
+            --i_;
+        }
+        return *this;
+    }
+    segmented_iterator  operator++(int) { segmented_iterator tmp(*this); ++*this; return tmp; }
+    segmented_iterator  operator--(int) { segmented_iterator tmp(*this); --*this; return tmp; }
+
+// Arithmetic
+    segmented_iterator& operator+=(difference_type n) { set_(i_ + n); return *this; }
+    segmented_iterator& operator-=(difference_type n) { set_(i_ - n); return *this; }
+    segmented_iterator  operator+(difference_type n) const
+    { return segmented_iterator(table_, segments_, i_ + n); }
+    segmented_iterator  operator-(difference_type n) const
+    { return segmented_iterator(table_, segments_, i_ - n); }
+
+    friend segmented_iterator operator+(difference_type n, const segmented_iterator& it)
+    { return it + n; }
+
+private:
+    typedef segment_layout<N> layout_;
+
+    // an index past the allocated segments, like end() of a full vector,
+    // gets null bounds
+    void set_(std::size_t i)
+    {
+        std::size_t k = layout_::segment(i);
+        i_ = i;
+        if (k >= segments_) {
+            cur_ = first_ = last_ = NULL;
+            return;
+        }
+        first_ = table_[k];
+        last_ = first_ + layout_::length(k);
+        cur_ = first_ + layout_::offset(i, k);
+    }
+
+    table_pointer table_;
+    std::size_t   segments_;
+    std::size_t   i_;
+    pointer       cur_;
+    pointer       first_;
+    pointer       last_;
+};
+
+template <class T, class U, std::size_t N>
+inline std::ptrdiff_t operator-(const segmented_iterator<T, N>& a, const segmented_iterator<U, N>& b)
+{ return static_cast<std::ptrdiff_t>(a.index() - b.index()); }
+
+template <class T, class U, std::size_t N>
+inline bool operator==(const segmented_iterator<T, N>& a, const segmented_iterator<U, N>& b)
+{ return a.index() == b.index(); }
+template <class T, class U, std::size_t N>
+inline bool operator!=(const segmented_iterator<T, N>& a, const segmented_iterator<U, N>& b)
+{ return a.index() != b.index(); }
+template <class T, class U, std::size_t N>
+inline bool operator< (const segmented_iterator<T, N>& a, const segmented_iterator<U, N>& b)
+{ return a.index() <  b.index(); }
+template <class T, class U, std::size_t N>
+inline bool operator> (const segmented_iterator<T, N>& a, const segmented_iterator<U, N>& b)
+{ return a.index() >  b.index(); }
+template <class T, class U, std::size_t N>
+inline bool operator<=(const segmented_iterator<T, N>& a, const segmented_iterator<U, N>& b)
+{ return a.index() <= b.index(); }
+template <class T, class U, std::size_t N>
+inline bool operator>=(const segmented_iterator<T, N>& a, const segmented_iterator<U, N>& b)
+{ return a.index() >= b.index(); }
+
+// An append-only vector that grows by adding segments of doubling size
+// and never moves an element: pointers and references stay valid until
+// the element is popped. A push allocates at most one segment and copies
+// nothing, which bounds its latency. The first segment holds N elements,
+// a power of two.
+template <class T, class Allocator = std::allocator<T>, std::size_t N = 16>
+class segmented_vector
+{
+public:
+
+// Member types
+    typedef T                                        value_type;
+    typedef Allocator                                allocator_type;
+    typedef typename allocator_type::reference       reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::pointer         pointer;
+    typedef typename allocator_type::const_pointer   const_pointer;
+    typedef ft::segmented_iterator<value_type, N>       iterator;
+    typedef ft::segmented_iterator<const value_type, N> const_iterator;
+    typedef ft::reverse_iterator<iterator>           reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator>     const_reverse_iterator;
+    typedef typename allocator_type::difference_type difference_type;
+    typedef std::size_t                              size_type;
+
+// Constructors
+    explicit segmented_vector(const allocator_type& alloc = allocator_type());
+    explicit segmented_vector(size_type n, const value_type& val = value_type(),
+                              const allocator_type& alloc = allocator_type());
+    template <class InputIterator>
+             segmented_vector(InputIterator first, InputIterator last,
+                              const allocator_type& alloc = allocator_type(),
+                              typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type = 0);
+             segmented_vector(const segmented_vector& x);
+#ifdef FT_CXX11
+             segmented_vector(segmented_vector&& x);
+#endif
+
+    ~segmented_vector();
+
+    segmented_vector& operator=(const segmented_vector& x);
+#ifdef FT_CXX11
+    segmented_vector& operator=(segmented_vector&& x);
+#endif
+
+// Iterators
+    iterator               begin()        { return iterator(table_, segments_, 0);           }
+    const_iterator         begin() const  { return const_iterator(table_, segments_, 0);     }
+    iterator               end()          { return iterator(table_, segments_, size_);       }
+    const_iterator         end() const    { return const_iterator(table_, segments_, size_); }
+    reverse_iterator       rbegin()       { return reverse_iterator(end());                  }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end());            }
+    reverse_iterator       rend()         { return reverse_iterator(begin());                }
+    const_reverse_iterator rend() const   { return const_reverse_iterator(begin());          }
+
+// Capacity
+    size_type size() const      { return size_; }
+    size_type max_size() const  { return alloc_.max_size(); }
+    void      resize(size_type n, value_type val = value_type());
+    size_type capacity() const  { return layout_::capacity(segments_); }
+    bool      empty() const     { return !size_; }
+    void      reserve(size_type n);
+    void      shrink_to_fit();
+    size_type segment_count() const { return segments_; }
+
+// Element access
+    reference       operator[](size_type n)       { return at_(n); }
+    const_reference operator[](size_type n) const { return at_(n); }
+    reference       at(size_type n);
+    const_reference at(size_type n) const;
+    reference       front()       { return at_(0); }
+    const_reference front() const { return at_(0); }
+    reference       back()        { return at_(size_ - 1); }
+    const_reference back() const  { return at_(size_ - 1); }
+
+// Modifiers
+    template <class InputIterator>
+    void     assign(InputIterator first, InputIterator last,
+                    typename ft::enable_if<
+                    !ft::is_integral<InputIterator>::value, bool>::type = 0);
+    void     assign(size_type n, const value_type& val);
+    void     push_back(const value_type& val);
+    void     pop_back();
+#ifdef FT_CXX11
+    void     push_back(value_type&& val) { emplace_back(std::move(val)); }
+    template <class... Args>
+    void     emplace_back(Args&&... args);
+#endif
+    void     swap(segmented_vector& x);
+    void     clear();
+
+// Allocator
+    allocator_type get_allocator() const { return alloc_; }
+
+private:
+    typedef segment_layout<N> layout_;
+    typedef typename allocator_type::template rebind<pointer>::other table_allocator_;
+    // segment_layout indexes with a bit scan, which needs N a power of two
+    typedef char n_must_be_power_of_two_[(N && !(N & (N - 1))) ? 1 : -1];
+
+    allocator_type alloc_;
+    pointer*       table_;
+    size_type      segments_;
+    size_type      size_;
+    pointer        back_;
+    pointer        back_end_;
+
+    reference at_(size_type i) const
+    {
+        size_type k = layout_::segment(i);
+        return table_[k][layout_::offset(i, k)];
+    }
+
+    void    next_slot_();
+    void    add_segment_();
+    void    steal_(segmented_vector& x);
+    void    destroy_();
+};
+
+/***** Constructors *****/
+
+template <class T, class Allocator, std::size_t N>
+segmented_vector<T, Allocator, N>::segmented_vector(const allocator_type& alloc)
+    : alloc_(alloc)
+    , table_(NULL)
+    , segments_(0)
+    , size_(0)
+    , back_(NULL)
+    , back_end_(NULL)
+{
+}
+
+template <class T, class Allocator, std::size_t N>
+segmented_vector<T, Allocator, N>::segmented_vector(size_type n, const value_type& val,
+                                                    const allocator_type& alloc)
+    : alloc_(alloc)
+    , table_(NULL)
+    , segments_(0)
+    , size_(0)
+    , back_(NULL)
+    , back_end_(NULL)
+{
+    try {
+        assign(n, val);
+    }
+    catch (...) {
+        destroy_();
+        throw;
+    }
+}
+
+template <class T, class Allocator, std::size_t N>
+    template <class InputIterator>
+segmented_vector<T, Allocator, N>::segmented_vector(InputIterator first, InputIterator last,
+const allocator_type& alloc,
+typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type)
+    : alloc_(alloc)
+    , table_(NULL)
+    , segments_(0)
+    , size_(0)
+    , back_(NULL)
+    , back_end_(NULL)
+{
+    try {
+        assign(first, last);
+    }
+    catch (...) {
+        destroy_();
+        throw;
+    }
+}
+
+template <class T, class Allocator, std::size_t N>
+segmented_vector<T, Allocator, N>::segmented_vector(const segmented_vector& x)
+    : alloc_(x.alloc_)
+    , table_(NULL)
+    , segments_(0)
+    , size_(0)
+    , back_(NULL)
+    , back_end_(NULL)
+{
+    try {
+        assign(x.begin(), x.end());
+    }
+    catch (...) {
+        destroy_();
+        throw;
+    }
+}
+
+#ifdef FT_CXX11
+template <class T, class Allocator, std::size_t N>
+segmented_vector<T, Allocator, N>::segmented_vector(segmented_vector&& x)
+    : alloc_(std::move(x.alloc_))
+    , table_(NULL)
+    , segments_(0)
+    , size_(0)
+    , back_(NULL)
+    , back_end_(NULL)
+{
+    steal_(x);
+}
+#endif
+
+template <class T, class Allocator, std::size_t N>
+segmented_vector<T, Allocator, N>::~segmented_vector()
+{
+    destroy_();
+}
+
+template <class T, class Allocator, std::size_t N>
+segmented_vector<T, Allocator, N>&
+segmented_vector<T, Allocator, N>::operator=(const segmented_vector& x)
+{
+    if (this != &x) {
+        assign(x.begin(), x.end());
+    }
+    return *this;
+}
+
+#ifdef FT_CXX11
+template <class T, class Allocator, std::size_t N>
+segmented_vector<T, Allocator, N>&
+segmented_vector<T, Allocator, N>::operator=(segmented_vector&& x)
+{
+    if (this != &x) {
+        destroy_();
+        steal_(x);
+    }
+    return *this;
+}
+#endif
+
+/***** Capacity *****/
+
+template <class T, class Allocator, std::size_t N>
+void segmented_vector<T, Allocator, N>::resize(size_type n, value_type val)
+{
+    while (size_ > n) {
+        pop_back();
+    }
+    reserve(n);
+    while (size_ < n) {
+        push_back(val);
+    }
+}
+
+template <class T, class Allocator, std::size_t N>
+void segmented_vector<T, Allocator, N>::reserve(size_type n)
+{
+    while (capacity() < n) {
+        add_segment_();
+    }
+}
+
+// Frees the segments past the last element, and the table once empty.
+template <class T, class Allocator, std::size_t N>
+void segmented_vector<T, Allocator, N>::shrink_to_fit()
+{
+    size_type needed = size_ ? layout_::segment(size_ - 1) + 1 : 0;
+    while (segments_ > needed) {
+        --segments_;
+        alloc_.deallocate(table_[segments_], layout_::length(segments_));
+        table_[segments_] = NULL;
+    }
+    if (!segments_ && table_) {
+        table_allocator_(alloc_).deallocate(table_, layout_::max_segments);
+        table_ = NULL;
+    }
+    back_ = back_end_ = NULL;
+}
+
+/***** Element access *****/
+
+template <class T, class Allocator, std::size_t N>
+typename segmented_vector<T, Allocator, N>::reference
+segmented_vector<T, Allocator, N>::at(size_type n)
+{
+    if (n >= size_) {
+        throw std::out_of_range("segmented_vector");
+    }
+    return at_(n);
+}
+
+template <class T, class Allocator, std::size_t N>
+typename segmented_vector<T, Allocator, N>::const_reference
+segmented_vector<T, Allocator, N>::at(size_type n) const
+{
+    if (n >= size_) {
+        throw std::out_of_range("segmented_vector");
+    }
+    return at_(n);
+}
+
+/***** Modifiers *****/
+
+template <class T, class Allocator, std::size_t N>
+    template <class InputIterator>
+void segmented_vector<T, Allocator, N>::assign(InputIterator first, InputIterator last,
+typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type)
+{
+    clear();
+    for (; first != last; ++first) {
+        push_back(*first);
+    }
+}
+
+template <class T, class Allocator, std::size_t N>
+void segmented_vector<T, Allocator, N>::assign(size_type n, const value_type& val)
+{
+    value_type copy(val);
+    clear();
+    reserve(n);
+    while (size_ < n) {
+        push_back(copy);
+    }
+}
+
+template <class T, class Allocator, std::size_t N>
+inline void segmented_vector<T, Allocator, N>::push_back(const value_type& val)
+{
+    if (back_ == back_end_) {
+        next_slot_();
+    }
+    alloc_.construct(back_, val);
+    ++back_;
+    ++size_;
+}
+
+#ifdef FT_CXX11
+template <class T, class Allocator, std::size_t N>
+    template <class... Args>
+inline void segmented_vector<T, Allocator, N>::emplace_back(Args&&... args)
+{
+    if (back_ == back_end_) {
+        next_slot_();
+    }
+    alloc_.construct(back_, std::forward<Args>(args)...);
+    ++back_;
+    ++size_;
+}
+#endif
+
+// The slot cache is dropped; the next push finds it again.
+template <class T, class Allocator, std::size_t N>
+void segmented_vector<T, Allocator, N>::pop_back()
+{
+    --size_;
+    alloc_.destroy(&at_(size_));
+    back_ = back_end_ = NULL;
+}
+
+template <class T, class Allocator, std::size_t N>
+void segmented_vector<T, Allocator, N>::swap(segmented_vector& x)
+{
+    ft::swap(table_, x.table_);
+    ft::swap(segments_, x.segments_);
+    ft::swap(size_, x.size_);
+    ft::swap(back_, x.back_);
+    ft::swap(back_end_, x.back_end_);
+}
+
+template <class T, class Allocator, std::size_t N>
+void segmented_vector<T, Allocator, N>::clear()
+{
+    while (size_) {
+        pop_back();
+    }
+}
+
+/***** Private member functions *****/
+
+// Points back_ at the slot of index size_, in a new segment when the
+// vector is full.
+template <class T, class Allocator, std::size_t N>
+void segmented_vector<T, Allocator, N>::next_slot_()
+{
+    if (size_ == capacity()) {
+        add_segment_();
+    }
+    size_type k = layout_::segment(size_);
+    back_ = table_[k] + layout_::offset(size_, k);
+    back_end_ = table_[k] + layout_::length(k);
+}
+
+template <class T, class Allocator, std::size_t N>
+void segmented_vector<T, Allocator, N>::add_segment_()
+{
+    if (segments_ == layout_::max_segments) {
+        throw std::length_error("segmented_vector");
+    }
+    if (!table_) {
+        table_allocator_ table_alloc(alloc_);
+        table_ = table_alloc.allocate(layout_::max_segments);
+        std::memset(static_cast<void*>(table_), 0,
+                    layout_::max_segments * sizeof(pointer));
+    }
+    table_[segments_] = alloc_.allocate(layout_::length(segments_));
+    ++segments_;
+}
+
+template <class T, class Allocator, std::size_t N>
+void segmented_vector<T, Allocator, N>::steal_(segmented_vector& x)
+{
+    table_ = x.table_;
+    segments_ = x.segments_;
+    size_ = x.size_;
+    back_ = x.back_;
+    back_end_ = x.back_end_;
+    x.table_ = NULL;
+    x.segments_ = x.size_ = 0;
+    x.back_ = x.back_end_ = NULL;
+}
+
+template <class T, class Allocator, std::size_t N>
+void segmented_vector<T, Allocator, N>::destroy_()
+{
+    clear();
+    while (segments_) {
+        --segments_;
+        alloc_.deallocate(table_[segments_], layout_::length(segments_));
+    }
+    if (table_) {
+        table_allocator_(alloc_).deallocate(table_, layout_::max_segments);
+        table_ = NULL;
+    }
+}
+
+/***** Non-member function overloads *****/
+
+template <class T, class Alloc, std::size_t N>
+inline void swap(segmented_vector<T, Alloc, N>& x, segmented_vector<T, Alloc, N>& y)
+{
+    x.swap(y);
+}
+
+template <class T, class Alloc, std::size_t N>
+inline bool operator==(const segmented_vector<T, Alloc, N>& lhs,
+                       const segmented_vector<T, Alloc, N>& rhs)
+{
+    return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Alloc, std::size_t N>
+inline bool operator!=(const segmented_vector<T, Alloc, N>& lhs,
+                       const segmented_vector<T, Alloc, N>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class T, class Alloc, std::size_t N>
+inline bool operator<(const segmented_vector<T, Alloc, N>& lhs,
+                      const segmented_vector<T, Alloc, N>& rhs)
+{
+    return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, class Alloc, std::size_t N>
+inline bool operator<=(const segmented_vector<T, Alloc, N>& lhs,
+                       const segmented_vector<T, Alloc, N>& rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <class T, class Alloc, std::size_t N>
+inline bool operator>(const segmented_vector<T, Alloc, N>& lhs,
+                      const segmented_vector<T, Alloc, N>& rhs)
+{
+    return rhs < lhs;
+}
+
+template <class T, class Alloc, std::size_t N>
+inline bool operator>=(const segmented_vector<T, Alloc, N>& lhs,
+                       const segmented_vector<T, Alloc, N>& rhs)
+{
+    return !(lhs < rhs);
+}
+
+}; // namespace ft
+
+#endif // SEGMENTED_VECTOR_H
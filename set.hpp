@@ -35,6 +35,7 @@ public:
     typedef typename _tree_type::const_reverse_iterator const_reverse_iterator;
     typedef typename _tree_type::size_type              size_type;
     typedef typename _tree_type::difference_type        difference_type;
+    typedef ft::node_pool_stats                         pool_stats_type;
 
 public:
     /// default
@@ -52,9 +53,22 @@ public:
         : _tree(first, last, comp, alloc)
     {}
 
+    /// sorted range, see ft::sorted_unique
+    template <class InputIterator>
+    set (ft::sorted_unique_t, InputIterator first, InputIterator last,
+         const key_compare& comp = key_compare(),
+         const allocator_type& alloc = allocator_type())
+        : _tree(ft::sorted_unique, first, last, comp, alloc)
+    {}
+
     /// copy
     set (const set& x) : _tree(x._tree) {}
 
+#ifdef FT_CXX11
+    /// move
+    set (set&& x) : _tree(std::move(x._tree)) {}
+#endif
+
     ~set() {}
 
 public:
@@ -65,7 +79,17 @@ public:
         return *this;
     }
 
-    allocator_type get_allocator() const { return allocator_type(); }
+#ifdef FT_CXX11
+    set& operator=(set&& other)
+    {
+        if (this != &other)
+            _tree = std::move(other._tree);
+        return *this;
+    }
+#endif
+
+    allocator_type get_allocator() const
+    { return allocator_type(_tree.get_allocator()); }
 
     /// iterators
     iterator begin() { return _tree.begin(); }
@@ -91,6 +115,23 @@ public:
 
     size_type max_size() const { return _tree.max_size(); }
 
+    /// node pool
+    size_type node_slab_size() const { return _tree.node_slab_size(); }
+
+    void node_slab_size(size_type n) { _tree.node_slab_size(n); }
+
+    size_type node_cache_limit() const { return _tree.node_cache_limit(); }
+
+    void node_cache_limit(size_type n) { _tree.node_cache_limit(n); }
+
+    /// Gives the memory of nodes no longer in use back to the allocator,
+    /// as far as whole slabs allow. Returns the bytes released.
+    size_type release_unused() { return _tree.release_unused(); }
+
+    void shrink_to_fit() { _tree.release_unused(); }
+
+    pool_stats_type pool_stats() const { return _tree.pool_stats(); }
+
     /// modifiers
     void clear() { _tree.clear(); }
 
@@ -104,6 +145,26 @@ public:
     void insert(InputIterator first, InputIterator last)
     { _tree.insert(first, last); }
 
+    template <class InputIterator>
+    void insert(ft::sorted_unique_t, InputIterator first, InputIterator last)
+    { _tree.insert(ft::sorted_unique, first, last); }
+
+#ifdef FT_CXX11
+    ft::pair<iterator, bool> insert(value_type&& value)
+    { return _tree.insert(std::move(value)); }
+
+    iterator insert(iterator hint, value_type&& value)
+    { return _tree.insert(hint, std::move(value)); }
+
+    template <class... Args>
+    ft::pair<iterator, bool> emplace(Args&&... args)
+    { return _tree.emplace(std::forward<Args>(args)...); }
+
+    template <class... Args>
+    iterator emplace_hint(iterator hint, Args&&... args)
+    { return _tree.emplace_hint(hint, std::forward<Args>(args)...); }
+#endif
+
     void erase(iterator pos)
     { _tree.erase(pos); }
 
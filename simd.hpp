@@ -0,0 +1,402 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cstddef>
+#include <cstring>
+
+// Byte kernels behind ft::equal, ft::lexicographical_compare and the
+// vector fill paths, word kernels behind the packed vector<bool>. On x86
+// SSE2 is used when the compiler targets it, AVX2 when the CPU reports it
+// at run time.
+#if (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__x86_64__) || defined(__i386__))
+# define FT_SIMD_X86
+# include <immintrin.h>
+#endif
+
+namespace ft {
+namespace simd {
+
+// mismatch: index of the first byte that differs in a and b, n if none.
+
+inline std::size_t
+mismatch_scalar(const unsigned char* a, const unsigned char* b,
+                std::size_t n, std::size_t i = 0)
+{
+    while (i < n && a[i] == b[i]) {
+        ++i;
+    }
+    return i;
+}
+
+#if defined(FT_SIMD_X86) && defined(__SSE2__)
+inline std::size_t
+mismatch_sse2(const unsigned char* a, const unsigned char* b, std::size_t n)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        unsigned diff = _mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) ^ 0xFFFFu;
+        if (diff) {
+            return i + __builtin_ctz(diff);
+        }
+    }
+    return mismatch_scalar(a, b, n, i);
+}
+#endif
+
+#ifdef FT_SIMD_X86
+__attribute__((target("avx2")))
+inline std::size_t
+mismatch_avx2(const unsigned char* a, const unsigned char* b, std::size_t n)
+{
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 32));
+        __m256i y1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 32));
+        __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(x0, y0),
+                                      _mm256_cmpeq_epi8(x1, y1));
+        if (static_cast<unsigned>(_mm256_movemask_epi8(eq)) != 0xFFFFFFFFu) {
+            break;
+        }
+    }
+    for (; i + 32 <= n; i += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        unsigned diff = ~static_cast<unsigned>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+        if (diff) {
+            return i + __builtin_ctz(diff);
+        }
+    }
+    return mismatch_scalar(a, b, n, i);
+}
+
+inline bool cpu_has_avx2()
+{
+    static const bool has = (__builtin_cpu_init(),
+                             __builtin_cpu_supports("avx2") != 0);
+    return has;
+}
+#endif
+
+inline std::size_t
+mismatch(const void* a, const void* b, std::size_t n)
+{
+    const unsigned char* x = static_cast<const unsigned char*>(a);
+    const unsigned char* y = static_cast<const unsigned char*>(b);
+
+#ifdef FT_SIMD_X86
+    if (n >= 32 && cpu_has_avx2()) {
+        return mismatch_avx2(x, y, n);
+    }
+#endif
+#if defined(FT_SIMD_X86) && defined(__SSE2__)
+    return mismatch_sse2(x, y, n);
+#else
+    return mismatch_scalar(x, y, n);
+#endif
+}
+
+// fill: n copies of the size bytes at val, written to dst.
+
+// Copies the first element, then doubles the filled prefix with memcpy,
+// reading back at most 64 KiB of it so the source stays in cache.
+inline void
+fill_doubling(unsigned char* dst, const unsigned char* val,
+              std::size_t size, std::size_t n)
+{
+    const std::size_t bytes = size * n;
+    const std::size_t block = size < 65536 ? 65536 / size * size : size;
+
+    std::memcpy(dst, val, size);
+    for (std::size_t done = size; done < bytes; ) {
+        std::size_t len = done < block ? done : block;
+        if (len > bytes - done) {
+            len = bytes - done;
+        }
+        std::memcpy(dst + done, dst, len);
+        done += len;
+    }
+}
+
+#if defined(FT_SIMD_X86) && defined(__SSE2__)
+// pattern repeats with a period that divides 16, bytes is a multiple of it
+inline void
+fill_sse2(unsigned char* dst, const unsigned char* pattern, std::size_t bytes)
+{
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+    std::size_t i = 0;
+    for (; i + 64 <= bytes; i += 64) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 16), v);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 32), v);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 48), v);
+    }
+    for (; i + 16 <= bytes; i += 16) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+    }
+    std::memcpy(dst + i, pattern, bytes - i);
+}
+#endif
+
+#ifdef FT_SIMD_X86
+// Fills past this size bypass the cache with streaming stores.
+static const std::size_t stream_threshold = std::size_t(16) << 20;
+
+// pattern repeats with a period that divides 32, bytes is a multiple of it
+__attribute__((target("avx2")))
+inline void
+fill_avx2(unsigned char* dst, const unsigned char* pattern, std::size_t bytes)
+{
+    std::size_t i = 0;
+    if (bytes >= stream_threshold) {
+        // aligned streaming stores, with the pattern rotated to the phase
+        // it has at the first aligned address
+        std::size_t head = (32 - reinterpret_cast<std::size_t>(dst) % 32) % 32;
+        unsigned char rotated[64];
+        std::memcpy(rotated, pattern, 32);
+        std::memcpy(rotated + 32, pattern, 32);
+        std::memcpy(dst, pattern, head);
+        const __m256i v = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(rotated + head));
+        for (i = head; i + 128 <= bytes; i += 128) {
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), v);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 32), v);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 64), v);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 96), v);
+        }
+        _mm_sfence();
+        for (; i + 32 <= bytes; i += 32) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i), v);
+        }
+        std::memcpy(dst + i, rotated + head, bytes - i);
+        return;
+    }
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+    for (; i + 128 <= bytes; i += 128) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 32), v);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 64), v);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 96), v);
+    }
+    for (; i + 32 <= bytes; i += 32) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+    }
+    std::memcpy(dst + i, pattern, bytes - i);
+}
+#endif
+
+inline void
+fill(void* dst, const void* val, std::size_t size, std::size_t n)
+{
+    unsigned char*       d = static_cast<unsigned char*>(dst);
+    const unsigned char* v = static_cast<const unsigned char*>(val);
+    const std::size_t    bytes = size * n;
+
+    if (!n) {
+        return;
+    }
+    std::size_t same = 1;
+    while (same < size && v[same] == v[0]) {
+        ++same;
+    }
+    if (same == size) {
+        std::memset(d, v[0], bytes);
+        return;
+    }
+#ifdef FT_SIMD_X86
+    if (32 % size == 0 && bytes >= 64) {
+        unsigned char pattern[32];
+        for (std::size_t i = 0; i < 32; i += size) {
+            std::memcpy(pattern + i, v, size);
+        }
+        if (cpu_has_avx2()) {
+            fill_avx2(d, pattern, bytes);
+            return;
+        }
+# ifdef __SSE2__
+        if (16 % size == 0) {
+            fill_sse2(d, pattern, bytes);
+            return;
+        }
+# endif
+    }
+#endif
+    fill_doubling(d, v, size, n);
+}
+
+// Word kernels behind the packed vector<bool>.
+
+typedef unsigned long long word;
+
+// popcount: number of set bits in words [w, w + n).
+
+inline unsigned popcount_word(word x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<unsigned>((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// ctz_word: index of the lowest set bit, x must not be zero.
+inline unsigned ctz_word(word x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    unsigned n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+inline std::size_t
+popcount_scalar(const word* w, std::size_t n, std::size_t i = 0)
+{
+    std::size_t total = 0;
+    for (; i < n; ++i) {
+        total += popcount_word(w[i]);
+    }
+    return total;
+}
+
+#ifdef FT_SIMD_X86
+__attribute__((target("popcnt")))
+inline std::size_t
+popcount_popcnt(const word* w, std::size_t n)
+{
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        total += __builtin_popcountll(w[i]);
+    }
+    return total;
+}
+
+// Nibble lookup with pshufb, the byte counts summed by psadbw.
+__attribute__((target("avx2")))
+inline std::size_t
+popcount_avx2(const word* w, std::size_t n)
+{
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0F);
+    __m256i       acc = _mm256_setzero_si256();
+    std::size_t   i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+        __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low));
+        __m256i hi = _mm256_shuffle_epi8(lookup,
+                         _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi),
+                                                    _mm256_setzero_si256()));
+    }
+    word lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return static_cast<std::size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3])
+         + popcount_scalar(w, n, i);
+}
+
+inline bool cpu_has_popcnt()
+{
+    static const bool has = (__builtin_cpu_init(),
+                             __builtin_cpu_supports("popcnt") != 0);
+    return has;
+}
+#endif
+
+inline std::size_t
+popcount(const word* w, std::size_t n)
+{
+#ifdef FT_SIMD_X86
+    if (n >= 16 && cpu_has_avx2()) {
+        return popcount_avx2(w, n);
+    }
+    if (cpu_has_popcnt()) {
+        return popcount_popcnt(w, n);
+    }
+#endif
+    return popcount_scalar(w, n);
+}
+
+// bitwise: dst[i] = dst[i] op src[i] for the words [0, n).
+
+enum bit_op { bit_and, bit_or, bit_xor };
+
+inline void
+bitwise_scalar(bit_op op, word* dst, const word* src, std::size_t n, std::size_t i = 0)
+{
+    switch (op) {
+    case bit_and: for (; i < n; ++i) { dst[i] &= src[i]; } break;
+    case bit_or:  for (; i < n; ++i) { dst[i] |= src[i]; } break;
+    case bit_xor: for (; i < n; ++i) { dst[i] ^= src[i]; } break;
+    }
+}
+
+#if defined(FT_SIMD_X86) && defined(__SSE2__)
+inline void
+bitwise_sse2(bit_op op, word* dst, const word* src, std::size_t n)
+{
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        x = op == bit_and ? _mm_and_si128(x, y)
+          : op == bit_or  ? _mm_or_si128(x, y)
+          :                 _mm_xor_si128(x, y);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), x);
+    }
+    bitwise_scalar(op, dst, src, n, i);
+}
+#endif
+
+#ifdef FT_SIMD_X86
+__attribute__((target("avx2")))
+inline void
+bitwise_avx2(bit_op op, word* dst, const word* src, std::size_t n)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        x = op == bit_and ? _mm256_and_si256(x, y)
+          : op == bit_or  ? _mm256_or_si256(x, y)
+          :                 _mm256_xor_si256(x, y);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), x);
+    }
+    bitwise_scalar(op, dst, src, n, i);
+}
+#endif
+
+inline void
+bitwise(bit_op op, word* dst, const word* src, std::size_t n)
+{
+#ifdef FT_SIMD_X86
+    if (n >= 8 && cpu_has_avx2()) {
+        bitwise_avx2(op, dst, src, n);
+        return;
+    }
+#endif
+#if defined(FT_SIMD_X86) && defined(__SSE2__)
+    bitwise_sse2(op, dst, src, n);
+#else
+    bitwise_scalar(op, dst, src, n);
+#endif
+}
+
+}; // namespace simd
+}; // namespace ft
+
+#endif // SIMD_H
@@ -0,0 +1,648 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <memory>
+#include <cstring>
+#include <stdexcept>
+
+#include "iterator.hpp"
+#include "utility.hpp"
+
+namespace ft {
+
+// A vector that keeps up to N elements inside the object itself and only
+// calls the allocator once it grows past them.
+template <class T, std::size_t N, class Allocator = std::allocator<T> >
+class small_vector
+{
+public:
+
+// Member types
+    typedef T                                        value_type;
+    typedef Allocator                                allocator_type;
+    typedef typename allocator_type::reference       reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::pointer         pointer;
+    typedef typename allocator_type::const_pointer   const_pointer;
+    typedef ft::ra_iter<value_type>                  iterator;
+    typedef ft::ra_iter<const value_type>            const_iterator;
+    typedef ft::reverse_iterator<iterator>           reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator>     const_reverse_iterator;
+    typedef typename allocator_type::difference_type difference_type;
+    typedef std::size_t                              size_type;
+
+    static const size_type inline_capacity = N;
+
+// Constructors
+    explicit small_vector(const allocator_type& alloc = allocator_type());
+    explicit small_vector(size_type n, const value_type& val = value_type(),
+                          const allocator_type& alloc = allocator_type());
+    template <class InputIterator>
+             small_vector(InputIterator first, InputIterator last,
+                          const allocator_type& alloc = allocator_type(),
+                          typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type = 0);
+             small_vector(const small_vector& x);
+#ifdef FT_CXX11
+             small_vector(small_vector&& x);
+#endif
+
+    ~small_vector();
+
+    small_vector& operator=(const small_vector& x);
+#ifdef FT_CXX11
+    small_vector& operator=(small_vector&& x);
+#endif
+
+// Iterators
+    iterator               begin()        { return iterator(begin_);                }
+    const_iterator         begin() const  { return const_iterator(begin_);          }
+    iterator               end()          { return iterator(begin_ + size_);        }
+    const_iterator         end() const    { return const_iterator(begin_ + size_);  }
+    reverse_iterator       rbegin()       { return reverse_iterator(end());         }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end());   }
+    reverse_iterator       rend()         { return reverse_iterator(begin());       }
+    const_reverse_iterator rend() const   { return const_reverse_iterator(begin()); }
+
+// Capacity
+    size_type size() const      { return size_; }
+    size_type max_size() const  { return alloc_.max_size(); }
+    void      resize(size_type n, value_type val = value_type());
+    size_type capacity() const  { return capacity_; }
+    bool      empty() const     { return !size_; }
+    void      reserve(size_type n);
+    bool      is_inline() const { return begin_ == inline_begin_(); }
+
+// Element access
+    reference       operator[](size_type n)       { return begin_[n]; }
+    const_reference operator[](size_type n) const { return begin_[n]; }
+    reference       at(size_type n);
+    const_reference at(size_type n) const;
+    reference       front()       { return *begin_; }
+    const_reference front() const { return *begin_; }
+    reference       back()        { return begin_[size_-1]; }
+    const_reference back() const  { return begin_[size_-1]; }
+    pointer         data()        { return begin_; }
+    const_pointer   data() const  { return begin_; }
+
+// Modifiers
+    template <class InputIterator>
+    void     assign(InputIterator first, InputIterator last,
+                    typename ft::enable_if<
+                    !ft::is_integral<InputIterator>::value, bool>::type = 0);
+    void     assign(size_type n, const value_type& val);
+    void     push_back(const value_type& val);
+    void     pop_back();
+    iterator insert(iterator position, const value_type& val);
+    void     insert(iterator position, size_type n, const value_type& val);
+    template <class InputIterator>
+    void     insert(iterator position, InputIterator first, InputIterator last,
+                    typename ft::enable_if<
+                    !ft::is_integral<InputIterator>::value, bool>::type = 0);
+#ifdef FT_CXX11
+    void     push_back(value_type&& val) { emplace_back(std::move(val)); }
+    template <class... Args>
+    void     emplace_back(Args&&... args);
+#endif
+    iterator erase (iterator position);
+    iterator erase (iterator first, iterator last);
+    void     swap  (small_vector& x);
+    void     clear();
+
+// Allocator
+    allocator_type get_allocator() const { return alloc_; }
+
+private:
+    union storage_type_
+    {
+        char        bytes[N ? N * sizeof(T) : 1]
+#if defined(__GNUC__) || defined(__clang__)
+                    __attribute__((aligned(__alignof__(T))))
+#endif
+                    ;
+        long double align_ld_;
+        void*       align_p_;
+    };
+
+    allocator_type alloc_;
+    pointer        begin_;
+    size_type      size_;
+    size_type      capacity_;
+    storage_type_  storage_;
+
+    typedef ft::is_trivially_relocatable<value_type> relocatable_;
+
+    pointer inline_begin_() const
+    { return reinterpret_cast<pointer>(const_cast<char*>(storage_.bytes)); }
+
+    size_type next_capacity_(size_type n) const;
+
+    template <class InputIterator>
+    void    range_insert_(iterator position, InputIterator first,
+                          InputIterator last, ft::input_iterator_tag);
+    template <class ForwardIterator>
+    void    range_insert_(iterator position, ForwardIterator first,
+                          ForwardIterator last, ft::forward_iterator_tag);
+    void    steal_(small_vector& x);
+    void    move_(pointer dst, pointer src, difference_type len);
+    void    relocate_(pointer dst, pointer src, size_type len);
+    void    close_gap_(pointer pos, size_type built, size_type gap, size_type len);
+    void    destroy_();
+};
+
+template <class T, std::size_t N, class Allocator>
+const typename small_vector<T, N, Allocator>::size_type
+small_vector<T, N, Allocator>::inline_capacity;
+
+/***** Constructors *****/
+
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>::small_vector(const allocator_type& alloc)
+    : alloc_(alloc)
+    , begin_(inline_begin_())
+    , size_(0)
+    , capacity_(N)
+{
+}
+
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>::small_vector(size_type n, const value_type& val,
+                                            const allocator_type& alloc)
+    : alloc_(alloc)
+    , begin_(inline_begin_())
+    , size_(0)
+    , capacity_(N)
+{
+    try {
+        insert(end(), n, val);
+    }
+    catch (...) {
+        destroy_();
+        throw;
+    }
+}
+
+template <class T, std::size_t N, class Allocator>
+    template <class InputIterator>
+small_vector<T, N, Allocator>::small_vector(InputIterator first, InputIterator last,
+const allocator_type& alloc,
+typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type)
+    : alloc_(alloc)
+    , begin_(inline_begin_())
+    , size_(0)
+    , capacity_(N)
+{
+    try {
+        insert(end(), first, last);
+    }
+    catch (...) {
+        destroy_();
+        throw;
+    }
+}
+
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>::small_vector(const small_vector& x)
+    : alloc_(x.alloc_)
+    , begin_(inline_begin_())
+    , size_(0)
+    , capacity_(N)
+{
+    try {
+        *this = x;
+    }
+    catch (...) {
+        destroy_();
+        throw;
+    }
+}
+
+#ifdef FT_CXX11
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>::small_vector(small_vector&& x)
+    : alloc_(x.alloc_)
+    , begin_(inline_begin_())
+    , size_(0)
+    , capacity_(N)
+{
+    steal_(x);
+}
+#endif
+
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>::~small_vector()
+{
+    destroy_();
+}
+
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>&
+small_vector<T, N, Allocator>::operator=(const small_vector& other)
+{
+    if (this == &other)
+        return *this;
+    clear();
+    reserve(other.size_);
+    while (size_ < other.size_) {
+        alloc_.construct(begin_ + size_, other[size_]);
+        ++size_;
+    }
+    return *this;
+}
+
+#ifdef FT_CXX11
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>&
+small_vector<T, N, Allocator>::operator=(small_vector&& other)
+{
+    if (this == &other)
+        return *this;
+    destroy_();
+    steal_(other);
+    return *this;
+}
+#endif
+
+/***** Capacity *****/
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::resize(size_type n, value_type val)
+{
+    while (n < size_) {
+        alloc_.destroy(begin_ + --size_);
+    }
+    reserve(n);
+    while (size_ < n) {
+        alloc_.construct(begin_ + size_++, val);
+    }
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::reserve(size_type n)
+{
+    if (n <= capacity_) {
+        return;
+    }
+    size_type new_cap = next_capacity_(n);
+    pointer   new_begin = alloc_.allocate(new_cap);
+    relocate_(new_begin, begin_, size_);
+    if (!is_inline()) {
+        alloc_.deallocate(begin_, capacity_);
+    }
+    begin_ = new_begin;
+    capacity_ = new_cap;
+}
+
+/***** Element access *****/
+
+template <class T, std::size_t N, class Allocator>
+typename small_vector<T, N, Allocator>::reference
+small_vector<T, N, Allocator>::at(size_type n)
+{
+    if (n >= size_)
+        throw std::out_of_range("small_vector");
+    return begin_[n];
+}
+
+template <class T, std::size_t N, class Allocator>
+typename small_vector<T, N, Allocator>::const_reference
+small_vector<T, N, Allocator>::at(size_type n) const
+{
+    if (n >= size_)
+        throw std::out_of_range("small_vector");
+    return begin_[n];
+}
+
+/***** Modifiers *****/
+
+template <class T, std::size_t N, class Allocator>
+    template <class InputIterator>
+void small_vector<T, N, Allocator>::assign(InputIterator first, InputIterator last,
+typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type)
+{
+    clear();
+    insert(end(), first, last);
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::assign(size_type n, const value_type& val)
+{
+    value_type copy(val);
+    clear();
+    insert(end(), n, copy);
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::push_back(const value_type& val)
+{
+    if (size_ == capacity_) {
+        value_type copy(val);
+        reserve(size_ + 1);
+        alloc_.construct(begin_ + size_++, copy);
+        return;
+    }
+    alloc_.construct(begin_ + size_++, val);
+}
+
+#ifdef FT_CXX11
+template <class T, std::size_t N, class Allocator>
+    template <class... Args>
+void small_vector<T, N, Allocator>::emplace_back(Args&&... args)
+{
+    if (size_ == capacity_) {
+        value_type tmp(std::forward<Args>(args)...);
+        reserve(size_ + 1);
+        alloc_.construct(begin_ + size_++, std::move(tmp));
+        return;
+    }
+    alloc_.construct(begin_ + size_, std::forward<Args>(args)...);
+    ++size_;
+}
+#endif
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::pop_back()
+{
+    if (size_) {
+        alloc_.destroy(begin_ + --size_);
+    }
+}
+
+template <class T, std::size_t N, class Allocator>
+typename small_vector<T, N, Allocator>::iterator
+small_vector<T, N, Allocator>::insert(iterator position, const value_type& val)
+{
+    difference_type shift = position - begin();
+
+    insert(position, 1, val);
+    return begin() + shift;
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::insert(iterator position, size_type n,
+                                           const value_type& val)
+{
+    difference_type shift = position - begin();
+
+    if (!n) {
+        return;
+    }
+    value_type copy(val);
+    reserve(size_ + n);
+    pointer pos = begin_ + shift;
+    move_(pos + n, pos, size_ - shift);
+    size_type i = 0;
+    try {
+        for (; i < n; ++i) {
+            alloc_.construct(pos + i, copy);
+        }
+    }
+    catch (...) {
+        close_gap_(pos, i, n, size_ - shift);
+        throw;
+    }
+    size_ += n;
+}
+
+template <class T, std::size_t N, class Allocator>
+    template <class InputIterator>
+void small_vector<T, N, Allocator>::insert(iterator position,
+InputIterator first, InputIterator last,
+typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type)
+{
+    range_insert_(position, first, last, ft::iterator_category(first));
+}
+
+template <class T, std::size_t N, class Allocator>
+typename small_vector<T, N, Allocator>::iterator
+small_vector<T, N, Allocator>::erase(iterator position)
+{
+    return erase(position, position + 1);
+}
+
+template <class T, std::size_t N, class Allocator>
+typename small_vector<T, N, Allocator>::iterator
+small_vector<T, N, Allocator>::erase(iterator first, iterator last)
+{
+    difference_type n = last - first;
+
+    if (n <= 0) {
+        return first;
+    }
+    for (iterator it = first; it != last; ++it) {
+        alloc_.destroy(&*it);
+    }
+    move_(&*first, &*last, end() - last);
+    size_ -= n;
+    return first;
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::swap(small_vector& x)
+{
+    if (this == &x) {
+        return;
+    }
+    if (!is_inline() && !x.is_inline()) {
+        ft::swap(begin_, x.begin_);
+        ft::swap(size_, x.size_);
+        ft::swap(capacity_, x.capacity_);
+        return;
+    }
+    if (is_inline() && x.is_inline()) {
+        small_vector& shorter = size_ < x.size_ ? *this : x;
+        small_vector& longer  = size_ < x.size_ ? x : *this;
+        for (size_type i = 0; i < shorter.size_; ++i) {
+            ft::swap(shorter.begin_[i], longer.begin_[i]);
+        }
+        relocate_(shorter.begin_ + shorter.size_, longer.begin_ + shorter.size_,
+                  longer.size_ - shorter.size_);
+        ft::swap(size_, x.size_);
+        return;
+    }
+    small_vector& local = is_inline() ? *this : x;
+    small_vector& heap  = is_inline() ? x : *this;
+    pointer   heap_begin = heap.begin_;
+    size_type heap_cap = heap.capacity_;
+
+    heap.begin_ = heap.inline_begin_();
+    heap.capacity_ = N;
+    relocate_(heap.begin_, local.begin_, local.size_);
+    local.begin_ = heap_begin;
+    local.capacity_ = heap_cap;
+    ft::swap(size_, x.size_);
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::clear()
+{
+    while (size_ > 0) {
+        alloc_.destroy(begin_ + --size_);
+    }
+}
+
+/***** Non-member function overloads *****/
+
+template <class T, std::size_t N, class Alloc>
+inline bool operator==(const small_vector<T,N,Alloc>& lhs,
+                       const small_vector<T,N,Alloc>& rhs)
+{
+    return lhs.size() == rhs.size()
+        && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, std::size_t N, class Alloc>
+inline bool operator!=(const small_vector<T,N,Alloc>& lhs,
+                       const small_vector<T,N,Alloc>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class T, std::size_t N, class Alloc>
+inline bool operator< (const small_vector<T,N,Alloc>& lhs,
+                       const small_vector<T,N,Alloc>& rhs)
+{
+    return ft::lexicographical_compare(lhs.begin(), lhs.end(),
+                                       rhs.begin(), rhs.end());
+}
+
+template <class T, std::size_t N, class Alloc>
+inline bool operator<=(const small_vector<T,N,Alloc>& lhs,
+                       const small_vector<T,N,Alloc>& rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <class T, std::size_t N, class Alloc>
+inline bool operator> (const small_vector<T,N,Alloc>& lhs,
+                       const small_vector<T,N,Alloc>& rhs)
+{
+    return rhs < lhs;
+}
+
+template <class T, std::size_t N, class Alloc>
+inline bool operator>=(const small_vector<T,N,Alloc>& lhs,
+                       const small_vector<T,N,Alloc>& rhs)
+{
+    return !(lhs < rhs);
+}
+
+template <class T, std::size_t N, class Alloc>
+inline void swap(small_vector<T,N,Alloc>& x, small_vector<T,N,Alloc>& y)
+{
+    x.swap(y);
+}
+
+/***** private *****/
+
+// Single pass ranges are appended in place at the end. Anywhere else they
+// are read into a temporary first, the gap needs their length.
+template <class T, std::size_t N, class Allocator>
+    template <class InputIterator>
+void small_vector<T, N, Allocator>::range_insert_(iterator position,
+            InputIterator first, InputIterator last, ft::input_iterator_tag)
+{
+    if (position == end()) {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+        return;
+    }
+    small_vector tmp(first, last, alloc_);
+    range_insert_(position, tmp.begin(), tmp.end(), ft::random_access_iterator_tag());
+}
+
+template <class T, std::size_t N, class Allocator>
+    template <class ForwardIterator>
+void small_vector<T, N, Allocator>::range_insert_(iterator position,
+        ForwardIterator first, ForwardIterator last, ft::forward_iterator_tag)
+{
+    difference_type shift = position - begin();
+    difference_type n = ft::distance(first, last);
+
+    if (n <= 0) {
+        return;
+    }
+    reserve(size_ + n);
+    pointer pos = begin_ + shift;
+    move_(pos + n, pos, size_ - shift);
+    size_type i = 0;
+    try {
+        for (; first != last; ++first, ++i) {
+            alloc_.construct(pos + i, *first);
+        }
+    }
+    catch (...) {
+        close_gap_(pos, i, n, size_ - shift);
+        throw;
+    }
+    size_ += n;
+}
+
+template <class T, std::size_t N, class Allocator>
+inline typename small_vector<T, N, Allocator>::size_type
+small_vector<T, N, Allocator>::next_capacity_(size_type n) const
+{
+    if (capacity_ && n < capacity_ << 1)
+        return capacity_ << 1;
+    return n;
+}
+
+// Takes over the contents of x, which must not own anything yet on this
+// side: heap buffers change hands, inline elements are relocated.
+template <class T, std::size_t N, class Allocator>
+inline void small_vector<T, N, Allocator>::steal_(small_vector& x)
+{
+    if (x.is_inline()) {
+        begin_ = inline_begin_();
+        capacity_ = N;
+        relocate_(begin_, x.begin_, x.size_);
+    } else {
+        begin_ = x.begin_;
+        capacity_ = x.capacity_;
+        x.begin_ = x.inline_begin_();
+        x.capacity_ = N;
+    }
+    size_ = x.size_;
+    x.size_ = 0;
+}
+
+// Undoes an insert that threw: destroys the built elements of the gap at
+// pos and moves the tail of len elements back over it.
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::close_gap_(pointer pos, size_type built,
+                                               size_type gap, size_type len)
+{
+    while (built) {
+        alloc_.destroy(pos + --built);
+    }
+    move_(pos, pos + gap, len);
+}
+
+// Shifts [src, src + len) to dst, the ranges may overlap.
+template <class T, std::size_t N, class Allocator>
+inline void small_vector<T, N, Allocator>::move_(pointer dst, pointer src, difference_type len)
+{
+    ft::shift_elements(alloc_, dst, src, len);
+}
+
+// Moves [src, src + len) into fresh storage that does not overlap it.
+template <class T, std::size_t N, class Allocator>
+inline void small_vector<T, N, Allocator>::relocate_(pointer dst, pointer src, size_type len)
+{
+    ft::relocate_elements(alloc_, dst, src, len);
+}
+
+template <class T, std::size_t N, class Allocator>
+inline void small_vector<T, N, Allocator>::destroy_()
+{
+    clear();
+    if (!is_inline()) {
+        alloc_.deallocate(begin_, capacity_);
+    }
+    begin_ = inline_begin_();
+    capacity_ = N;
+}
+
+}; // namespace ft
+
+#endif // SMALL_VECTOR_H
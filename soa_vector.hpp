@@ -0,0 +1,568 @@
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include "utility.hpp"
+
+// Structure-of-arrays vector. C++11 only: the fields are a template
+// parameter pack.
+#ifdef FT_CXX11
+
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+
+#include "allocator.hpp"
+#include "iterator.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+template <std::size_t... I> struct index_list { };
+
+template <std::size_t N, std::size_t... I>
+struct make_index_list : public make_index_list<N - 1, N - 1, I...> { };
+
+template <std::size_t... I>
+struct make_index_list<0, I...> { typedef index_list<I...> type; };
+
+// A column of a soa_vector, contiguous and aligned to a cache line so SIMD
+// loops can start with aligned loads.
+template <class T>
+class column_span
+{
+public:
+    typedef T           value_type;
+    typedef T*          iterator;
+    typedef std::size_t size_type;
+
+    column_span(T* data, size_type size) : data_(data), size_(size) {}
+
+    T*        data() const                   { return data_;         }
+    size_type size() const                   { return size_;         }
+    bool      empty() const                  { return !size_;        }
+    T*        begin() const                  { return data_;         }
+    T*        end() const                    { return data_ + size_; }
+    T&        operator[](size_type i) const  { return data_[i];      }
+
+private:
+    T*        data_;
+    size_type size_;
+};
+
+// Reference to the row of a soa_vector: assigning to it writes the fields
+// into the columns, it converts to the row tuple. Vec is const for the
+// const_reference.
+template <class Vec>
+class soa_reference
+{
+public:
+    typedef typename remove_const<Vec>::type::value_type value_type;
+
+    soa_reference(Vec* vec, std::size_t i) : vec_(vec), i_(i) {}
+
+    template <std::size_t I>
+    auto get() const -> decltype(std::declval<Vec&>().template get<I>(0))
+    { return vec_->template get<I>(i_); }
+
+    operator value_type() const
+    { return to_tuple_(typename make_index_list<std::tuple_size<value_type>::value>::type()); }
+
+    // assigns the fields, the reference still names the same row
+    const soa_reference& operator=(const soa_reference& other) const
+    { return *this = value_type(other); }
+
+    template <class Other>
+    const soa_reference& operator=(const soa_reference<Other>& other) const
+    { return *this = value_type(other); }
+
+    const soa_reference& operator=(const value_type& val) const
+    {
+        assign_(val, typename make_index_list<std::tuple_size<value_type>::value>::type());
+        return *this;
+    }
+
+    // the fields as a tuple of references, for comparisons
+    template <std::size_t... I>
+    auto tie(index_list<I...>) const -> decltype(std::tie(this->template get<I>()...))
+    { return std::tie(get<I>()...); }
+
+private:
+    template <std::size_t... I>
+    value_type to_tuple_(index_list<I...>) const
+    { return value_type(get<I>()...); }
+
+    template <std::size_t... I>
+    void assign_(const value_type& val, index_list<I...>) const
+    {
+        int expand[] = { 0, (get<I>() = std::get<I>(val), 0)... };
+        (void)expand;
+    }
+
+    Vec*        vec_;
+    std::size_t i_;
+};
+
+template <class V1, class V2>
+inline bool operator==(const soa_reference<V1>& a, const soa_reference<V2>& b)
+{
+    typedef typename make_index_list<std::tuple_size<
+        typename soa_reference<V1>::value_type>::value>::type indices;
+    return a.tie(indices()) == b.tie(indices());
+}
+
+template <class V1, class V2>
+inline bool operator!=(const soa_reference<V1>& a, const soa_reference<V2>& b)
+{ return !(a == b); }
+
+template <class V1, class V2>
+inline bool operator<(const soa_reference<V1>& a, const soa_reference<V2>& b)
+{
+    typedef typename make_index_list<std::tuple_size<
+        typename soa_reference<V1>::value_type>::value>::type indices;
+    return a.tie(indices()) < b.tie(indices());
+}
+
+template <class V1, class V2>
+inline bool operator> (const soa_reference<V1>& a, const soa_reference<V2>& b)
+{ return b < a; }
+template <class V1, class V2>
+inline bool operator<=(const soa_reference<V1>& a, const soa_reference<V2>& b)
+{ return !(b < a); }
+template <class V1, class V2>
+inline bool operator>=(const soa_reference<V1>& a, const soa_reference<V2>& b)
+{ return !(a < b); }
+
+// rows against row tuples, for algorithms that hold a row aside
+template <class Vec>
+inline bool operator==(const soa_reference<Vec>& a,
+                       const typename soa_reference<Vec>::value_type& b)
+{ return typename soa_reference<Vec>::value_type(a) == b; }
+
+template <class Vec>
+inline bool operator==(const typename soa_reference<Vec>::value_type& a,
+                       const soa_reference<Vec>& b)
+{ return b == a; }
+
+template <class Vec>
+inline bool operator<(const soa_reference<Vec>& a,
+                      const typename soa_reference<Vec>::value_type& b)
+{ return typename soa_reference<Vec>::value_type(a) < b; }
+
+template <class Vec>
+inline bool operator<(const typename soa_reference<Vec>::value_type& a,
+                      const soa_reference<Vec>& b)
+{ return a < typename soa_reference<Vec>::value_type(b); }
+
+// Swaps the rows, not the references; lets std algorithms permute rows.
+template <class Vec>
+inline void swap(const soa_reference<Vec>& a, const soa_reference<Vec>& b)
+{
+    typename soa_reference<Vec>::value_type tmp = a;
+    a = b;
+    b = tmp;
+}
+
+// Random access iterator over the rows of a soa_vector, dereferencing to a
+// soa_reference. It has no operator->: there is no row object to point to.
+template <class Vec>
+class soa_iterator : public iterator<random_access_iterator_tag,
+                                     typename remove_const<Vec>::type::value_type,
+                                     std::ptrdiff_t, void,
+                                     soa_reference<Vec> >
+{
+public:
+    typedef soa_iterator                                   iterator_type;
+    typedef random_access_iterator_tag                     iterator_category;
+    typedef typename remove_const<Vec>::type::value_type   value_type;
+    typedef std::ptrdiff_t                                 difference_type;
+    typedef void                                           pointer;
+    typedef void                                           const_pointer;
+    typedef soa_reference<Vec>                             reference;
+    typedef soa_reference<Vec>                             const_reference;
+
+    soa_iterator() : vec_(NULL), i_(0) {}
+    soa_iterator(Vec* vec, difference_type i) : vec_(vec), i_(i) {}
+    template <class Other>
+    soa_iterator(const soa_iterator<Other>& other,
+                 typename enable_if<is_same<const Other, Vec>::value, bool>::type = 0)
+        : vec_(other.container()), i_(other.index()) {}
+
+    Vec*            container() const { return vec_; }
+    difference_type index() const     { return i_;   }
+
+// Dereference
+    reference operator*() const                   { return reference(vec_, i_);     }
+    reference operator[](difference_type n) const { return reference(vec_, i_ + n); }
+
+// Increment/decrement
+    soa_iterator& operator++()    {                      ++i_; return *this; }
+    soa_iterator& operator--()    {                      --i_; return *this; }
+    soa_iterator  operator++(int) { soa_iterator tmp(*this); ++i_; return tmp; }
+    soa_iterator  operator--(int) { soa_iterator tmp(*this); --i_; return tmp; }
+
+// Arithmetic
+    soa_iterator& operator+=(difference_type n)      { i_ += n; return *this; }
+    soa_iterator& operator-=(difference_type n)      { i_ -= n; return *this; }
+    soa_iterator  operator+(difference_type n) const { return soa_iterator(vec_, i_ + n); }
+    soa_iterator  operator-(difference_type n) const { return soa_iterator(vec_, i_ - n); }
+
+    friend soa_iterator operator+(difference_type n, const soa_iterator& it)
+    { return it + n; }
+
+// Comparison
+    template <class Other>
+    difference_type operator-(const soa_iterator<Other>& other) const
+    { return i_ - other.index(); }
+    template <class Other>
+    bool operator==(const soa_iterator<Other>& other) const { return i_ == other.index(); }
+    template <class Other>
+    bool operator!=(const soa_iterator<Other>& other) const { return i_ != other.index(); }
+    template <class Other>
+    bool operator< (const soa_iterator<Other>& other) const { return i_ <  other.index(); }
+    template <class Other>
+    bool operator> (const soa_iterator<Other>& other) const { return i_ >  other.index(); }
+    template <class Other>
+    bool operator<=(const soa_iterator<Other>& other) const { return i_ <= other.index(); }
+    template <class Other>
+    bool operator>=(const soa_iterator<Other>& other) const { return i_ >= other.index(); }
+
+private:
+    Vec*            vec_;
+    difference_type i_;
+};
+
+// Keeps every field of Fields... in its own contiguous column, so a scan
+// over one field reads only that field's bytes. Rows are std::tuple values;
+// single fields are reached with get<I>(row) or through column<I>().
+template <class... Fields>
+class soa_vector
+{
+public:
+
+// Member types
+    typedef std::tuple<Fields...>                        value_type;
+    typedef soa_reference<soa_vector>                    reference;
+    typedef soa_reference<const soa_vector>              const_reference;
+    typedef soa_iterator<soa_vector>                     iterator;
+    typedef soa_iterator<const soa_vector>               const_iterator;
+    typedef ft::reverse_iterator<iterator>               reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator>         const_reverse_iterator;
+    typedef std::ptrdiff_t                               difference_type;
+    typedef std::size_t                                  size_type;
+
+    template <std::size_t I>
+    struct field { typedef typename std::tuple_element<I, value_type>::type type; };
+
+    static const size_type field_count = sizeof...(Fields);
+
+// Constructors
+    soa_vector() {}
+    explicit soa_vector(size_type n, const value_type& val = value_type())
+    { resize(n, val); }
+
+// Iterators
+    iterator               begin()        { return iterator(this, 0);                 }
+    const_iterator         begin() const  { return const_iterator(this, 0);           }
+    iterator               end()          { return iterator(this, size());            }
+    const_iterator         end() const    { return const_iterator(this, size());      }
+    reverse_iterator       rbegin()       { return reverse_iterator(end());           }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end());     }
+    reverse_iterator       rend()         { return reverse_iterator(begin());         }
+    const_reverse_iterator rend() const   { return const_reverse_iterator(begin());   }
+
+// Capacity
+    size_type size() const     { return std::get<0>(columns_).size(); }
+    bool      empty() const    { return !size();                      }
+    size_type capacity() const { return capacity_(indices());         }
+    void      reserve(size_type n);
+    void      shrink_to_fit();
+    void      resize(size_type n, const value_type& val = value_type());
+
+// Element access
+    reference       operator[](size_type i)       { return reference(this, i);       }
+    const_reference operator[](size_type i) const { return const_reference(this, i); }
+    reference       at(size_type i);
+    const_reference at(size_type i) const;
+    reference       front()                       { return (*this)[0];               }
+    const_reference front() const                 { return (*this)[0];               }
+    reference       back()                        { return (*this)[size() - 1];      }
+    const_reference back() const                  { return (*this)[size() - 1];      }
+
+    template <std::size_t I>
+    typename field<I>::type&       get(size_type i)       { return std::get<I>(columns_)[i]; }
+    template <std::size_t I>
+    const typename field<I>::type& get(size_type i) const { return std::get<I>(columns_)[i]; }
+
+    // The whole column of field I; invalidated like iterators.
+    template <std::size_t I>
+    column_span<typename field<I>::type> column()
+    {
+        return column_span<typename field<I>::type>(
+            size() ? &std::get<I>(columns_)[0] : NULL, size());
+    }
+    template <std::size_t I>
+    column_span<const typename field<I>::type> column() const
+    {
+        return column_span<const typename field<I>::type>(
+            size() ? &std::get<I>(columns_)[0] : NULL, size());
+    }
+
+// Modifiers
+    void     push_back(const value_type& val)    { insert_(size(), val, indices());  }
+    void     push_back(const Fields&... fields)  { push_back(value_type(fields...)); }
+    void     pop_back()                          { pop_back_(indices());             }
+    iterator insert(const_iterator pos, const value_type& val);
+    iterator erase(const_iterator pos)           { return erase(pos, pos + 1);       }
+    iterator erase(const_iterator first, const_iterator last);
+    void     swap(soa_vector& x)                 { swap_(x, indices());              }
+    void     clear()                             { clear_(indices());                }
+
+private:
+    typedef typename make_index_list<sizeof...(Fields)>::type indices;
+
+    template <class F>
+    struct column_ { typedef ft::vector<F, ft::aligned_allocator<F> > type; };
+
+    template <std::size_t... I>
+    size_type capacity_(index_list<I...>) const;
+    template <std::size_t... I>
+    void      reserve_(size_type n, index_list<I...>);
+    template <std::size_t... I>
+    void      resize_(size_type n, const value_type& val, index_list<I...>);
+    template <std::size_t... I>
+    void      insert_(size_type pos, const value_type& val, index_list<I...>);
+    template <std::size_t... I>
+    void      erase_(size_type first, size_type last, size_type count, index_list<I...>);
+    template <std::size_t... I>
+    void      pop_back_(index_list<I...>);
+    template <std::size_t... I>
+    void      clear_(index_list<I...>);
+    template <std::size_t... I>
+    void      shrink_to_fit_(index_list<I...>);
+    template <std::size_t... I>
+    void      swap_(soa_vector& x, index_list<I...>);
+
+    std::tuple<typename column_<Fields>::type...> columns_;
+};
+
+template <class... Fields>
+const typename soa_vector<Fields...>::size_type soa_vector<Fields...>::field_count;
+
+/***** Capacity *****/
+
+template <class... Fields>
+void soa_vector<Fields...>::reserve(size_type n)
+{
+    reserve_(n, indices());
+}
+
+template <class... Fields>
+void soa_vector<Fields...>::shrink_to_fit()
+{
+    shrink_to_fit_(indices());
+}
+
+template <class... Fields>
+void soa_vector<Fields...>::resize(size_type n, const value_type& val)
+{
+    resize_(n, val, indices());
+}
+
+/***** Element access *****/
+
+template <class... Fields>
+typename soa_vector<Fields...>::reference soa_vector<Fields...>::at(size_type i)
+{
+    if (i >= size()) {
+        throw std::out_of_range("soa_vector");
+    }
+    return (*this)[i];
+}
+
+template <class... Fields>
+typename soa_vector<Fields...>::const_reference soa_vector<Fields...>::at(size_type i) const
+{
+    if (i >= size()) {
+        throw std::out_of_range("soa_vector");
+    }
+    return (*this)[i];
+}
+
+/***** Modifiers *****/
+
+template <class... Fields>
+typename soa_vector<Fields...>::iterator
+soa_vector<Fields...>::insert(const_iterator pos, const value_type& val)
+{
+    size_type i = pos.index();
+    insert_(i, val, indices());
+    return iterator(this, i);
+}
+
+template <class... Fields>
+typename soa_vector<Fields...>::iterator
+soa_vector<Fields...>::erase(const_iterator first, const_iterator last)
+{
+    size_type i = first.index();
+    erase_(i, last.index(), field_count, indices());
+    return iterator(this, i);
+}
+
+/***** Per column helpers *****/
+// Each expands to one statement per column; an index list in a braced
+// initializer is evaluated left to right.
+
+template <class... Fields>
+    template <std::size_t... I>
+typename soa_vector<Fields...>::size_type
+soa_vector<Fields...>::capacity_(index_list<I...>) const
+{
+    size_type caps[] = { std::get<I>(columns_).capacity()... };
+    size_type cap = caps[0];
+    for (size_type i = 1; i < field_count; ++i) {
+        cap = caps[i] < cap ? caps[i] : cap;
+    }
+    return cap;
+}
+
+template <class... Fields>
+    template <std::size_t... I>
+void soa_vector<Fields...>::reserve_(size_type n, index_list<I...>)
+{
+    int expand[] = { 0, (std::get<I>(columns_).reserve(n), 0)... };
+    (void)expand;
+}
+
+template <class... Fields>
+    template <std::size_t... I>
+void soa_vector<Fields...>::shrink_to_fit_(index_list<I...>)
+{
+    int expand[] = { 0, (std::get<I>(columns_).shrink_to_fit(), 0)... };
+    (void)expand;
+}
+
+// A column that throws leaves the columns before it resized; they are put
+// back to the old size so all columns keep the same length.
+template <class... Fields>
+    template <std::size_t... I>
+void soa_vector<Fields...>::resize_(size_type n, const value_type& val,
+                                    index_list<I...>)
+{
+    const size_type old_size = size();
+    size_type       done = 0;
+    try {
+        int expand[] = { 0, (std::get<I>(columns_).resize(n, std::get<I>(val)),
+                             ++done, 0)... };
+        (void)expand;
+    }
+    catch (...) {
+        int expand[] = { 0, (I < done ? std::get<I>(columns_).resize(
+                                 old_size, std::get<I>(val)), 0 : 0)... };
+        (void)expand;
+        throw;
+    }
+}
+
+template <class... Fields>
+    template <std::size_t... I>
+void soa_vector<Fields...>::insert_(size_type pos, const value_type& val,
+                                    index_list<I...>)
+{
+    size_type done = 0;
+    try {
+        int expand[] = { 0, (std::get<I>(columns_).insert(
+                                 std::get<I>(columns_).begin() + pos, std::get<I>(val)),
+                             ++done, 0)... };
+        (void)expand;
+    }
+    catch (...) {
+        erase_(pos, pos + 1, done, indices());
+        throw;
+    }
+}
+
+// erases [first, last) from the first count columns
+template <class... Fields>
+    template <std::size_t... I>
+void soa_vector<Fields...>::erase_(size_type first, size_type last,
+                                   size_type count, index_list<I...>)
+{
+    int expand[] = { 0, (I < count ? (std::get<I>(columns_).erase(
+                             std::get<I>(columns_).begin() + first,
+                             std::get<I>(columns_).begin() + last), 0) : 0)... };
+    (void)expand;
+}
+
+template <class... Fields>
+    template <std::size_t... I>
+void soa_vector<Fields...>::pop_back_(index_list<I...>)
+{
+    int expand[] = { 0, (std::get<I>(columns_).pop_back(), 0)... };
+    (void)expand;
+}
+
+template <class... Fields>
+    template <std::size_t... I>
+void soa_vector<Fields...>::clear_(index_list<I...>)
+{
+    int expand[] = { 0, (std::get<I>(columns_).clear(), 0)... };
+    (void)expand;
+}
+
+template <class... Fields>
+    template <std::size_t... I>
+void soa_vector<Fields...>::swap_(soa_vector& x, index_list<I...>)
+{
+    int expand[] = { 0, (std::get<I>(columns_).swap(std::get<I>(x.columns_)), 0)... };
+    (void)expand;
+}
+
+/***** Non-member function overloads *****/
+
+template <class... Fields>
+inline void swap(soa_vector<Fields...>& x, soa_vector<Fields...>& y)
+{
+    x.swap(y);
+}
+
+template <class... Fields>
+inline bool operator==(const soa_vector<Fields...>& lhs, const soa_vector<Fields...>& rhs)
+{
+    return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class... Fields>
+inline bool operator!=(const soa_vector<Fields...>& lhs, const soa_vector<Fields...>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class... Fields>
+inline bool operator<(const soa_vector<Fields...>& lhs, const soa_vector<Fields...>& rhs)
+{
+    return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class... Fields>
+inline bool operator<=(const soa_vector<Fields...>& lhs, const soa_vector<Fields...>& rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <class... Fields>
+inline bool operator>(const soa_vector<Fields...>& lhs, const soa_vector<Fields...>& rhs)
+{
+    return rhs < lhs;
+}
+
+template <class... Fields>
+inline bool operator>=(const soa_vector<Fields...>& lhs, const soa_vector<Fields...>& rhs)
+{
+    return !(lhs < rhs);
+}
+
+}; // namespace ft
+
+#endif // FT_CXX11
+
+#endif // SOA_VECTOR_H
@@ -28,6 +28,11 @@ public:
 
     void      push(const value_type& val) { c.push_back(val); }
     void      pop()                       { c.pop_back(); }
+#ifdef FT_CXX11
+    void      push(value_type&& val)      { c.push_back(std::move(val)); }
+    template <class... Args>
+    void      emplace(Args&&... args)     { c.emplace_back(std::forward<Args>(args)...); }
+#endif
 
     // template <class T, class Container>
     friend bool operator==(const stack<T,Container>& lhs, const stack<T,Container>& rhs)
@@ -0,0 +1,140 @@
+#include "bench.h"
+#include "../allocator.hpp"
+#include "../map.hpp"
+#include "../vector.hpp"
+
+#include <cstdio>
+#include <string>
+
+namespace
+{
+
+/// Sum of `reads` random elements of a vector of `bytes`, with the dTLB
+/// misses of the reads. The vector is written first so every page is
+/// mapped before the timed part.
+template <typename _Alloc>
+void random_reads(const char* what, size_t bytes, size_t reads,
+                  double* base_ms)
+{
+    typedef ft::vector<size_t, _Alloc> vector_type;
+
+    const size_t       n = bytes / sizeof(size_t);
+    vector_type        v(n, 1);
+    Bench::TlbCounter  tlb;
+    long long          misses = 0;
+
+    double ms = Bench::measure([&]() {
+        size_t sum = 0;
+        size_t x = 12345;
+        tlb.start();
+        for (size_t i = 0; i < reads; ++i)
+        {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            sum += v[(x >> 17) % n];
+        }
+        misses = tlb.stop();
+        Bench::do_not_optimize(sum);
+    });
+
+    if (!*base_ms)
+        *base_ms = ms;
+    char ratio[32];
+    std::snprintf(ratio, sizeof(ratio), "x%.2f, ", *base_ms / ms);
+    Bench::report(std::string("random reads, ") + what, ms,
+                  ratio + tlb.note(misses));
+}
+
+/// Sequential sum over a vector of `bytes`, repeated until about 4GB were
+/// read, reported in GB/s.
+template <typename _Alloc>
+void sequential_sum(const char* what, size_t bytes)
+{
+    typedef ft::vector<float, _Alloc> vector_type;
+
+    const size_t n = bytes / sizeof(float);
+    const size_t reps = (size_t(4) << 30) / bytes + 1;
+    vector_type  v(n, 1.0f);
+
+    double ms = Bench::measure([&]() {
+        for (size_t r = 0; r < reps; ++r)
+        {
+            float sum = 0;
+            for (size_t i = 0; i < n; ++i)
+                sum += v[i];
+            Bench::do_not_optimize(sum);
+        }
+    });
+
+    char note[32];
+    std::snprintf(note, sizeof(note), "%.2f GB/s",
+                  double(bytes) * reps / (ms * 1e6));
+    Bench::report(std::string("sequential sum, ") + what, ms, note);
+}
+
+/// Builds a map of `count` random keys, looks every key up, then destroys
+/// it.
+template <typename _Alloc>
+double tree_nodes(size_t count)
+{
+    typedef ft::map<int, int, ft::less<int>, _Alloc> map_type;
+
+    return Bench::measure([&]() {
+        map_type m;
+        unsigned x = 1;
+        for (size_t i = 0; i < count; ++i)
+        {
+            x = x * 1103515245u + 12345u;
+            m[static_cast<int>(x >> 1)] = static_cast<int>(i);
+        }
+        size_t found = 0;
+        x = 1;
+        for (size_t i = 0; i < count; ++i)
+        {
+            x = x * 1103515245u + 12345u;
+            found += m.find(static_cast<int>(x >> 1)) != m.end();
+        }
+        Bench::do_not_optimize(found);
+    });
+}
+
+} // namespace
+
+BENCHMARK(allocator, random_reads)
+{
+    const size_t bytes = Bench::scaled(size_t(1) << 30);
+    const size_t reads = Bench::scaled(size_t(1) << 24);
+    double base = 0;
+
+    random_reads<std::allocator<size_t> >("std::allocator", bytes, reads, &base);
+    random_reads<ft::aligned_allocator<size_t> >("ft::aligned_allocator",
+                                                 bytes, reads, &base);
+    random_reads<ft::hugepage_allocator<size_t> >("ft::hugepage_allocator",
+                                                  bytes, reads, &base);
+    random_reads<ft::arena_allocator<size_t> >("ft::arena_allocator",
+                                               bytes, reads, &base);
+    ft::mmap_arena::global().release();
+}
+
+BENCHMARK(allocator, sequential_sum)
+{
+    const size_t bytes = Bench::scaled(size_t(256) << 20);
+
+    sequential_sum<std::allocator<float> >("std::allocator", bytes);
+    sequential_sum<ft::aligned_allocator<float> >("ft::aligned_allocator", bytes);
+    sequential_sum<ft::hugepage_allocator<float> >("ft::hugepage_allocator", bytes);
+}
+
+BENCHMARK(allocator, tree_nodes)
+{
+    typedef ft::pair<const int, int> value_type;
+
+    const size_t count = Bench::scaled(1000000);
+    double base = tree_nodes<std::allocator<value_type> >(count);
+
+    Bench::report("map insert + find, std::allocator", base);
+    Bench::report_ratio("map insert + find, ft::aligned_allocator", base,
+                        tree_nodes<ft::aligned_allocator<value_type> >(count));
+    Bench::report_ratio("map insert + find, ft::arena_allocator", base,
+                        tree_nodes<ft::arena_allocator<value_type> >(count));
+    ft::mmap_arena::global().release();
+}
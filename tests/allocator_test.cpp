@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "test_types.h"
+#include "../allocator.hpp"
+
+#include <string>
+
+/// helpers
+
+template <typename _Ptr>
+size_t address(_Ptr p)
+{
+    return reinterpret_cast<size_t>(p);
+}
+
+/// Tests
+
+TEST(AlignedAllocator, VectorAndTree)
+{
+    ft::vector<float, ft::aligned_allocator<float> > floats;
+    for (int i = 0; i < 10000; ++i)
+    {
+        floats.push_back(i);
+        ASSERT_EQ(address(&floats[0]) % 64, 0);
+    }
+    for (int i = 0; i < 10000; ++i)
+        ASSERT_EQ(floats[i], i);
+
+    ft::vector<char, ft::aligned_allocator<char, 4096> > page(100, 'x');
+    EXPECT_EQ(address(&page[0]) % 4096, 0);
+
+    ft::map<int, std::string, ft::less<int>,
+            ft::aligned_allocator<ft::pair<const int, std::string> > > map;
+    for (int i = 0; i < 1000; ++i)
+        map[i] = std::string(i % 20, 'm');
+    EXPECT_EQ(map.size(), 1000);
+    EXPECT_EQ(map[999], std::string(19, 'm'));
+    EXPECT_EQ(address(&*map.begin()) % 64, address(&*map.find(500)) % 64);
+    map.clear();
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(AlignedAllocator, OverflowingSizeThrows)
+{
+    ft::aligned_allocator<double> alloc;
+    EXPECT_THROW(alloc.allocate(alloc.max_size() + 1), std::bad_alloc);
+    EXPECT_THROW(alloc.allocate(size_t(-1) / 4), std::bad_alloc);
+
+    double* p = alloc.allocate(0);
+    EXPECT_EQ(address(p) % 64, 0);
+    alloc.deallocate(p, 0);
+}
+
+TEST(MremapAllocator, OverflowingSizeThrows)
+{
+    ft::mremap_allocator<double> alloc;
+    EXPECT_THROW(alloc.allocate(alloc.max_size() + 1), std::bad_alloc);
+    EXPECT_THROW(alloc.allocate(size_t(-1) / 4), std::bad_alloc);
+}
+
+TEST(HugepageAllocator, LargeBlocksAreAligned)
+{
+    typedef ft::hugepage_allocator<char> alloc_type;
+
+    ft::vector<char, alloc_type> large(alloc_type::threshold * 2, 'h');
+#ifdef FT_HUGEPAGES
+    EXPECT_EQ(address(&large[0]) % ft::hugepage_size, 0);
+#endif
+    EXPECT_EQ(large.back(), 'h');
+    large.resize(large.size() * 3, 'g');
+    EXPECT_EQ(large.front(), 'h');
+    EXPECT_EQ(large.back(), 'g');
+
+    // small blocks, like tree nodes, come from operator new
+    ft::set<int, ft::less<int>, ft::hugepage_allocator<int> > set;
+    for (int i = 0; i < 1000; ++i)
+        set.insert(i * 7 % 1000);
+    EXPECT_EQ(set.size(), 1000);
+    EXPECT_EQ(*set.begin(), 0);
+}
+
+TEST(HugepageAllocator, OverflowingSizeThrows)
+{
+    ft::hugepage_allocator<double> alloc;
+    EXPECT_THROW(alloc.allocate(alloc.max_size() + 1), std::bad_alloc);
+    EXPECT_THROW(alloc.allocate(size_t(-1) / 4), std::bad_alloc);
+}
+
+TEST(MmapArena, BumpAndRelease)
+{
+    ft::mmap_arena arena(1 << 16);
+
+    char* a = static_cast<char*>(arena.allocate(100));
+    char* b = static_cast<char*>(arena.allocate(1));
+    EXPECT_EQ(address(a) % ft::mmap_arena::alignment, 0);
+    EXPECT_EQ(b, a + 112);
+    EXPECT_EQ(arena.used_bytes(), 128);
+
+    // only the last block grows, shrinks or goes back
+    EXPECT_EQ(arena.reallocate(a, 100, 200), (void*)NULL);
+    EXPECT_EQ(arena.reallocate(b, 1, 1000), b);
+    EXPECT_EQ(arena.used_bytes(), 112 + 1008);
+    arena.deallocate(a, 100);
+    EXPECT_EQ(arena.used_bytes(), 112 + 1008);
+    arena.deallocate(b, 1000);
+    EXPECT_EQ(arena.used_bytes(), 112);
+    EXPECT_EQ(arena.allocate(16), b);
+
+    // blocks larger than a chunk get a chunk of their own
+    arena.allocate(1 << 20);
+    EXPECT_GE(arena.mapped_bytes(), size_t(1 << 20) + (1 << 16));
+
+    // sizes whose byte count would wrap are refused
+    ft::arena_allocator<double> alloc(arena);
+    double* d = alloc.allocate(4);
+    EXPECT_THROW(alloc.allocate(size_t(-1) / 4), std::bad_alloc);
+    EXPECT_THROW(alloc.reallocate(d, 4, size_t(-1) / 4), std::bad_alloc);
+
+    arena.release();
+    EXPECT_EQ(arena.mapped_bytes(), 0);
+    EXPECT_EQ(arena.used_bytes(), 0);
+}
+
+TEST(MmapArena, Containers)
+{
+    typedef ft::arena_allocator<ft::pair<const int, int> > pair_alloc;
+    typedef ft::growth_stats<ft::growth_2x>                policy_type;
+
+    ft::mmap_arena arena;
+    {
+        // the vector is the last block, so it grows in place
+        ft::vector<int, ft::arena_allocator<int>, policy_type>
+            vec((ft::arena_allocator<int>(arena)));
+        for (int i = 0; i < 100000; ++i)
+            vec.push_back(i);
+        for (int i = 0; i < 100000; ++i)
+            ASSERT_EQ(vec[i], i);
+        EXPECT_EQ(vec.growth_policy().bytes_copied(), 0);
+        EXPECT_EQ(&vec.get_allocator().arena(), &arena);
+
+        ft::map<int, int, ft::less<int>, pair_alloc> map((ft::less<int>()),
+                                                         pair_alloc(arena));
+        for (int i = 0; i < 1000; ++i)
+            map[i] = -i;
+        EXPECT_EQ(map.size(), 1000);
+        EXPECT_EQ(map[500], -500);
+        EXPECT_EQ(&map.get_allocator().arena(), &arena);
+
+        ft::map<int, int, ft::less<int>, pair_alloc> copy(map);
+        EXPECT_TRUE(copy == map);
+        EXPECT_EQ(&copy.get_allocator().arena(), &arena);
+    }
+    EXPECT_GT(arena.mapped_bytes(), 0);
+    arena.release();
+    EXPECT_EQ(arena.mapped_bytes(), 0);
+
+    // default constructed allocators share the global arena
+    EXPECT_TRUE(ft::arena_allocator<int>() == ft::arena_allocator<char>());
+    EXPECT_FALSE(ft::arena_allocator<int>(arena) == ft::arena_allocator<int>());
+}
@@ -0,0 +1,241 @@
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+# include <cstring>
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
+namespace Bench
+{
+
+/// registry
+
+typedef void (*bench_fn)();
+
+struct Case
+{
+    const char* group;
+    const char* name;
+    bench_fn    fn;
+};
+
+inline std::vector<Case>& registry()
+{
+    static std::vector<Case> cases;
+    return cases;
+}
+
+struct Registrar
+{
+    Registrar(const char* group, const char* name, bench_fn fn)
+    {
+        Case c = { group, name, fn };
+        registry().push_back(c);
+    }
+};
+
+/// options
+
+/// Multiplier for the default problem sizes, set with --scale=N.
+inline double& scale()
+{
+    static double s = 1.0;
+    return s;
+}
+
+inline size_t scaled(size_t n)
+{
+    size_t r = static_cast<size_t>(n * scale());
+    return r ? r : 1;
+}
+
+/// allocation counting
+
+/// std::allocator that counts the calls to allocate() per value type.
+template <typename _Tp>
+struct CountingAllocator : public std::allocator<_Tp>
+{
+    template <typename _Up>
+    struct rebind { typedef CountingAllocator<_Up> other; };
+
+    CountingAllocator()
+    {}
+
+    template <typename _Up>
+    CountingAllocator(const CountingAllocator<_Up>&)
+    {}
+
+    _Tp* allocate(size_t n, const void* = 0)
+    {
+        ++allocations();
+        return std::allocator<_Tp>::allocate(n);
+    }
+
+    static size_t& allocations()
+    {
+        static size_t n = 0;
+        return n;
+    }
+};
+
+/// measuring
+
+template <typename _Tp>
+inline void do_not_optimize(const _Tp& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+class Timer
+{
+public:
+    Timer()
+        : _start(clock_type::now())
+    {}
+
+    void reset()
+    { _start = clock_type::now(); }
+
+    double ms() const
+    {
+        return std::chrono::duration<double, std::milli>(
+            clock_type::now() - _start).count();
+    }
+
+private:
+    typedef std::chrono::steady_clock clock_type;
+
+    clock_type::time_point _start;
+};
+
+/// Runs fn `reps` times and returns the best wall time in milliseconds.
+template <typename _Fn>
+double measure(_Fn fn, size_t reps = 3)
+{
+    double best = 0;
+    for (size_t i = 0; i < reps; ++i)
+    {
+        Timer t;
+        fn();
+        double elapsed = t.ms();
+        if (i == 0 || elapsed < best)
+            best = elapsed;
+    }
+    return best;
+}
+
+/// Counts the data TLB load misses of the calling thread with
+/// perf_event_open. available() is false where the kernel or the VM does
+/// not expose the counter.
+class TlbCounter
+{
+public:
+    TlbCounter()
+        : _fd(-1)
+    {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB
+            | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+            | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        _fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~TlbCounter()
+    {
+#ifdef __linux__
+        if (_fd >= 0)
+            close(_fd);
+#endif
+    }
+
+    bool available() const
+    { return _fd >= 0; }
+
+    void start()
+    {
+#ifdef __linux__
+        if (_fd >= 0)
+        {
+            ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /// Misses since start(), 0 if the counter is not available.
+    long long stop()
+    {
+        long long count = 0;
+#ifdef __linux__
+        if (_fd >= 0)
+        {
+            ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(_fd, &count, sizeof(count)) != sizeof(count))
+                count = 0;
+        }
+#endif
+        return count;
+    }
+
+    /// "dTLB misses N" for a report note.
+    std::string note(long long misses) const
+    {
+        if (!available())
+            return "dTLB misses n/a";
+        char buf[48];
+        std::snprintf(buf, sizeof(buf), "dTLB misses %lld", misses);
+        return buf;
+    }
+
+private:
+    TlbCounter(const TlbCounter&);
+    TlbCounter& operator=(const TlbCounter&);
+
+    int _fd;
+};
+
+inline void report(const std::string& label, double ms, const std::string& note = "")
+{
+    std::printf("  %-48s %12.3f ms  %s\n", label.c_str(), ms, note.c_str());
+    std::fflush(stdout);
+}
+
+inline void report_ratio(const std::string& label, double base_ms, double ms)
+{
+    char note[32];
+    std::snprintf(note, sizeof(note), "x%.2f", ms > 0 ? base_ms / ms : 0.0);
+    report(label, ms, note);
+}
+
+} // namespace Bench
+
+#define BENCH_CONCAT_(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_(a, b)
+
+/// Defines a benchmark body, run by stl_bench as "group.name".
+#define BENCHMARK(group, name) \
+    static void BENCH_CONCAT(group##_##name, _bench)(); \
+    static Bench::Registrar BENCH_CONCAT(group##_##name, _registrar)( \
+        #group, #name, &BENCH_CONCAT(group##_##name, _bench)); \
+    static void BENCH_CONCAT(group##_##name, _bench)()
+
+#endif // BENCH_H_
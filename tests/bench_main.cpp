@@ -0,0 +1,51 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "bench.h"
+
+static void usage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [--list] [--scale=N] [filter...]\n"
+              << "  filter  run only benchmarks whose \"group.name\" contains it\n"
+              << "  --scale multiply the default problem sizes by N\n";
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> filters;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--list"))
+            list = true;
+        else if (!std::strncmp(argv[i], "--scale=", 8))
+            Bench::scale() = std::atof(argv[i] + 8);
+        else if (argv[i][0] == '-')
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        else
+            filters.push_back(argv[i]);
+    }
+
+    const std::vector<Bench::Case>& cases = Bench::registry();
+    for (size_t i = 0; i < cases.size(); ++i)
+    {
+        std::string id = std::string(cases[i].group) + "." + cases[i].name;
+
+        bool selected = filters.empty();
+        for (size_t f = 0; f < filters.size() && !selected; ++f)
+            selected = id.find(filters[f]) != std::string::npos;
+        if (!selected)
+            continue;
+
+        std::cout << id << std::endl;
+        if (!list)
+            cases[i].fn();
+    }
+    return 0;
+}
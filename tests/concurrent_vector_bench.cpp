@@ -0,0 +1,107 @@
+#include "bench.h"
+#include "../concurrent_vector.hpp"
+#include "../vector.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#ifdef FT_CXX11
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    template <class Fn>
+    void run_threads(unsigned threads, Fn fn)
+    {
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t)
+            pool.push_back(std::thread(fn, t));
+        for (unsigned t = 0; t < threads; ++t)
+            pool[t].join();
+    }
+}
+
+BENCHMARK(concurrent_vector, scaling)
+{
+    const size_t n = Bench::scaled(size_t(4) << 20);
+    const unsigned cores = std::max(4u, std::thread::hardware_concurrency());
+
+    std::printf("  (%u hardware threads)\n", std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= cores; threads *= 2)
+    {
+        const size_t per_thread = n / threads;
+        char label[64];
+
+        double base = Bench::measure([&]() {
+            ft::vector<int> v;
+            std::mutex      lock;
+            run_threads(threads, [&](unsigned t) {
+                for (size_t i = 0; i < per_thread; ++i)
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    v.push_back(static_cast<int>(t + i));
+                }
+            });
+            Bench::do_not_optimize(v.back());
+        });
+        std::snprintf(label, sizeof(label), "push_back 4M, %u threads, mutex + ft::vector", threads);
+        Bench::report(label, base);
+
+        std::snprintf(label, sizeof(label), "push_back 4M, %u threads, concurrent", threads);
+        Bench::report_ratio(label, base, Bench::measure([&]() {
+            ft::concurrent_vector<int> v;
+            run_threads(threads, [&](unsigned t) {
+                for (size_t i = 0; i < per_thread; ++i)
+                    v.push_back(static_cast<int>(t + i));
+            });
+            Bench::do_not_optimize(v.back());
+        }));
+
+        std::snprintf(label, sizeof(label), "grow_by(64) 4M, %u threads, concurrent", threads);
+        Bench::report_ratio(label, base, Bench::measure([&]() {
+            ft::concurrent_vector<int> v;
+            run_threads(threads, [&](unsigned t) {
+                for (size_t i = 0; i < per_thread; i += 64)
+                    v.grow_by(64, static_cast<int>(t));
+            });
+            Bench::do_not_optimize(v.back());
+        }));
+    }
+}
+
+BENCHMARK(concurrent_vector, read)
+{
+    const size_t n = Bench::scaled(size_t(4) << 20);
+    ft::vector<int>            vec;
+    ft::concurrent_vector<int> cvec;
+    for (size_t i = 0; i < n; ++i)
+    {
+        vec.push_back(static_cast<int>(i));
+        cvec.push_back(static_cast<int>(i));
+    }
+
+    double base = Bench::measure([&]() {
+        long sum = 0;
+        for (size_t i = 0; i < n; ++i)
+            sum += vec[i];
+        Bench::do_not_optimize(sum);
+    });
+    Bench::report("index 4M, ft::vector", base);
+    Bench::report_ratio("index 4M, concurrent", base, Bench::measure([&]() {
+        long sum = 0;
+        for (size_t i = 0; i < n; ++i)
+            sum += cvec[i];
+        Bench::do_not_optimize(sum);
+    }));
+    Bench::report_ratio("iterate 4M, concurrent", base, Bench::measure([&]() {
+        long sum = 0;
+        for (ft::concurrent_vector<int>::const_iterator it = cvec.begin(); it != cvec.end(); ++it)
+            sum += *it;
+        Bench::do_not_optimize(sum);
+    }));
+}
+
+#endif
@@ -0,0 +1,254 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "test_types.h"
+#include "../concurrent_vector.hpp"
+
+#ifdef FT_CXX11
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+/// helpers
+
+/// Negative values refuse to be copied.
+struct Picky
+{
+    Picky(int v = 0) : val(v) {}
+    Picky(const Picky& other) : val(other.val)
+    {
+        if (val < 0)
+            throw std::runtime_error("picky");
+    }
+
+    Picky& operator=(const Picky& other)
+    {
+        val = other.val;
+        return *this;
+    }
+
+    int val;
+};
+
+/// std::allocator that throws while the shared flag is set.
+struct AllocationSwitch
+{
+    static bool& fail() { static bool f = false; return f; }
+};
+
+template <typename _Tp>
+struct SwitchAllocator : public std::allocator<_Tp>
+{
+    template <typename _Up>
+    struct rebind { typedef SwitchAllocator<_Up> other; };
+
+    SwitchAllocator()
+    {}
+
+    template <typename _Up>
+    SwitchAllocator(const SwitchAllocator<_Up>&)
+    {}
+
+    _Tp* allocate(size_t n, const void* = 0)
+    {
+        if (AllocationSwitch::fail())
+            throw std::bad_alloc();
+        return std::allocator<_Tp>::allocate(n);
+    }
+};
+
+/// Tests
+
+TEST(ConcurrentVector, SingleThread)
+{
+    ft::concurrent_vector<int, std::allocator<int>, 4> vec;
+
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(vec.push_back(i), static_cast<size_t>(i));
+    EXPECT_EQ(vec.grow_by(50, -1), 100u);
+    EXPECT_EQ(vec.size(), 150u);
+    EXPECT_EQ(vec.front(), 0);
+    EXPECT_EQ(vec.back(), -1);
+    EXPECT_EQ(vec[99], 99);
+    EXPECT_EQ(vec[100], -1);
+    EXPECT_THROW(vec.at(150), std::out_of_range);
+    EXPECT_GE(vec.capacity(), 150u);
+
+    int* first = &vec[0];
+    vec.grow_by(1000, 7);
+    EXPECT_EQ(&vec[0], first);
+    EXPECT_EQ(vec.size(), 1150u);
+
+    size_t i = 0;
+    for (ft::concurrent_vector<int, std::allocator<int>, 4>::const_iterator it = vec.begin();
+         it != vec.end(); ++it, ++i)
+        ASSERT_EQ(*it, i < 100 ? static_cast<int>(i) : i < 150 ? -1 : 7);
+    EXPECT_EQ(vec.end() - vec.begin(), 1150);
+    EXPECT_EQ(*vec.rbegin(), 7);
+    EXPECT_EQ(vec.begin()[42], 42);
+}
+
+TEST(ConcurrentVector, CopyAndClear)
+{
+    ft::concurrent_vector<std::string> vec;
+    vec.reserve(300);
+    size_t capacity = vec.capacity();
+    for (int i = 0; i < 300; ++i)
+        vec.push_back(std::string(i % 30, 'q'));
+    EXPECT_EQ(vec.capacity(), capacity);
+
+    ft::concurrent_vector<std::string> copy(vec);
+    EXPECT_EQ(copy.size(), 300u);
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), copy.begin()));
+
+    vec.clear();
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(vec.capacity(), capacity);
+    vec.emplace_back(3, 'x');
+    EXPECT_EQ(vec.size(), 1u);
+    EXPECT_EQ(vec[0], "xxx");
+
+    copy = vec;
+    EXPECT_EQ(copy.size(), 1u);
+    EXPECT_EQ(copy.back(), "xxx");
+}
+
+TEST(ConcurrentVector, ThrowingConstructorIsSkipped)
+{
+    ft::concurrent_vector<Picky, std::allocator<Picky>, 4> vec;
+
+    vec.push_back(Picky(0));
+    EXPECT_THROW(vec.push_back(Picky(-1)), std::runtime_error);
+    vec.push_back(Picky(2));
+    ASSERT_EQ(vec.size(), 3u);
+    EXPECT_FALSE(vec.failed(0));
+    EXPECT_TRUE(vec.failed(1));
+    EXPECT_EQ(vec[2].val, 2);
+    EXPECT_THROW(vec.at(1), std::runtime_error);
+
+    // the element that threw and the rest of the batch are failed
+    EXPECT_THROW(vec.grow_by(10, Picky(-3)), std::runtime_error);
+    EXPECT_EQ(vec.push_back(Picky(13)), 13u);
+    ASSERT_EQ(vec.size(), 14u);
+    size_t failed = 0;
+    for (ft::concurrent_vector<Picky, std::allocator<Picky>, 4>::iterator it = vec.begin();
+         it != vec.end(); ++it)
+        failed += it.failed();
+    EXPECT_EQ(failed, 11u);
+    EXPECT_EQ(vec.back().val, 13);
+
+    ft::concurrent_vector<Picky, std::allocator<Picky>, 4> copy(vec);
+    ASSERT_EQ(copy.size(), 14u);
+    EXPECT_TRUE(copy.failed(1));
+    EXPECT_EQ(copy[13].val, 13);
+
+    vec.clear();
+    vec.push_back(Picky(5));
+    EXPECT_FALSE(vec.failed(0));
+}
+
+TEST(ConcurrentVector, FailedAllocationCostsNoIndex)
+{
+    ft::concurrent_vector<int, SwitchAllocator<int>, 4> vec;
+    for (int i = 0; i < 4; ++i)
+        vec.push_back(i);
+
+    // the second segment is missing, both appends fail before taking
+    // an index
+    AllocationSwitch::fail() = true;
+    EXPECT_THROW(vec.push_back(4), std::bad_alloc);
+    EXPECT_THROW(vec.grow_by(3, 4), std::bad_alloc);
+    AllocationSwitch::fail() = false;
+
+    EXPECT_EQ(vec.push_back(4), 4u);
+    EXPECT_EQ(vec.grow_by(3, 5), 5u);
+    ASSERT_EQ(vec.size(), 8u);
+    for (size_t i = 0; i < vec.size(); ++i)
+        EXPECT_FALSE(vec.failed(i));
+    EXPECT_EQ(vec.back(), 5);
+}
+
+TEST(ConcurrentVector, ConcurrentAppends)
+{
+    const int threads = 4;
+    const int per_thread = 20000;
+    ft::concurrent_vector<long> vec;
+    std::vector<std::thread> producers;
+
+    for (int t = 0; t < threads; ++t)
+        producers.push_back(std::thread([&vec, t]() {
+            for (int i = 0; i < per_thread; ++i)
+            {
+                if (i % 100 == 0)
+                    vec.grow_by(3, (long(t) << 32) | (1 << 30) | i);
+                else
+                    vec.push_back((long(t) << 32) | i);
+            }
+        }));
+    for (size_t t = 0; t < producers.size(); ++t)
+        producers[t].join();
+
+    ASSERT_EQ(vec.size(), size_t(threads) * (per_thread + per_thread / 100 * 2));
+
+    // every value is there the expected number of times, and each
+    // producer's values keep the order it appended them in
+    std::vector<int> last(threads, -1);
+    std::vector<size_t> seen(threads, 0);
+    for (size_t i = 0; i < vec.size(); ++i)
+    {
+        int t = static_cast<int>(vec[i] >> 32);
+        int value = static_cast<int>(vec[i] & ((1 << 30) - 1));
+        ASSERT_GE(value, last[t]);
+        last[t] = value;
+        ++seen[t];
+    }
+    for (int t = 0; t < threads; ++t)
+        EXPECT_EQ(seen[t], size_t(per_thread + per_thread / 100 * 2));
+}
+
+TEST(ConcurrentVector, ReadWhileAppending)
+{
+    ft::concurrent_vector<std::string> vec;
+    std::atomic<bool>   done(false);
+    std::atomic<size_t> bad(0);
+
+    // a value names its own length, a torn read would not
+    struct Check
+    {
+        static std::string make(size_t k)  { return std::string(k % 50 + 1, 'a' + (k % 50 + 1) % 26); }
+        static bool valid(const std::string& s)
+        {
+            return !s.empty() && s[0] == char('a' + s.size() % 26)
+                && s.find_first_not_of(s[0]) == std::string::npos;
+        }
+    };
+
+    std::thread reader([&]() {
+        while (!done.load())
+        {
+            size_t n = vec.size();
+            for (size_t i = n > 256 ? n - 256 : 0; i < n; ++i)
+                if (!Check::valid(vec[i]))
+                    ++bad;
+        }
+    });
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 2; ++t)
+        writers.push_back(std::thread([&vec, t]() {
+            for (size_t k = 0; k < 20000; ++k)
+                vec.push_back(Check::make(k * 2 + t));
+        }));
+    for (size_t t = 0; t < writers.size(); ++t)
+        writers[t].join();
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(bad.load(), 0u);
+    ASSERT_EQ(vec.size(), 40000u);
+    for (ft::concurrent_vector<std::string>::iterator it = vec.begin(); it != vec.end(); ++it)
+        ASSERT_TRUE(Check::valid(*it));
+}
+
+#endif
@@ -0,0 +1,99 @@
+#include "bench.h"
+#include "../deque.hpp"
+#include "../stack.hpp"
+#include "../vector.hpp"
+
+#include <cstdio>
+#include <deque>
+#include <string>
+
+namespace
+{
+
+struct Buffer
+{
+    int  idx;
+    char buff[4096];
+};
+
+/// Pushes `count` values on a stack over _Container, then pops them all,
+/// and reports the time and the slowest single push.
+template <typename _Container>
+double stack_push_pop(const char* what, size_t count,
+                      const typename _Container::value_type& val, double base)
+{
+    double worst = 0;
+    double ms = Bench::measure([&]() {
+        ft::stack<typename _Container::value_type, _Container> s;
+        for (size_t i = 0; i < count; ++i)
+        {
+            Bench::Timer t;
+            s.push(val);
+            double push_ms = t.ms();
+            if (push_ms > worst)
+                worst = push_ms;
+        }
+        while (!s.empty())
+            s.pop();
+    }, 1);
+
+    char note[64];
+    if (base)
+        std::snprintf(note, sizeof(note), "x%.2f, slowest push %.3f ms", base / ms, worst);
+    else
+        std::snprintf(note, sizeof(note), "slowest push %.3f ms", worst);
+    Bench::report(what, ms, note);
+    return ms;
+}
+
+template <typename _Tp>
+void stack_workload(const char* type, size_t count, const _Tp& val)
+{
+    char label[96];
+
+    std::snprintf(label, sizeof(label), "%s x %zu, std::deque", type, count);
+    double base = stack_push_pop<std::deque<_Tp> >(label, count, val, 0);
+    std::snprintf(label, sizeof(label), "%s x %zu, ft::vector", type, count);
+    stack_push_pop<ft::vector<_Tp> >(label, count, val, base);
+    std::snprintf(label, sizeof(label), "%s x %zu, ft::deque", type, count);
+    stack_push_pop<ft::deque<_Tp> >(label, count, val, base);
+}
+
+/// A sliding window: push at the back, pop at the front.
+template <typename _Deque>
+double queue_window(size_t window, size_t steps)
+{
+    return Bench::measure([&]() {
+        _Deque q;
+        for (size_t i = 0; i < window; ++i)
+            q.push_back(static_cast<int>(i));
+        long sum = 0;
+        for (size_t i = 0; i < steps; ++i)
+        {
+            sum += q.front();
+            q.pop_front();
+            q.push_back(static_cast<int>(i));
+        }
+        Bench::do_not_optimize(sum);
+    });
+}
+
+} // namespace
+
+BENCHMARK(deque, stack)
+{
+    Buffer buffer = Buffer();
+
+    stack_workload<int>("int", Bench::scaled(size_t(16) << 20), 42);
+    stack_workload<Buffer>("Buffer", Bench::scaled(size_t(1) << 17), buffer);
+}
+
+BENCHMARK(deque, queue)
+{
+    const size_t steps = Bench::scaled(size_t(32) << 20);
+    double base = queue_window<std::deque<int> >(4096, steps);
+
+    Bench::report("window 4096, std::deque", base);
+    Bench::report_ratio("window 4096, ft::deque", base,
+                        queue_window<ft::deque<int> >(4096, steps));
+}
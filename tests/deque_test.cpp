@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include "test_types.h"
+#include "../deque.hpp"
+
+/// Tests
+
+TEST(Deque, PushPopBothEnds)
+{
+    std::deque<int> std_deq;
+    ft::deque<int>  ft_deq;
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        std_deq.push_back(i);
+        ft_deq.push_back(i);
+        std_deq.push_front(-i);
+        ft_deq.push_front(-i);
+    }
+    TestTypes::compare_sequence(ft_deq, std_deq);
+    EXPECT_EQ(ft_deq.front(), -4999);
+    EXPECT_EQ(ft_deq.back(), 4999);
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        std_deq.pop_front();
+        ft_deq.pop_front();
+    }
+    for (int i = 0; i < 4000; ++i)
+    {
+        std_deq.pop_back();
+        ft_deq.pop_back();
+    }
+    TestTypes::compare_sequence(ft_deq, std_deq);
+}
+
+TEST(Deque, ReferencesStayValid)
+{
+    ft::deque<std::string> deq;
+    deq.push_back("first");
+    std::string* first = &deq.front();
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        deq.push_back(std::string(i % 10, 'b'));
+        deq.push_front(std::string(i % 10, 'f'));
+    }
+    EXPECT_EQ(first, &deq[100000]);
+    EXPECT_EQ(*first, "first");
+}
+
+TEST(Deque, QueueReusesBlocks)
+{
+    typedef TestTypes::CountingAllocator<int> alloc_type;
+
+    ft::deque<int, alloc_type> deq;
+    for (int i = 0; i < 1000; ++i)
+        deq.push_back(i);
+    alloc_type::allocations() = 0;
+
+    // a sliding window reuses the blocks its front gave up
+    for (int i = 1000; i < 1000000; ++i)
+    {
+        deq.push_back(i);
+        deq.pop_front();
+    }
+    EXPECT_EQ(deq.size(), 1000);
+    EXPECT_EQ(deq.front(), 999000);
+    EXPECT_LT(alloc_type::allocations(), 10);
+}
+
+TEST(Deque, Modifiers)
+{
+    std::deque<std::string> std_deq;
+    ft::deque<std::string>  ft_deq;
+
+    for (int i = 0; i < 200; ++i)
+    {
+        std_deq.push_back(std::string(i % 13, 'a' + i % 26));
+        ft_deq.push_back(std::string(i % 13, 'a' + i % 26));
+    }
+
+    std_deq.insert(std_deq.begin() + 10, 30, "front half");
+    ft_deq.insert(ft_deq.begin() + 10, 30, "front half");
+    std_deq.insert(std_deq.begin() + 150, 40, "back half");
+    ft_deq.insert(ft_deq.begin() + 150, 40, "back half");
+    TestTypes::compare_sequence(ft_deq, std_deq);
+
+    // the value may be an element of the deque
+    std_deq.insert(std_deq.begin() + 3, std_deq[100]);
+    ft_deq.insert(ft_deq.begin() + 3, ft_deq[100]);
+    TestTypes::compare_sequence(ft_deq, std_deq);
+
+    std::vector<std::string> range(std_deq.begin() + 20, std_deq.begin() + 60);
+    std_deq.insert(std_deq.begin() + 5, range.begin(), range.end());
+    ft_deq.insert(ft_deq.begin() + 5, range.begin(), range.end());
+    TestTypes::compare_sequence(ft_deq, std_deq);
+
+    std_deq.erase(std_deq.begin() + 5, std_deq.begin() + 25);
+    ft_deq.erase(ft_deq.begin() + 5, ft_deq.begin() + 25);
+    std_deq.erase(std_deq.end() - 30, std_deq.end() - 2);
+    ft_deq.erase(ft_deq.end() - 30, ft_deq.end() - 2);
+    EXPECT_EQ(*ft_deq.erase(ft_deq.begin() + 100), *(std_deq.erase(std_deq.begin() + 100)));
+    TestTypes::compare_sequence(ft_deq, std_deq);
+
+    std_deq.resize(500, "resized");
+    ft_deq.resize(500, "resized");
+    TestTypes::compare_sequence(ft_deq, std_deq);
+    std_deq.resize(50);
+    ft_deq.resize(50);
+    TestTypes::compare_sequence(ft_deq, std_deq);
+
+    std_deq.assign(7, "assigned");
+    ft_deq.assign(7, "assigned");
+    TestTypes::compare_sequence(ft_deq, std_deq);
+
+    ft_deq.clear();
+    EXPECT_TRUE(ft_deq.empty());
+    EXPECT_THROW(ft_deq.at(0), std::out_of_range);
+    ft_deq.shrink_to_fit();
+    ft_deq.push_front("again");
+    EXPECT_EQ(ft_deq.at(0), "again");
+
+    // middle inserts longer and shorter than the side they shift
+    std::deque<int> std_ints;
+    ft::deque<int>  ft_ints;
+    for (int i = 0; i < 100; ++i)
+    {
+        std_ints.push_back(i);
+        ft_ints.push_back(i);
+    }
+    size_t positions[] = { 1, 10, 49, 50, 90, 99 };
+    size_t counts[] = { 1, 5, 20, 200 };
+    for (size_t p = 0; p < 6; ++p)
+        for (size_t c = 0; c < 4; ++c)
+        {
+            std_ints.insert(std_ints.begin() + positions[p], counts[c], -int(c));
+            ft_ints.insert(ft_ints.begin() + positions[p], counts[c], -int(c));
+            TestTypes::compare_sequence(ft_ints, std_ints);
+        }
+}
+
+TEST(Deque, CopySwapCompare)
+{
+    ft::deque<int> a;
+    for (int i = 0; i < 3000; ++i)
+        a.push_front(i);
+
+    ft::deque<int> b(a);
+    EXPECT_TRUE(a == b);
+    b.back() = -1;
+    EXPECT_TRUE(b < a);
+    EXPECT_TRUE(a > b);
+    EXPECT_TRUE(a != b);
+
+    ft::deque<int> c(10, 5);
+    ft::swap(b, c);
+    EXPECT_EQ(b.size(), 10);
+    EXPECT_EQ(c.size(), 3000);
+    c = b;
+    EXPECT_TRUE(c == b);
+
+    int values[] = { 3, 1, 4, 1, 5 };
+    ft::deque<int> d(values, values + 5);
+    EXPECT_EQ(d[2], 4);
+
+    std::istringstream in("9 8 7");
+    d.insert(d.begin() + 1, std::istream_iterator<int>(in), std::istream_iterator<int>());
+    int expected[] = { 3, 9, 8, 7, 1, 4, 1, 5 };
+    TestTypes::compare_sequence(d, std::deque<int>(expected, expected + 8));
+}
+
+TEST(Deque, Iterators)
+{
+    ft::deque<int> deq;
+    for (int i = 0; i < 10000; ++i)
+        deq.push_back(i);
+
+    ft::deque<int>::iterator it = deq.begin() + 5000;
+    EXPECT_EQ(*it, 5000);
+    EXPECT_EQ(it[1234], 6234);
+    EXPECT_EQ(deq.end() - it, 5000);
+    EXPECT_TRUE(deq.begin() < it);
+
+    ft::deque<int>::const_iterator cit = it;
+    EXPECT_TRUE(cit == it);
+
+    int expected = 9999;
+    for (ft::deque<int>::reverse_iterator rit = deq.rbegin(); rit != deq.rend(); ++rit)
+        ASSERT_EQ(*rit, expected--);
+
+    std::sort(deq.begin(), deq.end(), std::greater<int>());
+    EXPECT_EQ(deq.front(), 9999);
+    EXPECT_EQ(deq.back(), 0);
+}
+
+TEST(Deque, StackContainer)
+{
+    ft::stack<std::string, ft::deque<std::string> > stack;
+    for (int i = 0; i < 1000; ++i)
+        stack.push(std::string(i % 5, 's'));
+    EXPECT_EQ(stack.size(), 1000);
+    EXPECT_EQ(stack.top(), std::string(999 % 5, 's'));
+    stack.pop();
+    EXPECT_EQ(stack.top(), std::string(998 % 5, 's'));
+
+    ft::stack<std::string, ft::deque<std::string> > copy(stack);
+    EXPECT_TRUE(copy == stack);
+    copy.pop();
+    EXPECT_TRUE(copy < stack);
+}
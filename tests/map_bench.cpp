@@ -0,0 +1,261 @@
+#include "bench.h"
+#include "../map.hpp"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+std::vector<int> random_keys(size_t n)
+{
+    std::vector<int> keys(n);
+    unsigned x = 2463534242u;
+    for (size_t i = 0; i < n; ++i)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        keys[i] = static_cast<int>(x & 0x7fffffff);
+    }
+    return keys;
+}
+
+template <typename _Map>
+void map_workload(const char* what, const std::vector<int>& keys, double* base)
+{
+    char label[64];
+
+    // two maps built side by side, their nodes interleave in the heap
+    _Map m, other;
+    Bench::Timer timer;
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        m.insert(typename _Map::value_type(keys[i], static_cast<int>(i)));
+        other.insert(typename _Map::value_type(keys[i] ^ 1, static_cast<int>(i)));
+    }
+    double ms[4];
+    ms[0] = timer.ms();
+    ms[1] = Bench::measure([&]() {
+        long sum = 0;
+        for (size_t i = 0; i < keys.size(); ++i)
+            sum += m.find(keys[keys.size() - 1 - i])->second;
+        Bench::do_not_optimize(sum);
+    });
+    ms[2] = Bench::measure([&]() {
+        long sum = 0;
+        for (typename _Map::const_iterator it = m.begin(); it != m.end(); ++it)
+            sum += it->second;
+        Bench::do_not_optimize(sum);
+    });
+    ms[3] = Bench::measure([&]() {
+        _Map copy(m);
+        Bench::do_not_optimize(copy.begin()->second);
+    });
+
+    const char* steps[4] = { "build", "lookup", "iterate", "copy" };
+    for (int k = 0; k < 4; ++k)
+    {
+        std::snprintf(label, sizeof(label), "%s 1M, %s", steps[k], what);
+        if (base[k] == 0)
+        {
+            base[k] = ms[k];
+            Bench::report(label, ms[k]);
+        }
+        else
+            Bench::report_ratio(label, base[k], ms[k]);
+    }
+}
+
+// the comparator map<std::string> had before compare3, two calls a level
+struct TwoWayLess
+{
+    bool operator()(const std::string& a, const std::string& b) const { return a < b; }
+};
+
+template <typename _Map>
+void string_workload(const char* what, const std::vector<std::string>& keys, double* base)
+{
+    char label[64];
+    double ms[2];
+
+    _Map m;
+    Bench::Timer timer;
+    for (size_t i = 0; i < keys.size(); ++i)
+        m.insert(typename _Map::value_type(keys[i], static_cast<int>(i)));
+    ms[0] = timer.ms();
+    ms[1] = Bench::measure([&]() {
+        long sum = 0;
+        for (size_t i = 0; i < keys.size(); ++i)
+            sum += m.find(keys[keys.size() - 1 - i])->second;
+        Bench::do_not_optimize(sum);
+    });
+
+    const char* steps[2] = { "insert", "find" };
+    for (int k = 0; k < 2; ++k)
+    {
+        std::snprintf(label, sizeof(label), "%s 1M strings, %s", steps[k], what);
+        if (base[k] == 0)
+        {
+            base[k] = ms[k];
+            Bench::report(label, ms[k]);
+        }
+        else
+            Bench::report_ratio(label, base[k], ms[k]);
+    }
+}
+
+} // namespace
+
+BENCHMARK(map, node_pool)
+{
+    const std::vector<int> keys = random_keys(Bench::scaled(size_t(1) << 20));
+    double base[4] = { 0, 0, 0, 0 };
+
+    map_workload<std::map<int, int> >("std::map", keys, base);
+    map_workload<ft::map<int, int> >("ft::map", keys, base);
+
+    Bench::CountingAllocator<ft::pair<const int, int> >::allocations() = 0;
+    Bench::CountingAllocator<ft::_Rb_tree_node<ft::pair<const int, int> > >::allocations() = 0;
+    {
+        ft::map<int, int, ft::less<int>, Bench::CountingAllocator<ft::pair<const int, int> > > m;
+        for (size_t i = 0; i < keys.size(); ++i)
+            m.insert(ft::make_pair(keys[i], 0));
+    }
+    std::printf("  %-50s %zu\n", "allocate() calls for 1M ft::map inserts",
+                Bench::CountingAllocator<ft::_Rb_tree_node<ft::pair<const int, int> > >::allocations());
+}
+
+BENCHMARK(map, burst_release)
+{
+    const std::vector<int> keys = random_keys(Bench::scaled(size_t(2) << 20));
+    const size_t keep = keys.size() / 20;
+
+    // a burst of inserts, then all but the newest 5% are erased: the
+    // survivors sit in the last slabs, the older ones can go back
+    for (int limited = 0; limited < 2; ++limited)
+    {
+        ft::map<int, int> m;
+        if (limited)
+            m.node_cache_limit(65536);
+        for (size_t i = 0; i < keys.size(); ++i)
+            m.insert(ft::make_pair(keys[i], 0));
+        size_t peak = m.pool_stats().reserved_bytes;
+        Bench::Timer timer;
+        for (size_t i = 0; i + keep < keys.size(); ++i)
+            m.erase(keys[i]);
+        double ms = timer.ms();
+        ft::node_pool_stats st = m.pool_stats();
+        std::printf("  %-50s %10.3f ms  peak=%zuMB after=%zuMB live=%zu cached=%zu\n",
+                    limited ? "erase 95% of 2M, cache limit 64K" : "erase 95% of 2M, no limit",
+                    ms, peak >> 20, st.reserved_bytes >> 20, st.live_nodes, st.cached_nodes);
+        if (!limited)
+        {
+            timer = Bench::Timer();
+            size_t released = m.release_unused();
+            std::printf("  %-50s %10.3f ms  released=%zuMB\n", "release_unused() afterwards",
+                        timer.ms(), released >> 20);
+        }
+    }
+}
+
+BENCHMARK(map, sorted_load)
+{
+    const size_t n = Bench::scaled(size_t(10000000));
+    std::vector<ft::pair<int, int> > snapshot(n);
+    std::vector<std::pair<int, int> > std_snapshot(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        snapshot[i] = ft::make_pair(static_cast<int>(i * 2), static_cast<int>(i));
+        std_snapshot[i] = std::make_pair(static_cast<int>(i * 2), static_cast<int>(i));
+    }
+
+    // what every load used to do
+    double base = Bench::measure([&]() {
+        ft::map<int, int> m;
+        for (size_t i = 0; i < n; ++i)
+            m.insert(snapshot[i]);
+        Bench::do_not_optimize(m.size());
+    }, 1);
+    Bench::report("load 10M sorted, insert one by one", base);
+    Bench::report_ratio("load 10M sorted, std::map range ctor", base, Bench::measure([&]() {
+        std::map<int, int> m(std_snapshot.begin(), std_snapshot.end());
+        Bench::do_not_optimize(m.size());
+    }, 1));
+    Bench::report_ratio("load 10M sorted, ft::map range ctor", base, Bench::measure([&]() {
+        ft::map<int, int> m(snapshot.begin(), snapshot.end());
+        Bench::do_not_optimize(m.size());
+    }, 1));
+    Bench::report_ratio("load 10M sorted, ft::sorted_unique", base, Bench::measure([&]() {
+        ft::map<int, int> m(ft::sorted_unique, snapshot.begin(), snapshot.end());
+        Bench::do_not_optimize(m.size());
+    }, 1));
+}
+
+BENCHMARK(map, hinted_append)
+{
+    const size_t n = Bench::scaled(size_t(4) << 20);
+
+    // time-ordered keys, each inserted at end()
+    double base = Bench::measure([&]() {
+        std::map<int, int> m;
+        for (size_t i = 0; i < n; ++i)
+            m.insert(m.end(), std::make_pair(static_cast<int>(i), 0));
+        Bench::do_not_optimize(m.size());
+    });
+    Bench::report("4M appends hinted at end(), std::map", base);
+    Bench::report_ratio("4M appends hinted at end(), ft::map", base, Bench::measure([&]() {
+        ft::map<int, int> m;
+        for (size_t i = 0; i < n; ++i)
+            m.insert(m.end(), ft::make_pair(static_cast<int>(i), 0));
+        Bench::do_not_optimize(m.size());
+    }));
+    Bench::report_ratio("4M appends, ft::map without hint", base, Bench::measure([&]() {
+        ft::map<int, int> m;
+        for (size_t i = 0; i < n; ++i)
+            m.insert(ft::make_pair(static_cast<int>(i), 0));
+        Bench::do_not_optimize(m.size());
+    }));
+
+    // each key right after the previous one, hinted with its iterator
+    base = Bench::measure([&]() {
+        std::map<int, int> m;
+        m[-1] = 0;
+        m[1 << 30] = 0;
+        std::map<int, int>::iterator it = m.begin();
+        for (size_t i = 0; i < n; ++i)
+            it = m.insert(it, std::make_pair(static_cast<int>(i), 0));
+        Bench::do_not_optimize(m.size());
+    });
+    Bench::report("4M inserts after the last one, std::map", base);
+    Bench::report_ratio("4M inserts after the last one, ft::map", base, Bench::measure([&]() {
+        ft::map<int, int> m;
+        m[-1] = 0;
+        m[1 << 30] = 0;
+        ft::map<int, int>::iterator it = m.begin();
+        for (size_t i = 0; i < n; ++i)
+            it = m.insert(it, ft::make_pair(static_cast<int>(i), 0));
+        Bench::do_not_optimize(m.size());
+    }));
+}
+
+BENCHMARK(map, string_keys)
+{
+    // paths under one long directory, every comparison reads the prefix
+    std::vector<int> ids = random_keys(Bench::scaled(size_t(1) << 20));
+    std::vector<std::string> keys(ids.size());
+    char buf[32];
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        std::snprintf(buf, sizeof(buf), "%010d", ids[i]);
+        keys[i] = "/var/lib/containers/storage/overlay/l/"
+                  "0123456789abcdef0123456789abcdef/diff/usr/share/" + std::string(buf);
+    }
+
+    double base[2] = { 0, 0 };
+    string_workload<std::map<std::string, int> >("std::map", keys, base);
+    string_workload<ft::map<std::string, int, TwoWayLess> >("ft::map two-way", keys, base);
+    string_workload<ft::map<std::string, int> >("ft::map compare3", keys, base);
+}
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include <typeinfo>
+#include <list>
+#include <sstream>
+#include <stdexcept>
 #include "test_types.h"
+#include "../allocator.hpp"
 
 ///defines
 
@@ -856,3 +860,621 @@ REGISTER_TYPED_TEST_SUITE_P(MapTest,
 );
 
 INSTANTIATE_TYPED_TEST_SUITE_P(MapInstance, MapTest, TestTypes::TestMapTypes);
+
+/// move semantics
+
+TEST(MapMove, MoveConstructor)
+{
+    ft::map<int, std::string> src;
+    for (int i = 0; i < 100; ++i)
+        src[i] = "value";
+    const std::string* value = &src[50];
+
+    ft::map<int, std::string> dst(std::move(src));
+    EXPECT_EQ(dst.size(), 100);
+    EXPECT_EQ(&dst[50], value);
+    EXPECT_TRUE(src.empty());
+    EXPECT_EQ(src.begin(), src.end());
+
+    ft::map<int, std::string> other;
+    other[1000] = "old";
+    other = std::move(dst);
+    EXPECT_EQ(other.size(), 100);
+    EXPECT_EQ(&other[50], value);
+    EXPECT_EQ(other.count(1000), 0);
+    EXPECT_TRUE(dst.empty());
+}
+
+TEST(MapMove, Emplace)
+{
+    typedef TestTypes::MoveTracked tracked;
+    typedef ft::map<int, tracked> map_type;
+
+    map_type map;
+    tracked::reset();
+
+    ft::pair<map_type::iterator, bool> res = map.emplace(1, 10);
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(res.first->second.val, 10);
+
+    res = map.emplace(1, 20);
+    EXPECT_FALSE(res.second);
+    EXPECT_EQ(res.first->second.val, 10);
+
+    map.insert(map_type::value_type(2, tracked(30)));
+    map_type::iterator it = map.emplace_hint(map.end(), 3, 40);
+    EXPECT_EQ(it->first, 3);
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(tracked::copies(), 0);
+}
+
+TEST(MapMove, AccessOperatorRvalueKey)
+{
+    ft::map<std::string, int> map;
+    std::string key(64, 'k');
+
+    map[std::move(key)] = 1;
+    EXPECT_EQ(map[std::string(64, 'k')], 1);
+
+    std::string existing(64, 'k');
+    map[std::move(existing)] = 2;
+    EXPECT_EQ(existing, std::string(64, 'k'));
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(map.begin()->second, 2);
+}
+
+/// node pool
+
+TEST(MapNodePool, AllocatesSlabs)
+{
+    typedef TestTypes::CountingAllocator<ft::pair<const int, int> > alloc_type;
+    typedef TestTypes::CountingAllocator<ft::_Rb_tree_node<ft::pair<const int, int> > > node_alloc_type;
+
+    ft::map<int, int, ft::less<int>, alloc_type> map;
+    EXPECT_GT(map.node_slab_size(), 8);
+    map.node_slab_size(64);
+    EXPECT_EQ(map.node_slab_size(), 64);
+
+    // slabs of 8, 16, 32, then 64 nodes each
+    node_alloc_type::allocations() = 0;
+    for (int i = 0; i < 1000; ++i)
+        map[i * 7 % 1000] = i;
+    EXPECT_EQ(node_alloc_type::allocations(), 3 + (1000 - 56 + 63) / 64);
+
+    // freed nodes are reused before the pool grows again
+    map.clear();
+    for (int i = 0; i < 1000; ++i)
+        map[i] = i;
+    EXPECT_EQ(node_alloc_type::allocations(), 3 + (1000 - 56 + 63) / 64);
+
+    ft::map<int, int, ft::less<int>, alloc_type> copy(map);
+    EXPECT_EQ(copy.node_slab_size(), 64);
+    EXPECT_TRUE(copy == map);
+}
+
+TEST(MapNodePool, OverAlignedNodesShareSlabs)
+{
+    typedef ft::aligned_allocator<ft::pair<const int, int>, 64> alloc_type;
+
+    ft::map<int, int, ft::less<int>, alloc_type> map;
+    for (int i = 0; i < 1000; ++i)
+        map[i] = i;
+
+    // nodes are a cache line apart, but still many to a slab
+    ft::map<int, int, ft::less<int>, alloc_type>::pool_stats_type stats = map.pool_stats();
+    EXPECT_LT(stats.slabs, 20);
+    EXPECT_LT(stats.reserved_bytes, 1200 * 64);
+    for (ft::map<int, int, ft::less<int>, alloc_type>::iterator it = map.begin();
+         it != map.end(); ++it)
+        ASSERT_EQ(reinterpret_cast<size_t>(&*it) % 64, reinterpret_cast<size_t>(&*map.begin()) % 64);
+
+    for (int i = 0; i < 1000; ++i)
+        map.erase(i);
+    EXPECT_EQ(map.release_unused(), stats.reserved_bytes);
+    EXPECT_EQ(map.pool_stats().reserved_bytes, 0);
+}
+
+TEST(MapNodePool, SwapAndMoveKeepNodes)
+{
+    ft::map<int, std::string> outer;
+    outer[-1] = "outer";
+    {
+        ft::map<int, std::string> inner;
+        for (int i = 0; i < 500; ++i)
+            inner[i] = std::string(i % 40, 'v');
+        outer.swap(inner);
+    }
+    // the nodes came from the destroyed map's slabs
+    ASSERT_EQ(outer.size(), 500);
+    EXPECT_EQ(outer[499], std::string(499 % 40, 'v'));
+
+    ft::map<int, std::string> moved(std::move(outer));
+    outer[1] = "one";
+    moved.erase(10);
+    moved[1000] = "new";
+    ft::map<int, std::string> target;
+    target[5] = "five";
+    target = std::move(moved);
+    EXPECT_EQ(target.size(), 500);
+    EXPECT_EQ(target.count(10), 0);
+    EXPECT_EQ(target[1000], "new");
+    EXPECT_EQ(outer.size(), 1);
+}
+
+TEST(MapNodePool, ReleaseUnused)
+{
+    ft::map<int, int> map;
+    ft::map<int, int>::pool_stats_type stats = map.pool_stats();
+    EXPECT_EQ(stats.slabs, 0);
+    EXPECT_EQ(stats.reserved_bytes, 0);
+
+    for (int i = 0; i < 10000; ++i)
+        map[i] = i;
+    stats = map.pool_stats();
+    EXPECT_EQ(stats.live_nodes, 10000);
+    EXPECT_LT(stats.cached_nodes, map.node_slab_size());
+    size_t full = stats.reserved_bytes;
+
+    // every other node: nothing can go back, the slabs all hold live ones
+    for (int i = 0; i < 10000; i += 2)
+        map.erase(i);
+    EXPECT_EQ(map.release_unused(), 0);
+    EXPECT_EQ(map.pool_stats().live_nodes, 5000);
+
+    // the nodes of the first keys sit in the first slabs
+    for (int i = 1; i < 9000; i += 2)
+        map.erase(i);
+    size_t released = map.release_unused();
+    EXPECT_GT(released, full / 2);
+    stats = map.pool_stats();
+    EXPECT_EQ(stats.live_nodes, 500);
+    EXPECT_EQ(stats.reserved_bytes, full - released);
+    for (int i = 9001; i < 10000; i += 2)
+        ASSERT_EQ(map[i], i);
+
+    map.clear();
+    map.shrink_to_fit();
+    stats = map.pool_stats();
+    EXPECT_EQ(stats.slabs, 0);
+    EXPECT_EQ(stats.cached_nodes, 0);
+    map[1] = 1;
+    EXPECT_EQ(map.pool_stats().live_nodes, 1);
+}
+
+TEST(MapNodePool, CacheLimit)
+{
+    ft::map<int, std::string> map;
+    map.node_cache_limit(1000);
+    for (int i = 0; i < 100000; ++i)
+        map[i] = std::string(i % 30, 'c');
+    size_t full = map.pool_stats().reserved_bytes;
+
+    // the pool trims itself once the freelist grows past the limit
+    for (int i = 0; i < 99000; ++i)
+        map.erase(i);
+    ft::map<int, std::string>::pool_stats_type stats = map.pool_stats();
+    EXPECT_EQ(stats.live_nodes, 1000);
+    EXPECT_LT(stats.cached_nodes, 3000);
+    EXPECT_LT(stats.reserved_bytes, full / 20);
+    EXPECT_EQ(map[99999], std::string(99999 % 30, 'c'));
+
+    ft::map<int, std::string> copy(map);
+    EXPECT_EQ(copy.node_cache_limit(), 1000);
+    copy.node_cache_limit(10);
+    copy.clear();
+    EXPECT_EQ(copy.pool_stats().slabs, 0);
+    EXPECT_EQ(map.size(), 1000);
+}
+
+/// sorted bulk build
+
+namespace
+{
+
+/// Black height of the subtree at x, -1 when it breaks a red-black rule.
+int rb_black_height(const ft::_Rb_tree_node_base* x)
+{
+    if (!x)
+        return 1;
+    if (x->color == ft::RED
+        && ((x->left && x->left->color == ft::RED)
+            || (x->right && x->right->color == ft::RED)))
+        return -1;
+    if ((x->left && x->left->parent != x) || (x->right && x->right->parent != x))
+        return -1;
+    int left = rb_black_height(x->left);
+    int right = rb_black_height(x->right);
+    if (left < 0 || left != right)
+        return -1;
+    return left + (x->color == ft::BLACK);
+}
+
+template <typename _Map>
+bool rb_valid(_Map& m)
+{
+    const ft::_Rb_tree_node_base* header = m.end()._node;
+    const ft::_Rb_tree_node_base* root = header->parent;
+    if (!root)
+        return m.empty() && header->left == header && header->right == header;
+    return root->parent == header && root->color == ft::BLACK
+        && header->left == ft::_Rb_tree_node_base::minimum(root)
+        && header->right == ft::_Rb_tree_node_base::maximum(root)
+        && rb_black_height(root) > 0;
+}
+
+struct CopyLimit
+{
+    CopyLimit(int v = 0) : val(v) {}
+    CopyLimit(const CopyLimit& other) : val(other.val)
+    {
+        if (--budget < 0)
+            throw std::runtime_error("copy limit");
+    }
+
+    int val;
+
+    static int budget;
+};
+
+int CopyLimit::budget = 0;
+
+/// Forward iterator over ints that throws once its steps run out.
+struct StepLimit
+{
+    typedef std::forward_iterator_tag iterator_category;
+    typedef int                       value_type;
+    typedef std::ptrdiff_t            difference_type;
+    typedef const int*                pointer;
+    typedef const int&                reference;
+
+    explicit StepLimit(const int* p = NULL) : ptr(p) {}
+
+    reference operator*() const { return *ptr; }
+    StepLimit& operator++()
+    {
+        if (--budget < 0)
+            throw std::runtime_error("step limit");
+        ++ptr;
+        return *this;
+    }
+    StepLimit operator++(int) { StepLimit tmp(*this); ++*this; return tmp; }
+    bool operator==(const StepLimit& other) const { return ptr == other.ptr; }
+    bool operator!=(const StepLimit& other) const { return ptr != other.ptr; }
+
+    const int* ptr;
+
+    static int budget;
+};
+
+int StepLimit::budget = 0;
+
+} // namespace
+
+TEST(MapSortedBuild, BalancedAndColoured)
+{
+    const int sizes[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 15, 16, 17, 100, 1023, 1024, 1025, 5000 };
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k)
+    {
+        std::vector<ft::pair<int, int> > values;
+        for (int i = 0; i < sizes[k]; ++i)
+            values.push_back(ft::make_pair(i * 3, i));
+
+        ft::map<int, int> detected(values.begin(), values.end());
+        ft::map<int, int> tagged(ft::sorted_unique, values.begin(), values.end());
+        ASSERT_TRUE(rb_valid(detected)) << sizes[k];
+        ASSERT_TRUE(rb_valid(tagged)) << sizes[k];
+        ASSERT_EQ(detected.size(), size_t(sizes[k]));
+        ASSERT_TRUE(detected == tagged);
+        for (int i = 0; i < sizes[k]; ++i)
+            ASSERT_EQ(tagged.find(i * 3)->second, i);
+
+        // the tree keeps working as an ordinary one
+        for (int i = 0; i < sizes[k]; i += 2)
+            tagged.erase(i * 3);
+        for (int i = 0; i < 50; ++i)
+            tagged[i * 3 + 1] = i;
+        ASSERT_TRUE(rb_valid(tagged)) << sizes[k];
+        ASSERT_EQ(tagged.size(), size_t(sizes[k] - (sizes[k] + 1) / 2 + 50));
+    }
+}
+
+TEST(MapSortedBuild, FallsBack)
+{
+    // out of order, duplicate keys, a non-empty map, a single pass range
+    std::list<ft::pair<int, int> > unsorted;
+    for (int i = 0; i < 100; ++i)
+        unsorted.push_back(ft::make_pair(i * 37 % 100, i));
+    unsorted.push_back(ft::make_pair(5, -1));
+    ft::map<int, int> from_unsorted(unsorted.begin(), unsorted.end());
+    EXPECT_EQ(from_unsorted.size(), 100);
+    EXPECT_NE(from_unsorted[5], -1);
+    EXPECT_TRUE(rb_valid(from_unsorted));
+
+    std::vector<ft::pair<int, int> > sorted;
+    for (int i = 0; i < 100; ++i)
+        sorted.push_back(ft::make_pair(i, i));
+    ft::map<int, int> non_empty;
+    non_empty[-5] = 0;
+    non_empty[50] = -50;
+    non_empty.insert(ft::sorted_unique, sorted.begin(), sorted.end());
+    EXPECT_EQ(non_empty.size(), 101);
+    EXPECT_EQ(non_empty[50], -50);
+    EXPECT_TRUE(rb_valid(non_empty));
+
+    std::istringstream in("1 2 3 5 8");
+    ft::set<int> from_stream((std::istream_iterator<int>(in)), std::istream_iterator<int>());
+    EXPECT_EQ(from_stream.size(), 5);
+    EXPECT_TRUE(rb_valid(from_stream));
+
+    ft::set<int> tagged_set(ft::sorted_unique, from_stream.begin(), from_stream.end());
+    EXPECT_TRUE(tagged_set == from_stream);
+}
+
+TEST(MapSortedBuild, SinglePassRange)
+{
+    // counting the range would use it up, the values go in one by one
+    std::istringstream set_in("1 2 3 4 5");
+    ft::set<int> set(ft::sorted_unique, std::istream_iterator<int>(set_in),
+                     std::istream_iterator<int>());
+    ASSERT_EQ(set.size(), 5);
+    EXPECT_TRUE(rb_valid(set));
+    int expected = 1;
+    for (ft::set<int>::iterator it = set.begin(); it != set.end(); ++it)
+        EXPECT_EQ(*it, expected++);
+
+    std::ostringstream out;
+    for (int i = 0; i < 1000; ++i)
+        out << i * 2 << ' ';
+    std::istringstream keys_in(out.str());
+    ft::set<int> keys;
+    keys.insert(ft::sorted_unique, std::istream_iterator<int>(keys_in),
+                std::istream_iterator<int>());
+    ASSERT_EQ(keys.size(), 1000);
+    EXPECT_TRUE(rb_valid(keys));
+    EXPECT_EQ(*keys.begin(), 0);
+    EXPECT_EQ(*keys.rbegin(), 1998);
+}
+
+TEST(MapSortedBuild, ThrowingCopy)
+{
+    std::vector<ft::pair<int, CopyLimit> > values;
+    CopyLimit::budget = 1 << 20;
+    for (int i = 0; i < 300; ++i)
+        values.push_back(ft::make_pair(i, CopyLimit(i)));
+
+    ft::map<int, CopyLimit> map;
+    CopyLimit::budget = 200;
+    EXPECT_THROW(map.insert(ft::sorted_unique, values.begin(), values.end()),
+                 std::runtime_error);
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(rb_valid(map));
+    EXPECT_EQ(map.pool_stats().live_nodes, 0);
+
+    CopyLimit::budget = 300;
+    map.insert(ft::sorted_unique, values.begin(), values.end());
+    EXPECT_EQ(map.size(), 300);
+    EXPECT_EQ(map[299].val, 299);
+}
+
+TEST(MapSortedBuild, ThrowingIncrement)
+{
+    std::vector<int> values;
+    for (int i = 0; i < 300; ++i)
+        values.push_back(i);
+    const StepLimit first(&values[0]), last(&values[0] + values.size());
+
+    // the first 300 steps go to counting the range
+    ft::set<int> set;
+    for (int steps = 300; steps < 600; steps += 37)
+    {
+        StepLimit::budget = steps;
+        EXPECT_THROW(set.insert(ft::sorted_unique, first, last), std::runtime_error);
+        EXPECT_TRUE(set.empty());
+        EXPECT_TRUE(rb_valid(set));
+        EXPECT_EQ(set.pool_stats().live_nodes, 0);
+    }
+
+    StepLimit::budget = 600;
+    set.insert(ft::sorted_unique, first, last);
+    EXPECT_EQ(set.size(), 300);
+    EXPECT_TRUE(rb_valid(set));
+}
+
+/// hinted insert
+
+namespace
+{
+
+struct CountingLess
+{
+    bool operator()(int a, int b) const { ++calls(); return a < b; }
+
+    static size_t& calls()
+    {
+        static size_t n = 0;
+        return n;
+    }
+};
+
+} // namespace
+
+TEST(MapHint, AppendsAtEnd)
+{
+    ft::map<int, int, CountingLess> map;
+    CountingLess::calls() = 0;
+    for (int i = 0; i < 10000; ++i)
+        map.insert(map.end(), ft::make_pair(i, i));
+    // one comparison finds the slot, one more picks its side
+    EXPECT_LE(CountingLess::calls(), 2u * 10000);
+    EXPECT_EQ(map.size(), 10000);
+    EXPECT_TRUE(rb_valid(map));
+
+    // descending keys hinted at begin() take the leftmost slot
+    ft::set<int, CountingLess> set;
+    CountingLess::calls() = 0;
+    for (int i = 10000; i > 0; --i)
+        set.insert(set.begin(), i);
+    EXPECT_LE(CountingLess::calls(), 3u * 10000);
+    EXPECT_EQ(*set.begin(), 1);
+    EXPECT_TRUE(rb_valid(set));
+}
+
+TEST(MapHint, AnyHintKeepsTheTree)
+{
+    std::map<int, int> std_map;
+    ft::map<int, int>  map;
+    for (int i = 0; i < 2000; i += 10)
+    {
+        std_map[i] = i;
+        map[i] = i;
+    }
+
+    // hints before, after and far away from the key, including nodes
+    // with a left subtree the new node must not replace
+    unsigned x = 12345;
+    for (int i = 0; i < 5000; ++i)
+    {
+        x = x * 1103515245 + 12345;
+        int key = static_cast<int>(x >> 8) % 3000;
+        ft::map<int, int>::iterator hint = map.lower_bound(static_cast<int>(x >> 4) % 3000);
+        if (i % 3 == 0)
+            hint = map.find(key);
+        if (hint == map.end() && i % 2)
+            hint = map.begin();
+        ft::map<int, int>::iterator it = map.insert(hint, ft::make_pair(key, i));
+        std_map.insert(std::make_pair(key, i));
+        ASSERT_EQ(it->first, key);
+        ASSERT_EQ(it->second, std_map[key]);
+    }
+    ASSERT_TRUE(rb_valid(map));
+    ASSERT_EQ(map.size(), std_map.size());
+    EXPECT_EQ(compare_iters(std_map.begin(), std_map.end(), map.begin(), map.end()), 0);
+
+    // emplace_hint goes through the same slot search
+    ft::map<int, int>::iterator it = map.emplace_hint(map.find(1000), 1001, -1);
+    EXPECT_EQ(it->first, 1001);
+    EXPECT_TRUE(rb_valid(map));
+}
+
+/// three-way comparison
+
+namespace
+{
+
+struct CountingCompare3
+{
+    bool operator()(int a, int b) const { ++less_calls(); return a < b; }
+    int compare3(const int& a, const int& b) const { ++calls(); return (a > b) - (a < b); }
+
+    static size_t& calls()
+    {
+        static size_t n = 0;
+        return n;
+    }
+
+    static size_t& less_calls()
+    {
+        static size_t n = 0;
+        return n;
+    }
+};
+
+} // namespace
+
+TEST(MapCompare3, Detection)
+{
+    EXPECT_TRUE((ft::has_compare3<CountingCompare3, int>::value));
+    EXPECT_FALSE((ft::has_compare3<CountingLess, int>::value));
+    EXPECT_FALSE((ft::has_compare3<ft::less<int>, int>::value));
+    EXPECT_TRUE((ft::has_compare3<ft::less<std::string>, std::string>::value));
+    EXPECT_TRUE((ft::has_compare3<ft::less<ft::vector<unsigned char> >,
+                                  ft::vector<unsigned char> >::value));
+    EXPECT_FALSE((ft::has_compare3<ft::less<ft::vector<char> >, ft::vector<char> >::value));
+}
+
+TEST(MapCompare3, OneCallPerLevel)
+{
+    ft::map<int, int, CountingCompare3> map;
+    for (int i = 0; i < 4096; ++i)
+        map[(i * 2654435761u) % 100000] = i;
+    ASSERT_TRUE(rb_valid(map));
+    const size_t height = 2 * 13;
+
+    CountingCompare3::calls() = 0;
+    CountingCompare3::less_calls() = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        ft::map<int, int, CountingCompare3>::iterator it = map.find((i * 2654435761u) % 100000);
+        ASSERT_TRUE(it != map.end());
+        ASSERT_EQ(it->second, i);
+        map.find(-i);
+        map.insert(ft::make_pair(100000 + i, i));
+    }
+    EXPECT_EQ(CountingCompare3::less_calls(), 0u);
+    EXPECT_LE(CountingCompare3::calls(), 3 * 1000 * height);
+    EXPECT_TRUE(rb_valid(map));
+
+    // two-way comparisons walk down to a leaf and check the bound once
+    // more, three-way ones stop at the key
+    ft::map<int, int, CountingLess> plain;
+    for (int i = 0; i < 4096; ++i)
+        plain[(i * 2654435761u) % 100000] = i;
+    CountingLess::calls() = 0;
+    for (int i = 0; i < 1000; ++i)
+        plain.find((i * 2654435761u) % 100000);
+    size_t plain_calls = CountingLess::calls();
+    EXPECT_LE(plain_calls, 1000 * (height + 1));
+    CountingCompare3::calls() = 0;
+    for (int i = 0; i < 1000; ++i)
+        map.find((i * 2654435761u) % 100000);
+    EXPECT_LT(CountingCompare3::calls() + 1000, plain_calls);
+}
+
+TEST(MapCompare3, StringKeys)
+{
+    std::map<std::string, int> std_map;
+    ft::map<std::string, int>  map;
+    for (int i = 0; i < 3000; ++i)
+    {
+        std::ostringstream key;
+        key << std::string(i % 40, '/') << (i * 7919) % 1000 << (i % 3 ? "" : "\xff");
+        std_map[key.str()] = i;
+        map[key.str()] = i;
+    }
+    ASSERT_TRUE(rb_valid(map));
+    ASSERT_EQ(map.size(), std_map.size());
+    EXPECT_EQ(compare_iters(std_map.begin(), std_map.end(), map.begin(), map.end()), 0);
+    for (std::map<std::string, int>::iterator it = std_map.begin(); it != std_map.end(); ++it)
+    {
+        ASSERT_EQ(map.count(it->first), 1u);
+        ASSERT_EQ(map.lower_bound(it->first)->second, it->second);
+        ASSERT_EQ(map.count(it->first + "x"), std_map.count(it->first + "x"));
+    }
+    EXPECT_EQ(map.erase("//////"), std_map.erase("//////"));
+}
+
+TEST(MapCompare3, ByteVectorKeys)
+{
+    typedef ft::vector<unsigned char> bytes;
+    ft::map<bytes, int> map;
+    std::map<std::vector<unsigned char>, int> std_map;
+    for (int i = 0; i < 2000; ++i)
+    {
+        bytes key(i % 7, static_cast<unsigned char>(0x7f));
+        key.push_back(static_cast<unsigned char>(i * 37));
+        map[key] = i;
+        std_map[std::vector<unsigned char>(key.begin(), key.end())] = i;
+    }
+    ASSERT_TRUE(rb_valid(map));
+    ASSERT_EQ(map.size(), std_map.size());
+
+    // bytes past 0x7f order after it, shorter prefixes first
+    std::map<std::vector<unsigned char>, int>::iterator std_it = std_map.begin();
+    for (ft::map<bytes, int>::iterator it = map.begin(); it != map.end(); ++it, ++std_it)
+    {
+        ASSERT_TRUE(std::equal(it->first.begin(), it->first.end(), std_it->first.begin()));
+        ASSERT_EQ(it->second, std_it->second);
+    }
+    EXPECT_TRUE(map.find(bytes()) == map.end());
+    EXPECT_TRUE(map.lower_bound(bytes()) == map.begin());
+}
@@ -0,0 +1,106 @@
+#include "bench.h"
+#include "../persistent_vector.hpp"
+#include "../vector.hpp"
+
+#include <cstdio>
+#include <vector>
+
+BENCHMARK(persistent_vector, snapshot)
+{
+    const size_t n = Bench::scaled(size_t(1) << 20);
+    const size_t edits = 1000;
+    ft::vector<int> table;
+    for (size_t i = 0; i < n; ++i)
+        table.push_back(static_cast<int>(i));
+    ft::persistent_vector<int> ptable(table);
+
+    // every edit keeps the previous version as a snapshot
+    double base = Bench::measure([&]() {
+        std::vector<ft::vector<int> > snapshots(1, table);
+        for (size_t i = 0; i < edits; ++i)
+        {
+            snapshots.push_back(snapshots.back());
+            snapshots.back()[i * 7919 % n] = -1;
+        }
+        Bench::do_not_optimize(snapshots.back()[0]);
+    }, 1);
+    Bench::report("1000 edited snapshots of 1M, ft::vector", base);
+    Bench::report_ratio("1000 edited snapshots of 1M, persistent", base, Bench::measure([&]() {
+        std::vector<ft::persistent_vector<int> > snapshots(1, ptable);
+        for (size_t i = 0; i < edits; ++i)
+            snapshots.push_back(snapshots.back().set(i * 7919 % n, -1));
+        Bench::do_not_optimize(snapshots.back()[0]);
+    }, 1));
+}
+
+BENCHMARK(persistent_vector, build)
+{
+    const size_t n = Bench::scaled(size_t(4) << 20);
+
+    double base = Bench::measure([&]() {
+        ft::vector<int> v;
+        for (size_t i = 0; i < n; ++i)
+            v.push_back(static_cast<int>(i));
+        Bench::do_not_optimize(v.back());
+    });
+    Bench::report("push_back 4M, ft::vector", base);
+    Bench::report_ratio("push_back 4M, new version each", base, Bench::measure([&]() {
+        ft::persistent_vector<int> v;
+        for (size_t i = 0; i < n; ++i)
+            v = v.push_back(static_cast<int>(i));
+        Bench::do_not_optimize(v.back());
+    }));
+    Bench::report_ratio("push_back 4M, transient", base, Bench::measure([&]() {
+        ft::persistent_vector<int>::transient_type t = ft::persistent_vector<int>().transient();
+        for (size_t i = 0; i < n; ++i)
+            t.push_back(static_cast<int>(i));
+        Bench::do_not_optimize(t.persistent().back());
+    }));
+}
+
+BENCHMARK(persistent_vector, read)
+{
+    const size_t n = Bench::scaled(size_t(4) << 20);
+    ft::vector<int> vec;
+    for (size_t i = 0; i < n; ++i)
+        vec.push_back(static_cast<int>(i));
+    ft::persistent_vector<int> pvec(vec);
+
+    std::vector<size_t> order(n);
+    size_t x = 88172645463325252ull;
+    for (size_t i = 0; i < n; ++i)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        order[i] = x % n;
+    }
+
+    double base = Bench::measure([&]() {
+        long sum = 0;
+        for (size_t i = 0; i < n; ++i)
+            sum += vec[order[i]];
+        Bench::do_not_optimize(sum);
+    });
+    Bench::report("random index, ft::vector", base);
+    Bench::report_ratio("random index, persistent", base, Bench::measure([&]() {
+        long sum = 0;
+        for (size_t i = 0; i < n; ++i)
+            sum += pvec[order[i]];
+        Bench::do_not_optimize(sum);
+    }));
+
+    base = Bench::measure([&]() {
+        long sum = 0;
+        for (ft::vector<int>::iterator it = vec.begin(); it != vec.end(); ++it)
+            sum += *it;
+        Bench::do_not_optimize(sum);
+    });
+    Bench::report("iterate, ft::vector", base);
+    Bench::report_ratio("iterate, persistent", base, Bench::measure([&]() {
+        long sum = 0;
+        for (ft::persistent_vector<int>::const_iterator it = pvec.begin(); it != pvec.end(); ++it)
+            sum += *it;
+        Bench::do_not_optimize(sum);
+    }));
+}
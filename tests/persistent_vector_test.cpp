@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "test_types.h"
+#include "../persistent_vector.hpp"
+
+#ifdef FT_CXX11
+
+/// helpers
+
+/// std::allocator that tracks live blocks and throws once its budget of
+/// allocations runs out, a negative budget never does. Every rebound copy
+/// shares the counters.
+struct AllocationBudget
+{
+    static long& budget() { static long n = -1; return n; }
+    static long& live()   { static long n = 0;  return n; }
+};
+
+template <typename _Tp>
+struct BudgetAllocator : public std::allocator<_Tp>
+{
+    template <typename _Up>
+    struct rebind { typedef BudgetAllocator<_Up> other; };
+
+    BudgetAllocator()
+    {}
+
+    template <typename _Up>
+    BudgetAllocator(const BudgetAllocator<_Up>&)
+    {}
+
+    _Tp* allocate(size_t n, const void* = 0)
+    {
+        if (AllocationBudget::budget() == 0)
+            throw std::bad_alloc();
+        --AllocationBudget::budget();
+        ++AllocationBudget::live();
+        return std::allocator<_Tp>::allocate(n);
+    }
+
+    void deallocate(_Tp* p, size_t n)
+    {
+        --AllocationBudget::live();
+        std::allocator<_Tp>::deallocate(p, n);
+    }
+};
+
+/// Tests
+
+TEST(PersistentVector, PushBackKeepsVersions)
+{
+    std::vector<ft::persistent_vector<int> > versions(1);
+    std::vector<int>                         std_vec;
+
+    // past 32 * 32 + 32 elements the trie grows a third level
+    for (int i = 0; i < 1200; ++i)
+        versions.push_back(versions.back().push_back(i * 2));
+    for (int i = 0; i <= 1200; i += 37)
+    {
+        std_vec.resize(i);
+        for (int k = 0; k < i; ++k)
+            std_vec[k] = k * 2;
+        TestTypes::compare_sequence(versions[i], std_vec);
+    }
+    EXPECT_EQ(versions[1200].back(), 2398);
+    EXPECT_EQ(versions[1200].front(), 0);
+    EXPECT_THROW(versions[5].at(5), std::out_of_range);
+}
+
+TEST(PersistentVector, SetAndPopBack)
+{
+    std::vector<int> std_vec;
+    for (int i = 0; i < 2000; ++i)
+        std_vec.push_back(i);
+    ft::persistent_vector<int> base(std_vec.begin(), std_vec.end());
+
+    ft::persistent_vector<int> edited = base.set(0, -1).set(1500, -2).set(1999, -3);
+    TestTypes::compare_sequence(base, std_vec);
+    EXPECT_EQ(edited[0], -1);
+    EXPECT_EQ(edited[1500], -2);
+    EXPECT_EQ(edited[1999], -3);
+    EXPECT_EQ(edited[1000], 1000);
+    EXPECT_THROW(base.set(2000, 0), std::out_of_range);
+
+    // popping across the tail, leaf and level boundaries
+    ft::persistent_vector<int> popped = base;
+    while (popped.size() > 1)
+    {
+        popped = popped.pop_back();
+        std_vec.pop_back();
+        if (popped.size() % 97 == 0 || popped.size() % 32 <= 1)
+            TestTypes::compare_sequence(popped, std_vec);
+    }
+    EXPECT_EQ(base.size(), 2000u);
+    EXPECT_EQ(base[1999], 1999);
+    EXPECT_TRUE(popped.pop_back().empty());
+}
+
+TEST(PersistentVector, PopBackDeepTrie)
+{
+    // more than 32 * 32 * 32 elements, so the root sits three levels up
+    std::vector<int> std_vec;
+    for (int i = 0; i < 1029 * 32 + 1; ++i)
+        std_vec.push_back(i);
+    ft::persistent_vector<int> base(std_vec.begin(), std_vec.end());
+
+    ft::persistent_vector<int> popped = base.pop_back();
+    std_vec.pop_back();
+    TestTypes::compare_sequence(popped, std_vec);
+    EXPECT_EQ(popped[32768], 32768);
+    EXPECT_EQ(popped[32895], 32895);
+
+    ft::persistent_vector<int>::transient_type t = popped.transient();
+    while (t.size() > 1)
+    {
+        t.pop_back();
+        std_vec.pop_back();
+        if (t.size() % 1024 <= 1)
+            TestTypes::compare_sequence(t.persistent(), std_vec);
+    }
+    EXPECT_EQ(base.size(), 1029u * 32 + 1);
+    EXPECT_EQ(base[32928], 32928);
+}
+
+TEST(PersistentVector, TransientBatch)
+{
+    ft::persistent_vector<std::string> base;
+    ft::persistent_vector<std::string>::transient_type t = base.transient();
+
+    for (int i = 0; i < 3000; ++i)
+        t.push_back(std::string(i % 20, 'a'));
+    ft::persistent_vector<std::string> snapshot = t.persistent();
+
+    t.set(0, "changed").set(2999, "last");
+    t.pop_back();
+    t.push_back("again");
+
+    EXPECT_TRUE(base.empty());
+    EXPECT_EQ(snapshot.size(), 3000u);
+    EXPECT_EQ(snapshot[0], "");
+    EXPECT_EQ(snapshot[2999], std::string(2999 % 20, 'a'));
+
+    ft::persistent_vector<std::string> after = t.persistent();
+    EXPECT_EQ(after.size(), 3000u);
+    EXPECT_EQ(after[0], "changed");
+    EXPECT_EQ(after[2999], "again");
+    EXPECT_EQ(after[1500], snapshot[1500]);
+}
+
+TEST(PersistentVector, SharesStructure)
+{
+    typedef TestTypes::CountingAllocator<int> Alloc;
+
+    ft::persistent_vector<int, Alloc> base;
+    for (int i = 0; i < 32 * 32 * 4; ++i)
+        base = std::move(base).push_back(i);
+
+    // a copy allocates nothing, a set copies the path to one leaf
+    TestTypes::CountingAllocator<ft::persistent_trie::inner>::allocations() = 0;
+    TestTypes::CountingAllocator<ft::persistent_trie::leaf<int> >::allocations() = 0;
+    ft::persistent_vector<int, Alloc> copy(base);
+    ft::persistent_vector<int, Alloc> edited = copy.set(100, -1);
+    EXPECT_EQ(TestTypes::CountingAllocator<ft::persistent_trie::inner>::allocations(), 2u);
+    EXPECT_EQ(TestTypes::CountingAllocator<ft::persistent_trie::leaf<int> >::allocations(), 1u);
+    EXPECT_EQ(base[100], 100);
+    EXPECT_EQ(edited[100], -1);
+}
+
+TEST(PersistentVector, VectorInterop)
+{
+    ft::vector<int> vec;
+    for (int i = 0; i < 500; ++i)
+        vec.push_back(i * i);
+
+    ft::persistent_vector<int> pvec(vec);
+    EXPECT_EQ(pvec.size(), vec.size());
+    EXPECT_TRUE(pvec.to_vector() == vec);
+
+    ft::vector<int> from_iters(pvec.begin(), pvec.end());
+    EXPECT_TRUE(from_iters == vec);
+
+    ft::persistent_vector<int>::const_iterator it = pvec.begin() + 40;
+    EXPECT_EQ(*it, 1600);
+    it -= 9;
+    EXPECT_EQ(*it, 961);
+    EXPECT_EQ(it[1], 1024);
+    EXPECT_EQ(pvec.end() - it, 469);
+
+    int i = 499;
+    for (ft::persistent_vector<int>::const_reverse_iterator rit = pvec.rbegin();
+         rit != pvec.rend(); ++rit, --i)
+        ASSERT_EQ(*rit, i * i);
+}
+
+TEST(PersistentVector, FailedRootGrowthLeaksNothing)
+{
+    typedef ft::persistent_vector<int, BudgetAllocator<int> > budget_vector;
+
+    // 32 * 32 + 32 elements: the next push overflows the two level trie
+    std::vector<int> std_vec;
+    for (int i = 0; i < 1056; ++i)
+        std_vec.push_back(i);
+    budget_vector pvec(std_vec.begin(), std_vec.end());
+    long live = AllocationBudget::live();
+
+    // the push needs a leaf, a new root and the path below it
+    for (long budget = 0; budget < 3; ++budget)
+    {
+        AllocationBudget::budget() = budget;
+        EXPECT_THROW(pvec.push_back(1056), std::bad_alloc);
+        AllocationBudget::budget() = -1;
+        ASSERT_EQ(AllocationBudget::live(), live) << "budget " << budget;
+    }
+    budget_vector grown = pvec.push_back(1056);
+    std_vec.push_back(1056);
+    TestTypes::compare_sequence(grown, std_vec);
+}
+
+TEST(PersistentVector, Compare)
+{
+    ft::persistent_vector<int> a;
+    for (int i = 0; i < 100; ++i)
+        a = a.push_back(i);
+    ft::persistent_vector<int> b = a;
+
+    EXPECT_TRUE(a == b);
+    b = b.set(99, 1000);
+    EXPECT_TRUE(a != b);
+    EXPECT_TRUE(a < b);
+    EXPECT_TRUE(b >= a);
+    a.swap(b);
+    EXPECT_TRUE(a > b);
+    EXPECT_EQ(a[99], 1000);
+}
+
+#endif
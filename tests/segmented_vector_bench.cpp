@@ -0,0 +1,116 @@
+#include "bench.h"
+#include "../segmented_vector.hpp"
+#include "../vector.hpp"
+
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+
+struct Buffer
+{
+    int  idx;
+    char buff[4096];
+};
+
+/// Appends `count` values to _Container and reports the time and the
+/// slowest single push_back.
+template <typename _Container>
+double append(const char* what, size_t count,
+              const typename _Container::value_type& val, double base)
+{
+    double worst = 0;
+    double ms = Bench::measure([&]() {
+        _Container c;
+        for (size_t i = 0; i < count; ++i)
+        {
+            Bench::Timer t;
+            c.push_back(val);
+            double push_ms = t.ms();
+            if (push_ms > worst)
+                worst = push_ms;
+        }
+        Bench::do_not_optimize(c.back());
+    }, 1);
+
+    char note[64];
+    if (base)
+        std::snprintf(note, sizeof(note), "x%.2f, slowest push %.3f ms", base / ms, worst);
+    else
+        std::snprintf(note, sizeof(note), "slowest push %.3f ms", worst);
+    Bench::report(what, ms, note);
+    return ms;
+}
+
+template <typename _Tp>
+void append_workload(const char* type, size_t count, const _Tp& val)
+{
+    char label[96];
+
+    std::snprintf(label, sizeof(label), "%s x %zu, ft::vector", type, count);
+    double base = append<ft::vector<_Tp> >(label, count, val, 0);
+    std::snprintf(label, sizeof(label), "%s x %zu, ft::segmented_vector", type, count);
+    append<ft::segmented_vector<_Tp> >(label, count, val, base);
+}
+
+template <typename _Container>
+double iterate(const _Container& c)
+{
+    return Bench::measure([&]() {
+        long sum = 0;
+        for (typename _Container::const_iterator it = c.begin(); it != c.end(); ++it)
+            sum += *it;
+        Bench::do_not_optimize(sum);
+    });
+}
+
+template <typename _Container>
+double index(const _Container& c, const std::vector<size_t>& order)
+{
+    return Bench::measure([&]() {
+        long sum = 0;
+        for (size_t i = 0; i < order.size(); ++i)
+            sum += c[order[i]];
+        Bench::do_not_optimize(sum);
+    });
+}
+
+} // namespace
+
+BENCHMARK(segmented_vector, append)
+{
+    Buffer buffer = Buffer();
+
+    append_workload<int>("int", Bench::scaled(size_t(16) << 20), 42);
+    append_workload<Buffer>("Buffer", Bench::scaled(size_t(1) << 17), buffer);
+}
+
+BENCHMARK(segmented_vector, traverse)
+{
+    const size_t count = Bench::scaled(size_t(16) << 20);
+    ft::vector<int>           vec;
+    ft::segmented_vector<int> seg;
+    for (size_t i = 0; i < count; ++i)
+    {
+        vec.push_back(static_cast<int>(i));
+        seg.push_back(static_cast<int>(i));
+    }
+
+    double base = iterate(vec);
+    Bench::report("iterate, ft::vector", base);
+    Bench::report_ratio("iterate, ft::segmented_vector", base, iterate(seg));
+
+    std::vector<size_t> order(count);
+    size_t x = 88172645463325252ull;
+    for (size_t i = 0; i < count; ++i)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        order[i] = x % count;
+    }
+    base = index(vec, order);
+    Bench::report("random index, ft::vector", base);
+    Bench::report_ratio("random index, ft::segmented_vector", base, index(seg, order));
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "test_types.h"
+#include "../segmented_vector.hpp"
+
+/// Tests
+
+TEST(SegmentedVector, IndexAcrossSegments)
+{
+    std::vector<int>                        std_vec;
+    ft::segmented_vector<int, std::allocator<int>, 4> ft_vec;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        std_vec.push_back(i * 3);
+        ft_vec.push_back(i * 3);
+    }
+    TestTypes::compare_sequence(ft_vec, std_vec);
+    // 4 + 8 + ... + 1024 >= 1000
+    EXPECT_EQ(ft_vec.segment_count(), 8u);
+    EXPECT_EQ(ft_vec.capacity(), 1020u);
+    EXPECT_EQ(ft_vec.front(), 0);
+    EXPECT_EQ(ft_vec.back(), 2997);
+    EXPECT_THROW(ft_vec.at(1000), std::out_of_range);
+
+    for (int i = 0; i < 700; ++i)
+    {
+        std_vec.pop_back();
+        ft_vec.pop_back();
+    }
+    ft_vec.push_back(-1);
+    std_vec.push_back(-1);
+    TestTypes::compare_sequence(ft_vec, std_vec);
+}
+
+TEST(SegmentedVector, ReferencesStayValid)
+{
+    ft::segmented_vector<std::string> vec;
+    std::vector<std::string*>         addresses;
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        vec.push_back(std::string(20, 'a' + i % 26));
+        addresses.push_back(&vec.back());
+    }
+    for (int i = 0; i < 5000; ++i)
+    {
+        ASSERT_EQ(addresses[i], &vec[i]);
+        ASSERT_EQ(*addresses[i], std::string(20, 'a' + i % 26));
+    }
+}
+
+TEST(SegmentedVector, LogarithmicAllocations)
+{
+    typedef TestTypes::CountingAllocator<int> Alloc;
+
+    Alloc::allocations() = 0;
+    TestTypes::CountingAllocator<int*>::allocations() = 0;
+    {
+        ft::segmented_vector<int, Alloc> vec;
+        for (int i = 0; i < 100000; ++i)
+            vec.push_back(i);
+        // 16 + 32 + ... + (16 << 12) >= 100000, no copies on the way
+        EXPECT_EQ(vec.segment_count(), 13u);
+        EXPECT_EQ(Alloc::allocations(), 13u);
+        EXPECT_EQ(TestTypes::CountingAllocator<int*>::allocations(), 1u);
+    }
+}
+
+TEST(SegmentedVector, Iterators)
+{
+    std::vector<int>          std_vec;
+    ft::segmented_vector<int> ft_vec;
+
+    for (int i = 0; i < 777; ++i)
+    {
+        int val = (i * 7919) % 1000;
+        std_vec.push_back(val);
+        ft_vec.push_back(val);
+    }
+
+    ft::segmented_vector<int>::iterator it = ft_vec.begin();
+    EXPECT_EQ(ft_vec.end() - it, 777);
+    EXPECT_EQ(it[100], std_vec[100]);
+    it += 500;
+    EXPECT_EQ(*it, std_vec[500]);
+    it -= 490;
+    EXPECT_EQ(*it, std_vec[10]);
+    --it;
+    EXPECT_EQ(*it, std_vec[9]);
+    EXPECT_TRUE(ft_vec.begin() < it);
+    EXPECT_TRUE(it == ft_vec.begin() + 9);
+
+    // walk down across every segment boundary
+    std::vector<int>::reverse_iterator std_rit = std_vec.rbegin();
+    for (ft::segmented_vector<int>::reverse_iterator rit = ft_vec.rbegin();
+         rit != ft_vec.rend(); ++rit)
+        ASSERT_EQ(*rit, *std_rit++);
+
+    std::sort(std_vec.begin(), std_vec.end());
+    std::sort(ft_vec.begin(), ft_vec.end());
+    TestTypes::compare_sequence(ft_vec, std_vec);
+
+    const ft::segmented_vector<int>&          const_vec = ft_vec;
+    ft::segmented_vector<int>::const_iterator cit = ft_vec.begin();
+    EXPECT_TRUE(cit == ft_vec.begin());
+    EXPECT_EQ(std::count(cit, const_vec.end(), std_vec[0]),
+              std::count(std_vec.begin(), std_vec.end(), std_vec[0]));
+}
+
+TEST(SegmentedVector, CopySwapCompare)
+{
+    ft::segmented_vector<std::string> a;
+    for (int i = 0; i < 300; ++i)
+        a.push_back(std::string(i % 40, 'x'));
+
+    ft::segmented_vector<std::string> b(a);
+    EXPECT_TRUE(a == b);
+    b.back() = "y";
+    EXPECT_TRUE(a != b);
+    EXPECT_TRUE(a < b);
+
+    ft::segmented_vector<std::string> c(5, "z");
+    std::string* first = &c.front();
+    c.swap(b);
+    EXPECT_EQ(b.size(), 5u);
+    EXPECT_EQ(&b.front(), first);
+    EXPECT_EQ(c.back(), "y");
+    c = a;
+    EXPECT_TRUE(c == a);
+
+    ft::segmented_vector<std::string> d(a.begin(), a.begin() + 10);
+    EXPECT_EQ(d.size(), 10u);
+    EXPECT_TRUE(d <= a);
+    d.assign(3, "w");
+    EXPECT_EQ(d.size(), 3u);
+    EXPECT_EQ(d[2], "w");
+}
+
+TEST(SegmentedVector, ReserveAndShrink)
+{
+    ft::segmented_vector<int> vec;
+
+    vec.reserve(100);
+    EXPECT_EQ(vec.capacity(), 112u);
+    int* slot = NULL;
+    for (int i = 0; i < 100; ++i)
+    {
+        vec.push_back(i);
+        if (i == 50)
+            slot = &vec[50];
+    }
+    EXPECT_EQ(vec.capacity(), 112u);
+    EXPECT_EQ(&vec[50], slot);
+
+    vec.resize(20);
+    EXPECT_EQ(vec.size(), 20u);
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 48u);
+    EXPECT_EQ(vec[19], 19);
+    vec.push_back(20);
+    EXPECT_EQ(vec[20], 20);
+
+    vec.resize(30, 7);
+    EXPECT_EQ(vec[29], 7);
+    vec.clear();
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 0u);
+    vec.push_back(1);
+    EXPECT_EQ(vec.front(), 1);
+}
@@ -790,3 +790,62 @@ REGISTER_TYPED_TEST_SUITE_P(SetTest,
 );
 
 INSTANTIATE_TYPED_TEST_SUITE_P(SetInstance, SetTest, TestTypes::TestSetTypes);
+
+/// move semantics
+
+TEST(SetMove, MoveConstructor)
+{
+    ft::set<std::string> src;
+    for (int i = 0; i < 100; ++i)
+        src.insert(std::string(i + 1, 'x'));
+
+    ft::set<std::string> dst(std::move(src));
+    EXPECT_EQ(dst.size(), 100);
+    EXPECT_TRUE(src.empty());
+    EXPECT_EQ(src.begin(), src.end());
+
+    src = std::move(dst);
+    EXPECT_EQ(src.size(), 100);
+    EXPECT_TRUE(dst.empty());
+}
+
+TEST(SetMove, Emplace)
+{
+    typedef TestTypes::MoveTracked tracked;
+
+    ft::set<tracked> set;
+    tracked::reset();
+
+    EXPECT_TRUE(set.emplace(2).second);
+    EXPECT_FALSE(set.emplace(2).second);
+    EXPECT_TRUE(set.insert(tracked(1)).second);
+    EXPECT_EQ(set.emplace_hint(set.end(), 3)->val, 3);
+
+    EXPECT_EQ(set.size(), 3);
+    EXPECT_EQ(set.begin()->val, 1);
+    EXPECT_EQ(tracked::copies(), 0);
+}
+
+/// node pool
+
+TEST(SetNodePool, ReleaseUnused)
+{
+    ft::set<int> set;
+    set.node_slab_size(128);
+    for (int i = 0; i < 5000; ++i)
+        set.insert(i);
+    ft::set<int>::pool_stats_type stats = set.pool_stats();
+    EXPECT_EQ(stats.live_nodes, 5000);
+
+    set.erase(set.begin(), set.find(4000));
+    EXPECT_GE(set.pool_stats().cached_nodes, 4000);
+    EXPECT_GT(set.release_unused(), 0);
+    stats = set.pool_stats();
+    EXPECT_EQ(stats.live_nodes, 1000);
+    EXPECT_LE(stats.cached_nodes, 2 * 128);
+    EXPECT_EQ(*set.begin(), 4000);
+
+    set.clear();
+    set.shrink_to_fit();
+    EXPECT_EQ(set.pool_stats().reserved_bytes, 0);
+}
@@ -0,0 +1,52 @@
+#include "bench.h"
+#include "../vector.hpp"
+#include "../small_vector.hpp"
+
+#include <cstdio>
+#include <string>
+
+namespace
+{
+
+typedef Bench::CountingAllocator<int> counting_alloc;
+
+/// Builds `count` short-lived vectors of `len` ints each, the way a request
+/// handler fills a scratch vector, and reports the time and the number of
+/// allocate() calls per vector.
+template <typename _Vec>
+void short_lived(const char* what, size_t count, size_t len)
+{
+    counting_alloc::allocations() = 0;
+    double ms = Bench::measure([&]() {
+        for (size_t i = 0; i < count; ++i)
+        {
+            _Vec v;
+            for (size_t j = 0; j < len; ++j)
+                v.push_back(static_cast<int>(j));
+            Bench::do_not_optimize(v[len - 1]);
+        }
+    });
+
+    char label[64];
+    char note[32];
+    std::snprintf(label, sizeof(label), "%s len=%zu", what, len);
+    std::snprintf(note, sizeof(note), "allocs/vector=%.2f",
+                  counting_alloc::allocations() / (3.0 * count));
+    Bench::report(label, ms, note);
+}
+
+} // namespace
+
+BENCHMARK(small_vector, short_lived)
+{
+    const size_t count = Bench::scaled(1000000);
+    const size_t lens[] = { 4, 8, 16, 17, 64 };
+
+    for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); ++i)
+    {
+        short_lived<ft::vector<int, counting_alloc> >(
+            "ft::vector<int>", count, lens[i]);
+        short_lived<ft::small_vector<int, 16, counting_alloc> >(
+            "ft::small_vector<int, 16>", count, lens[i]);
+    }
+}
@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include "test_types.h"
+#include "../small_vector.hpp"
+
+/// helpers
+
+typedef TestTypes::Fragile Fragile;
+
+/// Tests
+
+TEST(SmallVector, InlineUntilN)
+{
+    typedef TestTypes::CountingAllocator<int> alloc_type;
+
+    ft::small_vector<int, 16, alloc_type> vec;
+    alloc_type::allocations() = 0;
+
+    EXPECT_EQ(vec.capacity(), 16);
+    for (int i = 0; i < 16; ++i)
+        vec.push_back(i);
+    EXPECT_TRUE(vec.is_inline());
+    EXPECT_EQ(alloc_type::allocations(), 0);
+
+    vec.push_back(16);
+    EXPECT_FALSE(vec.is_inline());
+    EXPECT_EQ(alloc_type::allocations(), 1);
+    EXPECT_EQ(vec.capacity(), 32);
+    for (int i = 0; i < 17; ++i)
+        ASSERT_EQ(vec[i], i);
+}
+
+TEST(SmallVector, Modifiers)
+{
+    std::vector<std::string>        std_vec;
+    ft::small_vector<std::string, 4> ft_vec;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        std_vec.push_back(std::string(i + 1, 'a' + i));
+        ft_vec.push_back(std::string(i + 1, 'a' + i));
+    }
+    std_vec.insert(std_vec.begin() + 1, 3, "fill");
+    ft_vec.insert(ft_vec.begin() + 1, 3, "fill");
+    TestTypes::compare_sequence(ft_vec, std_vec);
+
+    std::vector<std::string> range(std_vec.begin(), std_vec.begin() + 2);
+    std_vec.insert(std_vec.end(), range.begin(), range.end());
+    ft_vec.insert(ft_vec.end(), range.begin(), range.end());
+    TestTypes::compare_sequence(ft_vec, std_vec);
+
+    std_vec.erase(std_vec.begin() + 2, std_vec.begin() + 5);
+    ft_vec.erase(ft_vec.begin() + 2, ft_vec.begin() + 5);
+    std_vec.erase(std_vec.begin());
+    ft_vec.erase(ft_vec.begin());
+    std_vec.pop_back();
+    ft_vec.pop_back();
+    TestTypes::compare_sequence(ft_vec, std_vec);
+
+    std_vec.resize(10, "resized");
+    ft_vec.resize(10, "resized");
+    TestTypes::compare_sequence(ft_vec, std_vec);
+
+    std_vec.assign(2, "assigned");
+    ft_vec.assign(2, "assigned");
+    TestTypes::compare_sequence(ft_vec, std_vec);
+
+    ft_vec.clear();
+    EXPECT_TRUE(ft_vec.empty());
+    EXPECT_THROW(ft_vec.at(0), std::out_of_range);
+}
+
+TEST(SmallVector, CopyAndMove)
+{
+    ft::small_vector<std::string, 4> small(3, "small");
+    ft::small_vector<std::string, 4> large(40, "large");
+
+    ft::small_vector<std::string, 4> small_copy(small);
+    ft::small_vector<std::string, 4> large_copy(large);
+    EXPECT_TRUE(small_copy == small);
+    EXPECT_TRUE(large_copy == large);
+    EXPECT_TRUE(small_copy.is_inline());
+
+    const std::string* heap = &large[0];
+    ft::small_vector<std::string, 4> moved(std::move(large));
+    EXPECT_EQ(&moved[0], heap);
+    EXPECT_TRUE(large.empty());
+    EXPECT_TRUE(large.is_inline());
+
+    moved = std::move(small);
+    EXPECT_TRUE(moved.is_inline());
+    EXPECT_TRUE(moved == small_copy);
+    EXPECT_TRUE(small.empty());
+}
+
+TEST(SmallVector, Swap)
+{
+    std::vector<int> a_vals, b_vals, c_vals, d_vals;
+    ft::small_vector<int, 8> a, b, c, d;
+
+    for (int i = 0; i < 3; ++i)
+    { a.push_back(i); a_vals.push_back(i); }
+    for (int i = 0; i < 6; ++i)
+    { b.push_back(-i); b_vals.push_back(-i); }
+    for (int i = 0; i < 20; ++i)
+    { c.push_back(i * 2); c_vals.push_back(i * 2); }
+    for (int i = 0; i < 30; ++i)
+    { d.push_back(i * 3); d_vals.push_back(i * 3); }
+
+    // inline with inline
+    a.swap(b);
+    TestTypes::compare_sequence(a, b_vals);
+    TestTypes::compare_sequence(b, a_vals);
+
+    // inline with heap, both ways
+    a.swap(c);
+    TestTypes::compare_sequence(a, c_vals);
+    TestTypes::compare_sequence(c, b_vals);
+    EXPECT_TRUE(c.is_inline());
+    ft::swap(c, a);
+    TestTypes::compare_sequence(a, b_vals);
+    TestTypes::compare_sequence(c, c_vals);
+
+    // heap with heap
+    const int* c_data = c.data();
+    c.swap(d);
+    TestTypes::compare_sequence(c, d_vals);
+    TestTypes::compare_sequence(d, c_vals);
+    EXPECT_EQ(d.data(), c_data);
+}
+
+TEST(SmallVector, CompareOperators)
+{
+    int values[] = { 1, 2, 3, 4 };
+    ft::small_vector<int, 2> a(values, values + 4);
+    ft::small_vector<int, 2> b(values, values + 3);
+
+    EXPECT_FALSE(a == b);
+    EXPECT_TRUE(a != b);
+    EXPECT_TRUE(b < a);
+    EXPECT_TRUE(b <= a);
+    EXPECT_TRUE(a > b);
+    EXPECT_TRUE(a >= b);
+
+    b.push_back(4);
+    EXPECT_TRUE(a == b);
+    EXPECT_TRUE(a <= b);
+    EXPECT_FALSE(a < b);
+}
+
+TEST(SmallVector, ReverseIterator)
+{
+    ft::small_vector<int, 4> vec;
+    for (int i = 0; i < 10; ++i)
+        vec.push_back(i);
+
+    int expected = 9;
+    for (ft::small_vector<int, 4>::reverse_iterator it = vec.rbegin();
+         it != vec.rend(); ++it)
+        ASSERT_EQ(*it, expected--);
+}
+
+TEST(SmallVector, SinglePassRanges)
+{
+    typedef std::istream_iterator<int> in_iter;
+
+    std::istringstream ctor_in("1 2 3 4 5 6");
+    ft::small_vector<int, 4> vec((in_iter(ctor_in)), in_iter());
+    std::istringstream mid_in("-1 -2");
+    vec.insert(vec.begin() + 1, in_iter(mid_in), in_iter());
+
+    int expected[] = { 1, -1, -2, 2, 3, 4, 5, 6 };
+    TestTypes::compare_sequence(vec, std::vector<int>(expected, expected + 8));
+}
+
+TEST(SmallVector, ThrowingInsertRollsBack)
+{
+    {
+        ft::small_vector<Fragile, 4> vec;
+        for (int i = 0; i < 6; ++i)
+            vec.push_back(Fragile(i));
+        vec.reserve(16);
+
+        Fragile::copies_left() = 2;
+        EXPECT_THROW(vec.insert(vec.begin() + 2, 5, Fragile(-1)), std::runtime_error);
+        Fragile src[] = { Fragile(-1), Fragile(-2), Fragile(-3), Fragile(-4) };
+        Fragile::copies_left() = 3;
+        EXPECT_THROW(vec.insert(vec.begin() + 1, src, src + 4), std::runtime_error);
+        Fragile::copies_left() = -1;
+
+        ASSERT_EQ(vec.size(), 6);
+        for (int i = 0; i < 6; ++i)
+            EXPECT_EQ(vec[i].val, i);
+        EXPECT_EQ(Fragile::live(), 6 + 4);
+    }
+    EXPECT_EQ(Fragile::live(), 0);
+}
+
+TEST(SmallVector, ThrowingConstructorsLeakNothing)
+{
+    // both throw after spilling to the heap
+    Fragile::copies_left() = 7;
+    EXPECT_THROW((ft::small_vector<Fragile, 4>(10, Fragile(-1))), std::runtime_error);
+    EXPECT_EQ(Fragile::live(), 0);
+
+    {
+        Fragile::copies_left() = -1;
+        ft::small_vector<Fragile, 4> vec(10, Fragile(-1));
+        Fragile::copies_left() = 6;
+        EXPECT_THROW((ft::small_vector<Fragile, 4>(vec)), std::runtime_error);
+        Fragile::copies_left() = -1;
+        EXPECT_EQ(Fragile::live(), 10);
+    }
+    EXPECT_EQ(Fragile::live(), 0);
+}
@@ -0,0 +1,85 @@
+#include "bench.h"
+#include "../soa_vector.hpp"
+#include "../vector.hpp"
+
+#include <string>
+
+namespace
+{
+
+/// A 64 byte record of which the scans read one or two fields.
+struct Record
+{
+    double price;
+    double quantity;
+    int    id;
+    int    flags;
+    char   name[40];
+};
+
+/// The same fields, minus the name, one column each.
+typedef ft::soa_vector<double, double, int, int> record_columns;
+
+} // namespace
+
+BENCHMARK(soa_vector, hot_column_scan)
+{
+    const size_t count = Bench::scaled(size_t(4) << 20);
+    const size_t reps = 10;
+
+    ft::vector<Record> rows;
+    record_columns     columns;
+    Record             r = Record();
+    for (size_t i = 0; i < count; ++i)
+    {
+        r.price = i * 0.25;
+        r.quantity = double(i % 100);
+        r.id = static_cast<int>(i);
+        rows.push_back(r);
+        columns.push_back(r.price, r.quantity, r.id, r.flags);
+    }
+    const record_columns& cols = columns;
+
+    double aos = Bench::measure([&]() {
+        for (size_t k = 0; k < reps; ++k)
+        {
+            double sum = 0;
+            for (size_t i = 0; i < count; ++i)
+                sum += rows[i].price;
+            Bench::do_not_optimize(sum);
+        }
+    });
+    Bench::report("sum(price), ft::vector<Record>", aos);
+    Bench::report_ratio("sum(price), soa_vector column", aos, Bench::measure([&]() {
+        for (size_t k = 0; k < reps; ++k)
+        {
+            ft::column_span<const double> price = cols.column<0>();
+            double sum = 0;
+            for (size_t i = 0; i < price.size(); ++i)
+                sum += price[i];
+            Bench::do_not_optimize(sum);
+        }
+    }));
+
+    aos = Bench::measure([&]() {
+        for (size_t k = 0; k < reps; ++k)
+        {
+            double sum = 0;
+            for (size_t i = 0; i < count; ++i)
+                sum += rows[i].price * rows[i].quantity;
+            Bench::do_not_optimize(sum);
+        }
+    });
+    Bench::report("sum(price * quantity), ft::vector<Record>", aos);
+    Bench::report_ratio("sum(price * quantity), soa_vector columns", aos, Bench::measure([&]() {
+        for (size_t k = 0; k < reps; ++k)
+        {
+            ft::column_span<const double> price = cols.column<0>();
+            ft::column_span<const double> quantity = cols.column<1>();
+            double sum = 0;
+            for (size_t i = 0; i < price.size(); ++i)
+                sum += price[i] * quantity[i];
+            Bench::do_not_optimize(sum);
+        }
+    }));
+}
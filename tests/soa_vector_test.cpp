@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include "test_types.h"
+#include "../soa_vector.hpp"
+
+/// helpers
+
+typedef ft::soa_vector<int, double, std::string> record_vector;
+
+record_vector make_records(int n)
+{
+    record_vector records;
+    for (int i = 0; i < n; ++i)
+        records.push_back(i, i * 0.5, std::string(i % 7, 'r'));
+    return records;
+}
+
+/// Tests
+
+TEST(SoaVector, Columns)
+{
+    record_vector records = make_records(1000);
+
+    ASSERT_EQ(records.size(), 1000);
+    EXPECT_GE(records.capacity(), 1000);
+
+    ft::column_span<double> prices = records.column<1>();
+    ASSERT_EQ(prices.size(), 1000);
+    EXPECT_EQ(reinterpret_cast<size_t>(prices.data()) % 64, 0);
+    double sum = 0;
+    for (double* p = prices.begin(); p != prices.end(); ++p)
+        sum += *p;
+    EXPECT_EQ(sum, 0.5 * 999 * 1000 / 2);
+
+    // writes through a span land in the rows
+    records.column<0>()[10] = -10;
+    EXPECT_EQ(records.get<0>(10), -10);
+    EXPECT_EQ(records[10].get<0>(), -10);
+
+    const record_vector& ref = records;
+    ft::column_span<const std::string> names = ref.column<2>();
+    EXPECT_EQ(names[13], "rrrrrr");
+    EXPECT_TRUE(record_vector().column<0>().empty());
+}
+
+TEST(SoaVector, RowReferences)
+{
+    record_vector records = make_records(10);
+
+    std::tuple<int, double, std::string> row = records[3];
+    EXPECT_EQ(std::get<0>(row), 3);
+    EXPECT_EQ(std::get<2>(row), "rrr");
+
+    // assigning through a reference writes the row
+    records[4] = std::make_tuple(40, 4.5, std::string("four"));
+    EXPECT_EQ(records.get<0>(4), 40);
+    EXPECT_EQ(records.get<2>(4), "four");
+    records[5] = records[4];
+    EXPECT_EQ(records.get<2>(5), "four");
+    EXPECT_TRUE(records[4] == records[5]);
+    EXPECT_TRUE(records[3] < records[4]);
+
+    EXPECT_EQ(records.at(9).get<0>(), 9);
+    EXPECT_THROW(records.at(10), std::out_of_range);
+    EXPECT_EQ(records.front().get<0>(), 0);
+    EXPECT_EQ(records.back().get<0>(), 9);
+}
+
+TEST(SoaVector, Iterators)
+{
+    record_vector records = make_records(100);
+
+    int expected = 0;
+    for (record_vector::const_iterator it = records.begin(); it != records.end(); ++it)
+        ASSERT_EQ((*it).get<0>(), expected++);
+
+    expected = 99;
+    for (record_vector::reverse_iterator it = records.rbegin(); it != records.rend(); ++it)
+        ASSERT_EQ((*it).get<0>(), expected--);
+
+    record_vector::iterator it = records.begin() + 10;
+    EXPECT_EQ(it - records.begin(), 10);
+    EXPECT_EQ(it[5].get<0>(), 15);
+    EXPECT_TRUE(records.begin() < it);
+    EXPECT_EQ((*(records.rbegin() + 1)).get<0>(), 98);
+
+    // std algorithms move whole rows
+    std::reverse(records.begin(), records.end());
+    EXPECT_EQ(records.get<0>(0), 99);
+    EXPECT_EQ(records.get<2>(0), std::string(99 % 7, 'r'));
+    std::sort(records.begin(), records.end());
+    for (int i = 0; i < 100; ++i)
+        ASSERT_EQ(records.get<0>(i), i);
+}
+
+TEST(SoaVector, Modifiers)
+{
+    record_vector records = make_records(10);
+
+    records.insert(records.begin() + 2, std::make_tuple(-1, -1.0, std::string("new")));
+    ASSERT_EQ(records.size(), 11);
+    EXPECT_EQ(records.get<2>(2), "new");
+    EXPECT_EQ(records.get<0>(3), 2);
+
+    records.erase(records.begin(), records.begin() + 3);
+    ASSERT_EQ(records.size(), 8);
+    EXPECT_EQ(records.get<0>(0), 2);
+
+    records.pop_back();
+    EXPECT_EQ(records.back().get<0>(), 8);
+
+    records.resize(20, std::make_tuple(7, 7.0, std::string("seven")));
+    EXPECT_EQ(records.get<2>(19), "seven");
+    records.resize(2);
+    EXPECT_EQ(records.size(), 2);
+
+    record_vector other = make_records(3);
+    ft::swap(records, other);
+    EXPECT_EQ(records.size(), 3);
+    EXPECT_EQ(other.size(), 2);
+
+    records.clear();
+    EXPECT_TRUE(records.empty());
+    records.shrink_to_fit();
+    EXPECT_EQ(records.capacity(), 0);
+}
+
+TEST(SoaVector, CompareOperators)
+{
+    record_vector a = make_records(5);
+    record_vector b = make_records(4);
+
+    EXPECT_FALSE(a == b);
+    EXPECT_TRUE(a != b);
+    EXPECT_TRUE(b < a);
+    EXPECT_TRUE(a > b);
+    EXPECT_TRUE(b <= a);
+    EXPECT_TRUE(a >= b);
+
+    b.push_back(4, 2.0, "rrrr");
+    EXPECT_TRUE(a == b);
+    b[4].get<1>() = 2.5;
+    EXPECT_TRUE(a < b);
+}
+
+namespace
+{
+
+/// Copy constructor throws once armed and the budget ran out.
+struct Fragile
+{
+    Fragile(int v = 0) : val(v) {}
+    Fragile(const Fragile& other) : val(other.val)
+    {
+        if (armed && budget-- == 0)
+            throw std::runtime_error("fragile");
+    }
+    Fragile& operator=(const Fragile& other) { val = other.val; return *this; }
+    bool operator==(const Fragile& other) const { return val == other.val; }
+    bool operator<(const Fragile& other) const { return val < other.val; }
+
+    int val;
+
+    static bool armed;
+    static int  budget;
+};
+
+bool Fragile::armed = false;
+int  Fragile::budget = 0;
+
+} // namespace
+
+TEST(SoaVector, ColumnsStayAligned)
+{
+    ft::soa_vector<int, Fragile> vec;
+    for (int i = 0; i < 4; ++i)
+        vec.push_back(i, Fragile(i));
+
+    Fragile::armed = true;
+    Fragile::budget = 0;
+    EXPECT_THROW(vec.push_back(4, Fragile(4)), std::runtime_error);
+    EXPECT_EQ(vec.size(), 4);
+    EXPECT_EQ(vec.column<0>().size(), 4);
+    EXPECT_EQ(vec.column<1>().size(), 4);
+
+    Fragile::budget = 0;
+    EXPECT_THROW(vec.resize(8), std::runtime_error);
+    EXPECT_EQ(vec.column<0>().size(), 4);
+    EXPECT_EQ(vec.column<1>().size(), 4);
+    Fragile::armed = false;
+
+    EXPECT_EQ(vec.get<1>(3).val, 3);
+}
@@ -242,3 +242,19 @@ REGISTER_TYPED_TEST_SUITE_P(StackTest,
 );
 
 INSTANTIATE_TYPED_TEST_SUITE_P(StackInstance, StackTest, TestTypes::TestVectorTypes);
+
+/// move semantics
+
+TEST(StackMove, PushRvalueAndEmplace)
+{
+    typedef TestTypes::MoveTracked tracked;
+
+    ft::stack<tracked> stack;
+    tracked::reset();
+
+    stack.push(tracked(1));
+    stack.emplace(2);
+    EXPECT_EQ(stack.size(), 2);
+    EXPECT_EQ(stack.top().val, 2);
+    EXPECT_EQ(tracked::copies(), 0);
+}
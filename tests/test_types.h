@@ -4,12 +4,14 @@
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wwrite-strings"
 
+#include <gtest/gtest.h>
 #include <iostream>
 
 #include <string>
 #include <cstddef>
 #include <cstdlib>
 #include <ctime>
+#include <stdexcept>
 
 #include <vector>
 #include "../vector.hpp"
@@ -150,6 +152,136 @@ private:
     std::string _val;
 };
 
+/// counts copies and moves, used to check the C++11 members
+
+struct MoveTracked
+{
+    MoveTracked(int v = 0)
+        : val(v)
+    {}
+
+    MoveTracked(const MoveTracked& other)
+        : val(other.val)
+    { ++copies(); }
+
+    MoveTracked(MoveTracked&& other)
+        : val(other.val)
+    {
+        other.val = -1;
+        ++moves();
+    }
+
+    MoveTracked& operator=(const MoveTracked& other)
+    {
+        val = other.val;
+        ++copies();
+        return *this;
+    }
+
+    MoveTracked& operator=(MoveTracked&& other)
+    {
+        val = other.val;
+        other.val = -1;
+        ++moves();
+        return *this;
+    }
+
+    bool operator==(const MoveTracked& other) const { return val == other.val; }
+    bool operator!=(const MoveTracked& other) const { return val != other.val; }
+    bool operator<(const MoveTracked& other) const { return val < other.val; }
+
+    static size_t& copies()
+    {
+        static size_t n = 0;
+        return n;
+    }
+
+    static size_t& moves()
+    {
+        static size_t n = 0;
+        return n;
+    }
+
+    static void reset()
+    { copies() = moves() = 0; }
+
+    int val;
+};
+
+/// counts live objects; copies of negative values throw once copies_left()
+/// runs out, the moves that shift a tail never do
+
+struct Fragile
+{
+    Fragile(int v = 0) : val(v) { ++live(); }
+    Fragile(const Fragile& other) : val(other.val)
+    {
+        if (val < 0 && copies_left() == 0)
+            throw std::runtime_error("copy");
+        if (val < 0)
+            --copies_left();
+        ++live();
+    }
+    ~Fragile() { --live(); }
+
+    Fragile& operator=(const Fragile& other)
+    {
+        val = other.val;
+        return *this;
+    }
+
+    bool operator==(const Fragile& other) const { return val == other.val; }
+
+    int val;
+
+    static int& live()        { static int n = 0;  return n; }
+    static int& copies_left() { static int n = -1; return n; }
+};
+
+/// std::allocator that counts the calls to allocate()
+
+template <typename _Tp>
+struct CountingAllocator : public std::allocator<_Tp>
+{
+    template <typename _Up>
+    struct rebind { typedef CountingAllocator<_Up> other; };
+
+    CountingAllocator()
+    {}
+
+    template <typename _Up>
+    CountingAllocator(const CountingAllocator<_Up>&)
+    {}
+
+    _Tp* allocate(size_t n, const void* = 0)
+    {
+        ++allocations();
+        return std::allocator<_Tp>::allocate(n);
+    }
+
+    static size_t& allocations()
+    {
+        static size_t n = 0;
+        return n;
+    }
+};
+
+/// checks a sequence container against its std counterpart, by index and
+/// by iterator
+
+template <typename _FtSeq, typename _StdSeq>
+void compare_sequence(const _FtSeq& ft_seq, const _StdSeq& std_seq)
+{
+    ASSERT_EQ(ft_seq.size(), std_seq.size());
+    ASSERT_EQ(ft_seq.empty(), std_seq.empty());
+    for (size_t i = 0; i < std_seq.size(); ++i)
+        ASSERT_EQ(ft_seq[i], std_seq[i]) << "index " << i;
+
+    typename _StdSeq::const_iterator std_it = std_seq.begin();
+    for (typename _FtSeq::const_iterator it = ft_seq.begin(); it != ft_seq.end(); ++it)
+        ASSERT_EQ(*it, *std_it++);
+}
+
 /// random set generators
 
 template <typename T, typename Gen>
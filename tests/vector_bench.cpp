@@ -0,0 +1,524 @@
+#include "bench.h"
+#include "../allocator.hpp"
+#include "../vector.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct Buffer
+{
+    int  idx;
+    char buff[4096];
+};
+
+/// Same layout as _Tp, but its user-provided copy constructor keeps
+/// ft::vector on the element-by-element relocation path.
+template <typename _Tp>
+struct NonRelocatable
+{
+    NonRelocatable() : value() {}
+    NonRelocatable(const _Tp& v) : value(v) {}
+    NonRelocatable(const NonRelocatable& other) : value(other.value) {}
+
+    NonRelocatable& operator=(const NonRelocatable& other)
+    {
+        value = other.value;
+        return *this;
+    }
+
+    _Tp value;
+};
+
+template <typename _Vec>
+double growth(size_t count, const typename _Vec::value_type& val)
+{
+    return Bench::measure([&]() {
+        _Vec v;
+        for (size_t i = 0; i < count; ++i)
+            v.push_back(val);
+        Bench::do_not_optimize(v[count - 1]);
+    });
+}
+
+template <typename _Vec>
+double middle_insert(size_t size, size_t inserts,
+                     const typename _Vec::value_type& val)
+{
+    return Bench::measure([&]() {
+        _Vec v(size, val);
+        for (size_t i = 0; i < inserts; ++i)
+            v.insert(v.begin() + v.size() / 2, val);
+        Bench::do_not_optimize(v[0]);
+    });
+}
+
+/// Fills a vector of `count` Buffers the way main.cpp does and reports the
+/// reallocations, the bytes they copied and the final capacity.
+template <typename _Policy>
+void buffer_growth(const char* what, size_t count)
+{
+    typedef ft::vector<Buffer, std::allocator<Buffer>,
+                       ft::growth_stats<_Policy> > vec_type;
+
+    size_t reallocations = 0, copied = 0, capacity = 0;
+    double ms = Bench::measure([&]() {
+        vec_type v;
+        Buffer b = Buffer();
+        for (size_t i = 0; i < count; ++i)
+            v.push_back(b);
+        Bench::do_not_optimize(v[count - 1]);
+        reallocations = v.growth_policy().reallocations();
+        copied = v.growth_policy().bytes_copied();
+        capacity = v.capacity();
+    });
+
+    char note[96];
+    std::snprintf(note, sizeof(note), "reallocs=%zu copied=%zuMB capacity=%zuMB",
+                  reallocations, copied >> 20, (capacity * sizeof(Buffer)) >> 20);
+    Bench::report(what, ms, note);
+}
+
+/// main.cpp's MAX_RAM loop: push_back `count` Buffers into a vector that
+/// uses _Alloc.
+template <typename _Alloc>
+void buffer_push_back(const char* what, size_t count)
+{
+    typedef ft::vector<Buffer, _Alloc, ft::growth_stats<> > vec_type;
+
+    size_t copied = 0;
+    double ms = Bench::measure([&]() {
+        vec_type v;
+        for (size_t i = 0; i < count; ++i)
+            v.push_back(Buffer());
+        Bench::do_not_optimize(v[count - 1]);
+        copied = v.growth_policy().bytes_copied();
+    });
+
+    char note[64];
+    std::snprintf(note, sizeof(note), "copied=%zuMB", copied >> 20);
+    Bench::report(what, ms, note);
+}
+
+std::string label(const char* what, size_t n)
+{
+    char n_buf[32];
+    std::snprintf(n_buf, sizeof(n_buf), " n=%zu", n);
+    return std::string(what) + n_buf;
+}
+
+} // namespace
+
+BENCHMARK(vector, relocation_growth)
+{
+    const size_t ints = Bench::scaled(10000000);
+    double slow = growth<ft::vector<NonRelocatable<int> > >(ints, 1);
+    Bench::report(label("push_back int, per-element", ints), slow);
+    Bench::report_ratio(label("push_back int, memcpy", ints), slow,
+                        growth<ft::vector<int> >(ints, 1));
+
+    const size_t buffers = Bench::scaled(16384);
+    Buffer b = Buffer();
+    slow = growth<ft::vector<NonRelocatable<Buffer> > >(buffers, b);
+    Bench::report(label("push_back Buffer, per-element", buffers), slow);
+    Bench::report_ratio(label("push_back Buffer, memcpy", buffers), slow,
+                        growth<ft::vector<Buffer> >(buffers, b));
+}
+
+BENCHMARK(vector, relocation_middle_insert)
+{
+    const size_t ints = Bench::scaled(100000);
+    double slow = middle_insert<ft::vector<NonRelocatable<int> > >(ints, 2000, 1);
+    Bench::report(label("insert(mid) int, per-element", ints), slow);
+    Bench::report_ratio(label("insert(mid) int, memmove", ints), slow,
+                        middle_insert<ft::vector<int> >(ints, 2000, 1));
+
+    const size_t buffers = Bench::scaled(2048);
+    Buffer b = Buffer();
+    slow = middle_insert<ft::vector<NonRelocatable<Buffer> > >(buffers, 200, b);
+    Bench::report(label("insert(mid) Buffer, per-element", buffers), slow);
+    Bench::report_ratio(label("insert(mid) Buffer, memmove", buffers), slow,
+                        middle_insert<ft::vector<Buffer> >(buffers, 200, b));
+}
+
+BENCHMARK(vector, growth_policies)
+{
+    const size_t count = Bench::scaled(100000);
+    std::printf("  %zu Buffers, %zuMB of data\n", count,
+                (count * sizeof(Buffer)) >> 20);
+
+    buffer_growth<ft::growth_2x>("growth_2x", count);
+    buffer_growth<ft::growth_1_5x>("growth_1_5x", count);
+    buffer_growth<ft::growth_page>("growth_page", count);
+    buffer_growth<ft::growth_hugepage<> >("growth_hugepage<64MB>", count);
+}
+
+BENCHMARK(vector, mremap_growth)
+{
+    const size_t count = Bench::scaled(100000);
+    std::printf("  %zu Buffers, %zuMB of data\n", count,
+                (count * sizeof(Buffer)) >> 20);
+
+    buffer_push_back<std::allocator<Buffer> >("std::allocator", count);
+    buffer_push_back<ft::mremap_allocator<Buffer> >("ft::mremap_allocator", count);
+}
+
+BENCHMARK(vector, input_iterator_ingest)
+{
+    typedef std::istream_iterator<int> in_iter;
+
+    const size_t count = Bench::scaled(2000000);
+    std::ostringstream out;
+    for (size_t i = 0; i < count; ++i)
+        out << i % 100000 << ' ';
+    const std::string text = out.str();
+
+    double buffered = Bench::measure([&]() {
+        std::istringstream in(text);
+        std::vector<int> tmp((in_iter(in)), in_iter());
+        ft::vector<int> v(tmp.begin(), tmp.end());
+        Bench::do_not_optimize(v[count - 1]);
+    });
+    Bench::report(label("parse into buffer, then copy", count), buffered);
+
+    Bench::report_ratio(label("parse straight into ft::vector", count), buffered,
+        Bench::measure([&]() {
+            std::istringstream in(text);
+            ft::vector<int> v((in_iter(in)), in_iter());
+            Bench::do_not_optimize(v[count - 1]);
+        }));
+}
+
+BENCHMARK(vector, file_fill)
+{
+    const size_t bytes = Bench::scaled(size_t(256) << 20);
+    const size_t chunk = 64 << 10;
+
+    std::FILE* file = std::tmpfile();
+    if (!file)
+    {
+        std::printf("  no temporary file, skipped\n");
+        return;
+    }
+    std::vector<char> block(chunk, 'x');
+    for (size_t written = 0; written < bytes; written += chunk)
+        std::fwrite(&block[0], 1, chunk, file);
+    std::fflush(file);
+
+    double zeroed = Bench::measure([&]() {
+        std::rewind(file);
+        ft::vector<char> v;
+        v.resize(bytes);
+        Bench::do_not_optimize(std::fread(&v[0], 1, bytes, file));
+    });
+    Bench::report(label("resize + fread", bytes), zeroed);
+
+    Bench::report_ratio(label("resize_default_init + fread", bytes), zeroed,
+        Bench::measure([&]() {
+            std::rewind(file);
+            ft::vector<char> v;
+            v.resize_default_init(bytes);
+            Bench::do_not_optimize(std::fread(&v[0], 1, bytes, file));
+        }));
+
+    Bench::report_ratio(label("reserve + append_uninitialized chunks", bytes), zeroed,
+        Bench::measure([&]() {
+            std::rewind(file);
+            ft::vector<char> v;
+            v.reserve(bytes);
+            for (size_t done = 0; done < bytes; done += chunk)
+                Bench::do_not_optimize(
+                    std::fread(v.append_uninitialized(chunk), 1, chunk, file));
+        }));
+
+    std::fclose(file);
+}
+
+namespace
+{
+
+/// The element loop ft::equal used before the byte kernels.
+template <typename _Vec>
+bool loop_equal(const _Vec& a, const _Vec& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (a[i] != b[i])
+            return false;
+    return true;
+}
+
+template <typename _Vec>
+void compare_equal_vectors(const char* what, size_t bytes)
+{
+    typedef typename _Vec::value_type value_type;
+
+    const size_t n = bytes / sizeof(value_type);
+    _Vec a(n, value_type(1));
+    _Vec b(a);
+    bool eq = true;
+
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%s, element loop", what);
+    double loop = Bench::measure([&]() { eq &= loop_equal(a, b); });
+    Bench::report(label(buf, n), loop);
+
+    std::snprintf(buf, sizeof(buf), "%s, memcmp", what);
+    Bench::report_ratio(label(buf, n), loop, Bench::measure([&]() {
+        eq &= !std::memcmp(&a[0], &b[0], n * sizeof(value_type)); }));
+
+    std::snprintf(buf, sizeof(buf), "%s, operator==", what);
+    Bench::report_ratio(label(buf, n), loop, Bench::measure([&]() {
+        eq &= (a == b); }));
+
+    std::snprintf(buf, sizeof(buf), "%s, operator<", what);
+    Bench::report_ratio(label(buf, n), loop, Bench::measure([&]() {
+        eq &= !(a < b); }));
+    Bench::do_not_optimize(eq);
+}
+
+} // namespace
+
+BENCHMARK(vector, compare)
+{
+    const size_t bytes = Bench::scaled(size_t(64) << 20);
+
+    compare_equal_vectors<ft::vector<unsigned char> >("uchar", bytes);
+    compare_equal_vectors<ft::vector<char> >("char", bytes);
+    compare_equal_vectors<ft::vector<int> >("int", bytes);
+}
+
+namespace
+{
+
+struct Pod16
+{
+    int a, b, c, d;
+};
+
+std::string byte_label(const char* what, size_t bytes)
+{
+    const char* units[] = { "B", "KB", "MB", "GB" };
+    size_t unit = 0;
+    while (unit < 3 && bytes >= 1024 && bytes % 1024 == 0)
+    {
+        bytes /= 1024;
+        ++unit;
+    }
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%s %zu%s", what, bytes, units[unit]);
+    return buf;
+}
+
+/// Time of assign(n, val) over `bytes` of reserved storage, repeated until
+/// about 256MB were written.
+template <typename _Tp>
+double fill_ms(size_t bytes, const _Tp& val)
+{
+    const size_t n = bytes / sizeof(_Tp);
+    const size_t reps = bytes < (size_t(256) << 20) ? (size_t(256) << 20) / bytes : 1;
+
+    ft::vector<_Tp> v;
+    v.reserve(n);
+    return Bench::measure([&]() {
+        for (size_t r = 0; r < reps; ++r)
+        {
+            v.assign(n, val);
+            Bench::do_not_optimize(v[n - 1]);
+        }
+    });
+}
+
+template <typename _Tp>
+void fill_sizes(const char* what, const _Tp& val)
+{
+    const size_t max_bytes = Bench::scaled(size_t(1) << 30);
+
+    for (size_t bytes = 1024; bytes <= max_bytes; bytes <<= 4)
+    {
+        std::string name = byte_label(what, bytes);
+        double slow = fill_ms(bytes, NonRelocatable<_Tp>(val));
+        Bench::report(name + ", element loop", slow);
+        Bench::report_ratio(name + ", ft::simd::fill", slow, fill_ms(bytes, val));
+    }
+}
+
+} // namespace
+
+BENCHMARK(vector, fill)
+{
+    Pod16 pod = { 1, 2, 3, 4 };
+
+    fill_sizes<char>("char 'x'", 'x');
+    fill_sizes<int>("int 0x12345678", 0x12345678);
+    fill_sizes<double>("double 1.5", 1.5);
+    fill_sizes<Pod16>("Pod16 {1,2,3,4}", pod);
+}
+
+namespace
+{
+
+/// Fill constructor and copy constructor of `bytes` of _Tp, on the calling
+/// thread and on a pool of every hardware thread.
+template <typename _Tp>
+void parallel_sizes(const char* what, size_t bytes, const _Tp& val)
+{
+    const size_t         n = bytes / sizeof(_Tp);
+    ft::thread_pool      pool;
+    ft::parallel_policy  par(pool);
+    char                 threads[32];
+
+    std::snprintf(threads, sizeof(threads), ", %zu threads", pool.size());
+
+    std::string name = byte_label(what, bytes);
+    double serial = Bench::measure([&]() {
+        ft::vector<_Tp> v(n, val);
+        Bench::do_not_optimize(v[n - 1]);
+    }, 1);
+    Bench::report(name + " fill, serial", serial);
+    Bench::report_ratio(name + " fill" + threads, serial, Bench::measure([&]() {
+        ft::vector<_Tp> v(n, val, par);
+        Bench::do_not_optimize(v[n - 1]);
+    }, 1));
+
+    ft::vector<_Tp> src(n, val, par);
+    serial = Bench::measure([&]() {
+        ft::vector<_Tp> v(src);
+        Bench::do_not_optimize(v[n - 1]);
+    }, 1);
+    Bench::report(name + " copy, serial", serial);
+    Bench::report_ratio(name + " copy" + threads, serial, Bench::measure([&]() {
+        ft::vector<_Tp> v(src, par);
+        Bench::do_not_optimize(v[n - 1]);
+    }, 1));
+}
+
+} // namespace
+
+BENCHMARK(vector, parallel_construct)
+{
+    const size_t bytes = Bench::scaled(size_t(1) << 30);
+    Buffer buffer;
+
+    std::memset(&buffer, 'x', sizeof(buffer));
+    parallel_sizes<char>("char", bytes, 'x');
+    parallel_sizes<Buffer>("Buffer", bytes, buffer);
+}
+
+BENCHMARK(vector, string_reassign)
+{
+    const size_t n = 10000;
+    const size_t rounds = Bench::scaled(size_t(200));
+    ft::vector<std::string> sources[2];
+    for (size_t i = 0; i < n; ++i)
+    {
+        sources[0].push_back(std::string(40 + i % 24, 'a'));
+        sources[1].push_back(std::string(40 + i % 24, 'b'));
+    }
+    std::vector<std::string> std_sources[2] = {
+        std::vector<std::string>(sources[0].begin(), sources[0].end()),
+        std::vector<std::string>(sources[1].begin(), sources[1].end())
+    };
+
+    // what operator= used to do: destroy everything, construct it again
+    ft::vector<std::string> dst(sources[0]);
+    double base = Bench::measure([&]() {
+        for (size_t r = 0; r < rounds; ++r)
+        {
+            dst.clear();
+            dst.insert(dst.end(), sources[r & 1].begin(), sources[r & 1].end());
+        }
+        Bench::do_not_optimize(dst[0]);
+    });
+    Bench::report("200 x 10k strings, clear + copy", base);
+    Bench::report_ratio("200 x 10k strings, operator=", base, Bench::measure([&]() {
+        for (size_t r = 0; r < rounds; ++r)
+            dst = sources[r & 1];
+        Bench::do_not_optimize(dst[0]);
+    }));
+    Bench::report_ratio("200 x 10k strings, assign(first, last)", base, Bench::measure([&]() {
+        for (size_t r = 0; r < rounds; ++r)
+            dst.assign(std_sources[r & 1].begin(), std_sources[r & 1].end());
+        Bench::do_not_optimize(dst[0]);
+    }));
+    std::vector<std::string> std_dst(std_sources[0]);
+    Bench::report_ratio("200 x 10k strings, std::vector operator=", base, Bench::measure([&]() {
+        for (size_t r = 0; r < rounds; ++r)
+            std_dst = std_sources[r & 1];
+        Bench::do_not_optimize(std_dst[0]);
+    }));
+}
+
+namespace
+{
+
+struct EveryNth
+{
+    explicit EveryNth(int n) : n(n) {}
+    bool operator()(int x) const { return x % n == 0; }
+    int n;
+};
+
+} // namespace
+
+BENCHMARK(vector, erase_if)
+{
+    const size_t n = Bench::scaled(size_t(10000000));
+    ft::vector<int> source;
+    for (size_t i = 0; i < n; ++i)
+        source.push_back(static_cast<int>(i));
+
+    // one element in 10000, the loop shifts the tail for each of them
+    double base = Bench::measure([&]() {
+        ft::vector<int> v(source);
+        for (ft::vector<int>::iterator it = v.begin(); it != v.end(); )
+        {
+            if (*it % 10000 == 0)
+                it = v.erase(it);
+            else
+                ++it;
+        }
+        Bench::do_not_optimize(v[0]);
+    }, 1);
+    Bench::report("10M ints, drop 1/10000, erase(pos) loop", base);
+    Bench::report_ratio("10M ints, drop 1/10000, ft::erase_if", base, Bench::measure([&]() {
+        ft::vector<int> v(source);
+        ft::erase_if(v, EveryNth(10000));
+        Bench::do_not_optimize(v[0]);
+    }, 1));
+
+    base = Bench::measure([&]() {
+        std::vector<int> v(source.begin(), source.end());
+        v.erase(std::remove_if(v.begin(), v.end(), EveryNth(2)), v.end());
+        Bench::do_not_optimize(v[0]);
+    });
+    Bench::report("10M ints, drop 1/2, std::remove_if + erase", base);
+    Bench::report_ratio("10M ints, drop 1/2, ft::erase_if", base, Bench::measure([&]() {
+        ft::vector<int> v(source);
+        ft::erase_if(v, EveryNth(2));
+        Bench::do_not_optimize(v[0]);
+    }));
+
+    ft::vector<std::string> strings;
+    for (size_t i = 0; i < n / 10; ++i)
+        strings.push_back(std::string(20 + i % 20, 'x'));
+    base = Bench::measure([&]() {
+        std::vector<std::string> v(strings.begin(), strings.end());
+        v.erase(std::remove(v.begin(), v.end(), std::string(30, 'x')), v.end());
+        Bench::do_not_optimize(v[0]);
+    });
+    Bench::report("1M strings, drop 1/20, std::remove + erase", base);
+    Bench::report_ratio("1M strings, drop 1/20, ft::erase", base, Bench::measure([&]() {
+        ft::vector<std::string> v(strings);
+        ft::erase(v, std::string(30, 'x'));
+        Bench::do_not_optimize(v[0]);
+    }));
+}
@@ -0,0 +1,123 @@
+#include "bench.h"
+#include "../vector.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+
+/// A bitmap with about one bit in `one_in` set, as packed bits, as the
+/// byte per flag layout ft::vector<bool> used to have, and as
+/// std::vector<bool>.
+struct Bitmaps
+{
+    ft::vector<bool>  packed;
+    ft::vector<char>  bytes;
+    std::vector<bool> std_bits;
+
+    Bitmaps(size_t n, unsigned one_in, unsigned seed)
+    {
+        unsigned x = seed;
+        for (size_t i = 0; i < n; ++i)
+        {
+            x = x * 1103515245u + 12345u;
+            bool bit = (x >> 16) % one_in == 0;
+            packed.push_back(bit);
+            bytes.push_back(bit);
+            std_bits.push_back(bit);
+        }
+    }
+};
+
+} // namespace
+
+BENCHMARK(vector_bool, memory)
+{
+    const size_t n = Bench::scaled(size_t(256) << 20);
+    size_t bytes_mib = 0, packed_mib = 0;
+    char note[64];
+
+    double base = Bench::measure([&]() {
+        ft::vector<char> bytes(n, 1);
+        bytes_mib = bytes.capacity() >> 20;
+        Bench::do_not_optimize(bytes[n - 1]);
+    }, 1);
+    std::snprintf(note, sizeof(note), "%zu MiB", bytes_mib);
+    Bench::report("fill 256M flags, one byte each", base, note);
+
+    double ms = Bench::measure([&]() {
+        ft::vector<bool> packed(n, true);
+        packed_mib = packed.capacity() / 8 >> 20;
+        Bench::do_not_optimize(packed.words()[0]);
+    }, 1);
+    std::snprintf(note, sizeof(note), "x%.2f, %zu MiB", base / ms, packed_mib);
+    Bench::report("fill 256M flags, ft::vector<bool>", ms, note);
+}
+
+BENCHMARK(vector_bool, count)
+{
+    Bitmaps maps(Bench::scaled(size_t(64) << 20), 2, 1);
+
+    double base = Bench::measure([&]() {
+        Bench::do_not_optimize(std::count(maps.bytes.begin(), maps.bytes.end(), 1));
+    });
+    Bench::report("count, one byte each", base);
+    Bench::report_ratio("count, std::vector<bool>", base, Bench::measure([&]() {
+        Bench::do_not_optimize(std::count(maps.std_bits.begin(), maps.std_bits.end(), true));
+    }));
+    Bench::report_ratio("count, ft::vector<bool>", base, Bench::measure([&]() {
+        Bench::do_not_optimize(maps.packed.count());
+    }));
+}
+
+BENCHMARK(vector_bool, scan)
+{
+    Bitmaps maps(Bench::scaled(size_t(64) << 20), 1000, 2);
+
+    double base = Bench::measure([&]() {
+        size_t sum = 0;
+        for (size_t i = 0; i < maps.bytes.size(); ++i)
+            if (maps.bytes[i])
+                sum += i;
+        Bench::do_not_optimize(sum);
+    });
+    Bench::report("set bits 1/1000, one byte each", base);
+    Bench::report_ratio("set bits 1/1000, std::vector<bool>", base, Bench::measure([&]() {
+        size_t sum = 0;
+        for (size_t i = 0; i < maps.std_bits.size(); ++i)
+            if (maps.std_bits[i])
+                sum += i;
+        Bench::do_not_optimize(sum);
+    }));
+    Bench::report_ratio("set bits 1/1000, find_next", base, Bench::measure([&]() {
+        size_t sum = 0;
+        for (size_t i = maps.packed.find_first(); i != maps.packed.npos;
+             i = maps.packed.find_next(i))
+            sum += i;
+        Bench::do_not_optimize(sum);
+    }));
+}
+
+BENCHMARK(vector_bool, bitwise)
+{
+    const size_t n = Bench::scaled(size_t(64) << 20);
+    Bitmaps a(n, 2, 3);
+    Bitmaps b(n, 2, 4);
+
+    double base = Bench::measure([&]() {
+        for (size_t i = 0; i < n; ++i)
+            a.bytes[i] &= b.bytes[i];
+        Bench::do_not_optimize(a.bytes[0]);
+    });
+    Bench::report("a &= b, one byte each", base);
+    Bench::report_ratio("a &= b, ft::vector<bool>", base, Bench::measure([&]() {
+        a.packed &= b.packed;
+        Bench::do_not_optimize(a.packed.words()[0]);
+    }));
+    Bench::report_ratio("a ^= b, ft::vector<bool>", base, Bench::measure([&]() {
+        a.packed ^= b.packed;
+        Bench::do_not_optimize(a.packed.words()[0]);
+    }));
+}
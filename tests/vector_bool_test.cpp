@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "test_types.h"
+#include "../vector.hpp"
+
+/// helpers
+
+void random_bits(ft::vector<bool>& ft_vec, std::vector<bool>& std_vec,
+                 size_t n, int one_in)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        bool bit = std::rand() % one_in == 0;
+        ft_vec.push_back(bit);
+        std_vec.push_back(bit);
+    }
+}
+
+/// Tests
+
+TEST(VectorBool, PackedStorage)
+{
+    ft::vector<bool> vec(1000, true);
+
+    EXPECT_EQ(vec.size(), 1000u);
+    EXPECT_EQ(vec.word_count(), 16u);
+    EXPECT_GE(vec.capacity(), 1000u);
+    EXPECT_EQ(vec.count(), 1000u);
+    // the bits past size() stay clear
+    EXPECT_EQ(vec.words()[15], (ft::vector<bool>::word_type(1) << 40) - 1);
+
+    vec.resize(10);
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 64u);
+    EXPECT_EQ(vec.words()[0], 0x3FFu);
+}
+
+TEST(VectorBool, ProxyReferences)
+{
+    ft::vector<bool> vec(130, false);
+
+    vec[3] = true;
+    vec[129] = vec[3];
+    EXPECT_TRUE(vec[3]);
+    EXPECT_TRUE(vec.back());
+    EXPECT_FALSE(vec.front());
+    vec.front().flip();
+    EXPECT_TRUE(vec[0]);
+    EXPECT_FALSE(~vec[0]);
+
+    ft::vector<bool>::swap(vec[0], vec[1]);
+    EXPECT_FALSE(vec[0]);
+    EXPECT_TRUE(vec[1]);
+
+    EXPECT_THROW(vec.at(130), std::out_of_range);
+    const ft::vector<bool>& cref = vec;
+    EXPECT_TRUE(cref.at(129));
+
+    vec.flip();
+    EXPECT_EQ(vec.count(), 127u);
+    EXPECT_FALSE(vec[3]);
+}
+
+TEST(VectorBool, Modifiers)
+{
+    std::srand(42);
+    ft::vector<bool>  ft_vec;
+    std::vector<bool> std_vec;
+    random_bits(ft_vec, std_vec, 500, 2);
+    TestTypes::compare_sequence(ft_vec, std_vec);
+
+    // inserts and erases at every offset in a word shift by odd amounts
+    for (size_t pos = 0; pos < 200; pos += 7)
+    {
+        ft_vec.insert(ft_vec.begin() + pos, pos % 3 == 0);
+        std_vec.insert(std_vec.begin() + pos, pos % 3 == 0);
+        ft_vec.insert(ft_vec.begin() + pos * 2, 70 + pos, pos % 2 == 0);
+        std_vec.insert(std_vec.begin() + pos * 2, 70 + pos, pos % 2 == 0);
+        TestTypes::compare_sequence(ft_vec, std_vec);
+        ft_vec.erase(ft_vec.begin() + pos, ft_vec.begin() + pos * 2 + 3);
+        std_vec.erase(std_vec.begin() + pos, std_vec.begin() + pos * 2 + 3);
+        ft_vec.erase(ft_vec.begin() + pos / 2);
+        std_vec.erase(std_vec.begin() + pos / 2);
+        TestTypes::compare_sequence(ft_vec, std_vec);
+    }
+
+    std::vector<bool> src(333);
+    for (size_t i = 0; i < src.size(); ++i)
+        src[i] = i % 5 == 0;
+    ft_vec.insert(ft_vec.begin() + 17, src.begin(), src.end());
+    std_vec.insert(std_vec.begin() + 17, src.begin(), src.end());
+    TestTypes::compare_sequence(ft_vec, std_vec);
+
+    while (ft_vec.size() > 100)
+    {
+        ft_vec.pop_back();
+        std_vec.pop_back();
+    }
+    ft_vec.resize(300, true);
+    std_vec.resize(300, true);
+    TestTypes::compare_sequence(ft_vec, std_vec);
+
+    ft_vec.assign(src.begin(), src.end());
+    TestTypes::compare_sequence(ft_vec, src);
+    ft_vec.assign(65, true);
+    EXPECT_EQ(ft_vec.count(), 65u);
+    ft_vec.clear();
+    EXPECT_TRUE(ft_vec.empty());
+    EXPECT_EQ(ft_vec.count(), 0u);
+}
+
+TEST(VectorBool, CountAndFind)
+{
+    std::srand(7);
+    ft::vector<bool>  ft_vec;
+    std::vector<bool> std_vec;
+    random_bits(ft_vec, std_vec, 10000, 97);
+
+    EXPECT_EQ(ft_vec.count(),
+              static_cast<size_t>(std::count(std_vec.begin(), std_vec.end(), true)));
+
+    size_t expected = std::find(std_vec.begin(), std_vec.end(), true) - std_vec.begin();
+    size_t seen = 0;
+    for (size_t i = ft_vec.find_first(); i != ft_vec.npos; i = ft_vec.find_next(i))
+    {
+        ASSERT_EQ(i, expected);
+        ++seen;
+        expected = std::find(std_vec.begin() + i + 1, std_vec.end(), true) - std_vec.begin();
+    }
+    EXPECT_EQ(expected, std_vec.size());
+    EXPECT_EQ(seen, ft_vec.count());
+
+    ft::vector<bool> none(200, false);
+    EXPECT_EQ(none.find_first(), none.npos);
+    none[199] = true;
+    EXPECT_EQ(none.find_first(), 199u);
+    EXPECT_EQ(none.find_next(199), none.npos);
+    EXPECT_EQ(ft::vector<bool>().find_first(), ft::vector<bool>::npos);
+}
+
+TEST(VectorBool, BulkOperations)
+{
+    std::srand(3);
+    ft::vector<bool>  a, b;
+    std::vector<bool> std_a, std_b;
+    random_bits(a, std_a, 4099, 2);
+    random_bits(b, std_b, 4099, 3);
+
+    std::vector<bool> std_and(std_a.size()), std_or(std_a.size()), std_xor(std_a.size());
+    for (size_t i = 0; i < std_a.size(); ++i)
+    {
+        std_and[i] = std_a[i] && std_b[i];
+        std_or[i] = std_a[i] || std_b[i];
+        std_xor[i] = std_a[i] != std_b[i];
+    }
+    TestTypes::compare_sequence(a & b, std_and);
+    TestTypes::compare_sequence(a | b, std_or);
+    TestTypes::compare_sequence(a ^ b, std_xor);
+
+    ft::vector<bool> c(a);
+    c ^= a;
+    EXPECT_EQ(c.count(), 0u);
+    EXPECT_EQ((~a).count(), a.size() - a.count());
+
+    ft::vector<bool> shorter(100, true);
+    EXPECT_THROW(shorter &= a, std::invalid_argument);
+}
+
+TEST(VectorBool, Iterators)
+{
+    ft::vector<bool> vec;
+    for (int i = 0; i < 200; ++i)
+        vec.push_back(i % 3 == 0);
+
+    ft::vector<bool>::iterator it = vec.begin();
+    EXPECT_EQ(vec.end() - it, 200);
+    it += 130;
+    EXPECT_EQ(bool(*it), 130 % 3 == 0);
+    it -= 66;
+    EXPECT_EQ(bool(*it), 64 % 3 == 0);
+    --it;
+    EXPECT_TRUE(*it);
+    EXPECT_EQ(it - vec.begin(), 63);
+    EXPECT_TRUE(vec.begin() < it);
+    *it = false;
+    EXPECT_FALSE(vec[63]);
+
+    size_t i = 199;
+    for (ft::vector<bool>::reverse_iterator rit = vec.rbegin(); rit != vec.rend(); ++rit, --i)
+        ASSERT_EQ(bool(*rit), i != 63 && i % 3 == 0);
+
+    std::fill(vec.begin() + 10, vec.begin() + 150, true);
+    EXPECT_EQ(static_cast<size_t>(std::count(vec.begin(), vec.end(), true)), vec.count());
+}
+
+TEST(VectorBool, CopySwapCompare)
+{
+    ft::vector<bool> a(100, false);
+    a[50] = true;
+    ft::vector<bool> b(a);
+    EXPECT_TRUE(a == b);
+    EXPECT_FALSE(a < b);
+
+    b[40] = true;
+    EXPECT_TRUE(a != b);
+    EXPECT_TRUE(a < b);
+    EXPECT_TRUE(b > a);
+
+    ft::vector<bool> c(a.begin(), a.begin() + 60);
+    EXPECT_TRUE(c < a);
+    c.push_back(true);
+    EXPECT_TRUE(a < c);
+
+    c.swap(b);
+    EXPECT_EQ(c.size(), 100u);
+    EXPECT_EQ(b.size(), 61u);
+    b = a;
+    EXPECT_TRUE(b == a);
+    EXPECT_TRUE(b <= a);
+    EXPECT_TRUE(b >= a);
+}
+
+TEST(VectorBool, EraseIf)
+{
+    ft::vector<bool> bits;
+    for (int i = 0; i < 300; ++i)
+        bits.push_back(i % 3 == 0);
+
+    struct IsClear
+    {
+        bool operator()(bool b) const { return !b; }
+    };
+    EXPECT_EQ(ft::erase_if(bits, IsClear()), 200u);
+    EXPECT_EQ(bits.size(), 100u);
+    EXPECT_EQ(bits.count(), 100u);
+
+    bits.push_back(false);
+    bits.push_back(false);
+    EXPECT_EQ(ft::erase(bits, true), 100u);
+    EXPECT_EQ(bits.size(), 2u);
+    EXPECT_EQ(bits.count(), 0u);
+}
@@ -1,8 +1,15 @@
 #include <gtest/gtest.h>
 #include <typeinfo>
 #include "test_types.h"
+#include "../allocator.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <stdexcept>
 
 /// defines
 
@@ -443,6 +450,13 @@ TYPED_TEST_P(VectorTest, EraseRange)
     this->ft_vec.erase(this->ft_vec.end(), this->ft_vec.end());
     COMPARE_TEST(this->ft_vec, this->std_vec);
 
+    if (TestFixture::size > 2)
+    {
+        this->std_vec.erase(this->std_vec.begin() + 1, this->std_vec.end() - 1);
+        this->ft_vec.erase(this->ft_vec.begin() + 1, this->ft_vec.end() - 1);
+        COMPARE_TEST(this->ft_vec, this->std_vec);
+    }
+
     this->std_vec.erase(this->std_vec.begin(), this->std_vec.end());
     this->ft_vec.erase(this->ft_vec.begin(), this->ft_vec.end());
     COMPARE_TEST(this->ft_vec, this->std_vec);
@@ -582,3 +596,834 @@ REGISTER_TYPED_TEST_SUITE_P(VectorTest,
 );
 
 INSTANTIATE_TYPED_TEST_SUITE_P(VectorInstance, VectorTest, TestTypes::TestVectorTypes);
+
+/// relocation
+
+namespace
+{
+
+struct CopyCounted
+{
+    CopyCounted(int v = 0) : val(v) {}
+    CopyCounted(const CopyCounted& other) : val(other.val) { ++copies; }
+
+    CopyCounted& operator=(const CopyCounted& other)
+    {
+        val = other.val;
+        return *this;
+    }
+
+    bool operator==(const CopyCounted& other) const { return val == other.val; }
+    bool operator!=(const CopyCounted& other) const { return val != other.val; }
+
+    int val;
+
+    static size_t copies;
+};
+
+size_t CopyCounted::copies = 0;
+
+} // namespace
+
+namespace ft
+{
+template <> struct is_trivially_relocatable<CopyCounted> : public true_type { };
+} // namespace ft
+
+TEST(VectorRelocation, Traits)
+{
+    EXPECT_TRUE(ft::is_trivially_relocatable<int>::value);
+    EXPECT_TRUE(ft::is_trivially_relocatable<int*>::value);
+    EXPECT_FALSE(ft::is_trivially_relocatable<std::string>::value);
+    EXPECT_TRUE(ft::is_trivially_relocatable<CopyCounted>::value);
+}
+
+TEST(VectorRelocation, OptInSkipsCopies)
+{
+    std::vector<int>         std_vec;
+    ft::vector<CopyCounted>  ft_vec;
+
+    CopyCounted::copies = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        std_vec.push_back(i);
+        ft_vec.push_back(CopyCounted(i));
+    }
+    EXPECT_EQ(CopyCounted::copies, 1000);
+
+    std_vec.insert(std_vec.begin() + 500, 10, -1);
+    ft_vec.insert(ft_vec.begin() + 500, 10, CopyCounted(-1));
+    EXPECT_EQ(CopyCounted::copies, 1010);
+
+    std_vec.erase(std_vec.begin() + 100, std_vec.begin() + 200);
+    ft_vec.erase(ft_vec.begin() + 100, ft_vec.begin() + 200);
+    std_vec.erase(std_vec.begin() + 3);
+    ft_vec.erase(ft_vec.begin() + 3);
+    EXPECT_EQ(CopyCounted::copies, 1010);
+
+    ASSERT_EQ(ft_vec.size(), std_vec.size());
+    for (size_t i = 0; i < std_vec.size(); ++i)
+        ASSERT_EQ(ft_vec[i].val, std_vec[i]);
+}
+
+/// move semantics
+
+TEST(VectorMove, MoveConstructor)
+{
+    ft::vector<std::string> src(100, "moved");
+    const std::string* data = &src[0];
+
+    ft::vector<std::string> dst(std::move(src));
+    EXPECT_EQ(dst.size(), 100);
+    EXPECT_EQ(&dst[0], data);
+    EXPECT_TRUE(src.empty());
+    EXPECT_EQ(src.capacity(), 0);
+
+    ft::vector<std::string> other(3, "old");
+    other = std::move(dst);
+    EXPECT_EQ(other.size(), 100);
+    EXPECT_EQ(&other[0], data);
+    EXPECT_TRUE(dst.empty());
+}
+
+TEST(VectorMove, PushBackRvalue)
+{
+    typedef TestTypes::MoveTracked tracked;
+
+    ft::vector<tracked> vec;
+    tracked::reset();
+    for (int i = 0; i < 100; ++i)
+        vec.push_back(tracked(i));
+
+    EXPECT_EQ(tracked::copies(), 0);
+    for (int i = 0; i < 100; ++i)
+        ASSERT_EQ(vec[i].val, i);
+}
+
+TEST(VectorMove, EmplaceBack)
+{
+    typedef TestTypes::MoveTracked tracked;
+
+    ft::vector<tracked> vec;
+    vec.reserve(10);
+    tracked::reset();
+    for (int i = 0; i < 10; ++i)
+        vec.emplace_back(i);
+
+    EXPECT_EQ(tracked::copies(), 0);
+    EXPECT_EQ(tracked::moves(), 0);
+
+    // growing while the argument refers to an element of the vector
+    ft::vector<std::string> strings(1, "first");
+    strings.reserve(1);
+    strings.emplace_back(strings[0]);
+    strings.push_back(strings[0]);
+    EXPECT_EQ(strings[1], "first");
+    EXPECT_EQ(strings[2], "first");
+}
+
+TEST(VectorMove, Emplace)
+{
+    std::vector<std::string> std_vec;
+    ft::vector<std::string>  ft_vec;
+
+    for (int i = 0; i < 20; ++i)
+    {
+        std_vec.emplace(std_vec.begin() + std_vec.size() / 2, i, 'a' + i);
+        ft_vec.emplace(ft_vec.begin() + ft_vec.size() / 2, i, 'a' + i);
+    }
+    std_vec.emplace(std_vec.end(), "end");
+    ft_vec.emplace(ft_vec.end(), "end");
+    std_vec.insert(std_vec.begin(), std::string("begin"));
+    ft_vec.insert(ft_vec.begin(), std::string("begin"));
+
+    ASSERT_EQ(ft_vec.size(), std_vec.size());
+    for (size_t i = 0; i < std_vec.size(); ++i)
+        ASSERT_EQ(ft_vec[i], std_vec[i]);
+}
+
+/// growth policies
+
+template <typename _Policy>
+std::vector<size_t> capacities(size_t elem_size, size_t pushes)
+{
+    std::vector<size_t> caps;
+    size_t cap = 0;
+    for (size_t n = 1; n <= pushes; ++n)
+    {
+        if (n > cap)
+        {
+            cap = _Policy().grow(cap, n, elem_size);
+            caps.push_back(cap);
+        }
+    }
+    return caps;
+}
+
+TEST(VectorGrowth, Policies)
+{
+    size_t caps_2x[] = { 1, 2, 4, 8, 16 };
+    size_t caps_1_5x[] = { 1, 2, 3, 5, 8, 12, 18 };
+
+    EXPECT_EQ(capacities<ft::growth_2x>(4, 16),
+              std::vector<size_t>(caps_2x, caps_2x + 5));
+    EXPECT_EQ(capacities<ft::growth_1_5x>(4, 18),
+              std::vector<size_t>(caps_1_5x, caps_1_5x + 7));
+
+    // whole pages, even for sizes that do not divide the page
+    EXPECT_EQ(ft::growth_page().grow(0, 1, 4), 1024);
+    EXPECT_EQ(ft::growth_page().grow(1024, 1025, 4), 2048);
+    EXPECT_EQ(ft::growth_page().grow(0, 1, 1500), 2);
+
+    typedef ft::growth_hugepage<1 << 20> huge;
+    EXPECT_EQ(huge().grow(1024, 1025, 256), 2048);
+    EXPECT_EQ(huge().grow(4096, 4097, 256), 8192);
+    EXPECT_EQ(huge().grow(8192, 8193, 256), 16384);
+
+    // the vector asks the policy, reserve included
+    ft::vector<int, std::allocator<int>, ft::growth_page> vec;
+    vec.push_back(1);
+    EXPECT_EQ(vec.capacity(), 1024);
+    vec.reserve(1500);
+    EXPECT_EQ(vec.capacity(), 2048);
+    for (int i = 0; i < 3000; ++i)
+        vec.push_back(i);
+    EXPECT_EQ(vec.capacity(), 3072);
+    EXPECT_EQ(vec.size(), 3001);
+    EXPECT_EQ(vec[3000], 2999);
+}
+
+TEST(VectorGrowth, Stats)
+{
+    typedef ft::vector<int, std::allocator<int>,
+                       ft::growth_stats<ft::growth_2x> > vec_type;
+
+    vec_type vec;
+    for (int i = 0; i < 1000; ++i)
+        vec.push_back(i);
+
+    // 1, 2, 4, ..., 1024: the first allocation is not a reallocation,
+    // every buffer but the last was copied once
+    EXPECT_EQ(vec.capacity(), 1024);
+    EXPECT_EQ(vec.growth_policy().reallocations(), 10);
+    EXPECT_EQ(vec.growth_policy().bytes_copied(), (1024 - 1) * sizeof(int));
+
+    vec.growth_policy().reset_stats();
+    vec.reserve(4096);
+    EXPECT_EQ(vec.growth_policy().reallocations(), 1);
+    EXPECT_EQ(vec.growth_policy().bytes_copied(), 1000 * sizeof(int));
+
+    // a copy starts its own record
+    vec_type copy(vec);
+    EXPECT_EQ(copy.growth_policy().reallocations(), 0);
+}
+
+/// in-place reallocation
+
+TEST(VectorRealloc, Traits)
+{
+    EXPECT_TRUE(ft::allocator_has_reallocate<ft::mremap_allocator<int> >::value);
+    EXPECT_FALSE(ft::allocator_has_reallocate<std::allocator<int> >::value);
+}
+
+TEST(VectorRealloc, GrowsWithoutCopying)
+{
+    typedef ft::mremap_allocator<int, 1 << 16>  alloc_type;
+    typedef ft::growth_stats<ft::growth_2x>     policy_type;
+
+    ft::vector<int, alloc_type, policy_type> vec;
+    for (int i = 0; i < (1 << 20); ++i)
+        vec.push_back(i);
+    for (int i = 0; i < (1 << 20); ++i)
+        ASSERT_EQ(vec[i], i);
+
+    // only the buffers below the threshold were copied
+    EXPECT_EQ(vec.growth_policy().reallocations(), 20);
+    EXPECT_LT(vec.growth_policy().bytes_copied(), alloc_type::threshold);
+
+    vec.push_back(vec[0]);
+    EXPECT_EQ(vec.back(), 0);
+
+    // elements that are not relocatable take the copying path
+    ft::vector<std::string, ft::mremap_allocator<std::string, 1 << 12> > strings;
+    for (int i = 0; i < 10000; ++i)
+        strings.push_back(std::string(i % 32, 'x'));
+    for (int i = 0; i < 10000; ++i)
+        ASSERT_EQ(strings[i].size(), size_t(i % 32));
+}
+
+/// input iterators
+
+TEST(VectorInput, SinglePassRanges)
+{
+    typedef std::istream_iterator<int> in_iter;
+
+    std::istringstream ctor_in("1 2 3 4 5");
+    ft::vector<int> vec((in_iter(ctor_in)), in_iter());
+    ASSERT_EQ(vec.size(), 5);
+    EXPECT_EQ(vec[0], 1);
+    EXPECT_EQ(vec[4], 5);
+
+    std::istringstream end_in("6 7");
+    vec.insert(vec.end(), in_iter(end_in), in_iter());
+    std::istringstream mid_in("-1 -2");
+    vec.insert(vec.begin() + 1, in_iter(mid_in), in_iter());
+
+    int expected[] = { 1, -1, -2, 2, 3, 4, 5, 6, 7 };
+    ASSERT_EQ(vec.size(), 9);
+    for (size_t i = 0; i < vec.size(); ++i)
+        ASSERT_EQ(vec[i], expected[i]);
+
+    std::istringstream assign_in("8 9");
+    vec.assign(in_iter(assign_in), in_iter());
+    ASSERT_EQ(vec.size(), 2);
+    EXPECT_EQ(vec[0], 8);
+    EXPECT_EQ(vec[1], 9);
+}
+
+TEST(VectorInput, ForwardRangesAllocateOnce)
+{
+    typedef TestTypes::CountingAllocator<int> alloc_type;
+
+    std::list<int> values;
+    for (int i = 0; i < 100; ++i)
+        values.push_back(i);
+
+    alloc_type::allocations() = 0;
+    ft::vector<int, alloc_type> vec(values.begin(), values.end());
+    EXPECT_EQ(alloc_type::allocations(), 1);
+    EXPECT_EQ(vec.capacity(), 100);
+
+    vec.insert(vec.begin() + 50, values.begin(), values.end());
+    EXPECT_EQ(alloc_type::allocations(), 2);
+    ASSERT_EQ(vec.size(), 200);
+    EXPECT_EQ(vec[49], 49);
+    EXPECT_EQ(vec[50], 0);
+    EXPECT_EQ(vec[150], 50);
+}
+
+TEST(VectorInput, ThrowingInsertRollsBack)
+{
+    typedef TestTypes::Fragile Fragile;
+    {
+        ft::vector<Fragile> vec;
+        vec.reserve(16);
+        for (int i = 0; i < 6; ++i)
+            vec.push_back(Fragile(i));
+
+        std::list<Fragile> src;
+        for (int i = 1; i <= 4; ++i)
+            src.push_back(Fragile(-i));
+        Fragile::copies_left() = 2;
+        EXPECT_THROW(vec.insert(vec.begin() + 2, src.begin(), src.end()), std::runtime_error);
+        Fragile::copies_left() = 3;
+        EXPECT_THROW(vec.insert(vec.begin() + 1, 5, Fragile(-1)), std::runtime_error);
+        Fragile::copies_left() = -1;
+
+        ASSERT_EQ(vec.size(), 6);
+        for (int i = 0; i < 6; ++i)
+            EXPECT_EQ(vec[i].val, i);
+        EXPECT_EQ(Fragile::live(), 6 + 4);
+    }
+    EXPECT_EQ(Fragile::live(), 0);
+}
+
+/// assignment over live elements
+
+TEST(VectorAssign, ReusesElements)
+{
+    ft::vector<std::string> src(4, std::string(64, 's'));
+    ft::vector<std::string> dst(12, std::string(100, 'd'));
+    dst.resize(6);
+    const char* kept = dst[0].data();
+
+    // the live strings keep their buffers, the excess is destroyed
+    dst = src;
+    ASSERT_EQ(dst.size(), 4);
+    EXPECT_EQ(dst[0].data(), kept);
+    EXPECT_TRUE(dst == src);
+
+    std::list<std::string> longer(9, "list");
+    dst.assign(longer.begin(), longer.end());
+    ASSERT_EQ(dst.size(), 9);
+    EXPECT_EQ(dst[0].data(), kept);
+    EXPECT_EQ(dst[8], "list");
+
+    dst.assign(2, "fill");
+    ASSERT_EQ(dst.size(), 2);
+    EXPECT_EQ(dst[0].data(), kept);
+    EXPECT_EQ(dst[1], "fill");
+
+    std::istringstream in("a b c d e f g h i j k l");
+    typedef std::istream_iterator<std::string> in_iter;
+    dst.assign(in_iter(in), in_iter());
+    ASSERT_EQ(dst.size(), 12);
+    EXPECT_EQ(dst[0], "a");
+    EXPECT_EQ(dst[11], "l");
+    std::istringstream short_in("x y");
+    dst.assign(in_iter(short_in), in_iter());
+    ASSERT_EQ(dst.size(), 2);
+    EXPECT_EQ(dst[1], "y");
+}
+
+TEST(VectorAssign, CopiesOnlyWhatIsNeeded)
+{
+    ft::vector<TestTypes::MoveTracked> src;
+    for (int i = 0; i < 10; ++i)
+        src.push_back(i);
+    ft::vector<TestTypes::MoveTracked> dst(src);
+    dst.reserve(20);
+    dst.resize(5);
+
+    // 5 assignments and 5 constructions, nothing is moved
+    TestTypes::MoveTracked::reset();
+    dst = src;
+    EXPECT_EQ(TestTypes::MoveTracked::copies(), 10);
+    EXPECT_EQ(TestTypes::MoveTracked::moves(), 0);
+    EXPECT_TRUE(dst == src);
+
+    TestTypes::MoveTracked::reset();
+    dst.assign(src.begin(), src.begin() + 3);
+    EXPECT_EQ(TestTypes::MoveTracked::copies(), 3);
+    ASSERT_EQ(dst.size(), 3);
+    EXPECT_EQ(dst[2].val, 2);
+}
+
+/// batch erase
+
+namespace
+{
+
+std::string number(int i)
+{
+    std::ostringstream out;
+    out << i;
+    return out.str();
+}
+
+struct IsOdd
+{
+    bool operator()(int x) const { return x % 2 != 0; }
+};
+
+struct ThrowsAt
+{
+    explicit ThrowsAt(int at) : at(at) {}
+    bool operator()(const std::string& s) const
+    {
+        if (s == number(at))
+            throw std::runtime_error("predicate");
+        return s.size() == 1;
+    }
+    int at;
+};
+
+} // namespace
+
+TEST(VectorErase, EraseIf)
+{
+    ft::vector<int> vec;
+    std::vector<int> std_vec;
+    for (int i = 0; i < 1000; ++i)
+    {
+        vec.push_back(i * 7 % 13);
+        if (i * 7 % 13 % 2 == 0)
+            std_vec.push_back(i * 7 % 13);
+    }
+    EXPECT_EQ(ft::erase_if(vec, IsOdd()), 1000 - std_vec.size());
+    ASSERT_EQ(vec.size(), std_vec.size());
+    for (size_t i = 0; i < vec.size(); ++i)
+        ASSERT_EQ(vec[i], std_vec[i]);
+
+    EXPECT_EQ(ft::erase_if(vec, IsOdd()), 0);
+    EXPECT_EQ(ft::erase(vec, 0), size_t(std::count(std_vec.begin(), std_vec.end(), 0)));
+    EXPECT_EQ(std::count(vec.begin(), vec.end(), 0), 0);
+
+    // the value may live in the vector itself
+    ft::vector<std::string> strings;
+    for (int i = 0; i < 100; ++i)
+        strings.push_back(number(i % 10));
+    EXPECT_EQ(ft::erase(strings, strings[3]), 10);
+    ASSERT_EQ(strings.size(), 90);
+    EXPECT_EQ(strings[3], "4");
+    EXPECT_EQ(strings[89], "9");
+
+    ft::vector<int> empty;
+    EXPECT_EQ(ft::erase(empty, 1), 0);
+
+    // the value converts to the element type
+    EXPECT_EQ(ft::erase(strings, "4"), 10);
+    EXPECT_EQ(strings[3], "5");
+    ft::vector<long> longs(10, 1L);
+    longs.push_back(2L);
+    EXPECT_EQ(ft::erase(longs, 1), 10);
+    ASSERT_EQ(longs.size(), 1);
+    EXPECT_EQ(longs[0], 2L);
+}
+
+TEST(VectorErase, ThrowingPredicate)
+{
+    ft::vector<std::string> strings;
+    for (int i = 0; i < 40; ++i)
+        strings.push_back(number(i));
+
+    // the one digit strings before 25 are gone, the rest is left untouched
+    EXPECT_THROW(ft::erase_if(strings, ThrowsAt(25)), std::runtime_error);
+    ASSERT_EQ(strings.size(), 30);
+    EXPECT_EQ(strings[0], "10");
+    EXPECT_EQ(strings[15], "25");
+    EXPECT_EQ(strings[29], "39");
+}
+
+TEST(VectorErase, RangeErase)
+{
+    ft::vector<std::string> strings;
+    for (int i = 0; i < 20; ++i)
+        strings.push_back(number(i));
+    ft::vector<std::string>::iterator it = strings.erase(strings.begin() + 5, strings.begin() + 15);
+    EXPECT_EQ(*it, "15");
+    ASSERT_EQ(strings.size(), 10);
+    EXPECT_EQ(strings[4], "4");
+    EXPECT_EQ(strings[5], "15");
+    EXPECT_EQ(strings.erase(strings.begin() + 2, strings.begin() + 2) - strings.begin(), 2);
+    EXPECT_EQ(strings.size(), 10);
+}
+
+/// default-init resize
+
+TEST(VectorDefaultInit, ResizeDefaultInit)
+{
+    ft::vector<int> ints(3, 7);
+    ints.resize_default_init(100);
+    ASSERT_EQ(ints.size(), 100);
+    EXPECT_EQ(ints[0], 7);
+    EXPECT_EQ(ints[2], 7);
+    ints.resize_default_init(2);
+    ASSERT_EQ(ints.size(), 2);
+
+    // class types are still default constructed
+    ft::vector<std::string> strings(1, "kept");
+    strings.resize_default_init(3);
+    ASSERT_EQ(strings.size(), 3);
+    EXPECT_EQ(strings[0], "kept");
+    EXPECT_TRUE(strings[2].empty());
+}
+
+TEST(VectorDefaultInit, AppendUninitialized)
+{
+    const char text[] = "read into the vector";
+
+    ft::vector<char> buf(1, '>');
+    char* dst = buf.append_uninitialized(sizeof(text));
+    std::memcpy(dst, text, sizeof(text));
+
+    ASSERT_EQ(buf.size(), 1 + sizeof(text));
+    EXPECT_EQ(dst, &buf[1]);
+    EXPECT_STREQ(&buf[1], text);
+    EXPECT_EQ(buf[0], '>');
+}
+
+/// shrinking
+
+TEST(VectorShrink, ShrinkToFit)
+{
+    ft::vector<std::string> vec(10, "value");
+    vec.reserve(1000);
+    vec.shrink_to(500);
+    EXPECT_EQ(vec.capacity(), 500);
+    vec.shrink_to(5);
+    EXPECT_EQ(vec.capacity(), 10);
+    vec.shrink_to(100);
+    EXPECT_EQ(vec.capacity(), 10);
+
+    vec.pop_back();
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 9);
+    ASSERT_EQ(vec.size(), 9);
+    EXPECT_EQ(vec[8], "value");
+
+    vec.clear();
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 0);
+    vec.push_back("again");
+    EXPECT_EQ(vec.back(), "again");
+}
+
+TEST(VectorShrink, MemoryFootprint)
+{
+    ft::vector<int> vec(100, 1);
+    vec.reserve(400);
+
+    ft::vector<int>::footprint_type fp = vec.memory_footprint();
+    EXPECT_EQ(fp.used_bytes, 100 * sizeof(int));
+    EXPECT_EQ(fp.reserved_bytes, 400 * sizeof(int));
+
+    vec.shrink_to_fit();
+    fp = vec.memory_footprint();
+    EXPECT_EQ(fp.reserved_bytes, fp.used_bytes);
+}
+
+TEST(VectorShrink, ShrinkInPlace)
+{
+    typedef ft::mremap_allocator<int, 1 << 16>  alloc_type;
+    typedef ft::growth_stats<ft::growth_2x>     policy_type;
+
+    ft::vector<int, alloc_type, policy_type> vec;
+    vec.reserve(1 << 20);
+    for (int i = 0; i < (1 << 18); ++i)
+        vec.push_back(i);
+
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 1 << 18);
+    EXPECT_EQ(vec.growth_policy().bytes_copied(), 0);
+    for (int i = 0; i < (1 << 18); ++i)
+        ASSERT_EQ(vec[i], i);
+}
+
+/// vectorized comparison
+
+TEST(VectorCompare, MismatchKernels)
+{
+    unsigned char a[300];
+    unsigned char b[300];
+    for (size_t i = 0; i < sizeof(a); ++i)
+        a[i] = b[i] = static_cast<unsigned char>(i * 7);
+
+    for (size_t n = 0; n <= sizeof(a); n += (n < 70 ? 1 : 23))
+    {
+        ASSERT_EQ(ft::simd::mismatch(a, b, n), n);
+        for (size_t pos = 0; pos < n; pos += (n < 70 ? 1 : 7))
+        {
+            b[pos] ^= 0x80;
+            ASSERT_EQ(ft::simd::mismatch(a, b, n), pos);
+            ASSERT_EQ(ft::simd::mismatch_scalar(a, b, n), pos);
+#if defined(FT_SIMD_X86) && defined(__SSE2__)
+            ASSERT_EQ(ft::simd::mismatch_sse2(a, b, n), pos);
+#endif
+#ifdef FT_SIMD_X86
+            if (ft::simd::cpu_has_avx2())
+            {
+                ASSERT_EQ(ft::simd::mismatch_avx2(a, b, n), pos);
+            }
+#endif
+            b[pos] ^= 0x80;
+        }
+    }
+}
+
+TEST(VectorCompare, ArithmeticVectors)
+{
+    std::vector<int> std_a, std_b;
+    ft::vector<int>  ft_a, ft_b;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        std_a.push_back(i - 500);
+        ft_a.push_back(i - 500);
+    }
+    std_b = std_a;
+    ft_b = ft_a;
+    EXPECT_TRUE(ft_a == ft_b);
+
+    // the order of the elements, not of their bytes
+    std_b[700] = -1;
+    ft_b[700] = -1;
+    EXPECT_EQ(ft_a == ft_b, std_a == std_b);
+    EXPECT_EQ(ft_a < ft_b, std_a < std_b);
+    EXPECT_EQ(ft_b < ft_a, std_b < std_a);
+
+    std_b.resize(700);
+    ft_b.resize(700);
+    EXPECT_EQ(ft_a < ft_b, std_a < std_b);
+    EXPECT_EQ(ft_b < ft_a, std_b < std_a);
+
+    std::vector<char> std_c(100, 'x'), std_d(100, 'x');
+    ft::vector<char>  ft_c(100, 'x'), ft_d(100, 'x');
+    std_d[50] = static_cast<char>(-100);
+    ft_d[50] = static_cast<char>(-100);
+    EXPECT_EQ(ft_c < ft_d, std_c < std_d);
+    EXPECT_EQ(ft_d < ft_c, std_d < std_c);
+    EXPECT_FALSE(ft_c == ft_d);
+
+    // floating point keeps the element loop
+    ft::vector<double> zero(3, 0.0), negative_zero(3, -0.0);
+    EXPECT_TRUE(zero == negative_zero);
+}
+
+/// vectorized fill
+
+template <size_t _Size>
+struct Pod
+{
+    unsigned char bytes[_Size];
+};
+
+template <size_t _Size>
+void check_fill(size_t n, size_t offset)
+{
+    Pod<_Size> val;
+    for (size_t i = 0; i < _Size; ++i)
+        val.bytes[i] = static_cast<unsigned char>(i * 31 + 1);
+
+    std::vector<unsigned char> expected(n * _Size + offset + 1, 0xEE);
+    for (size_t i = 0; i < n * _Size; ++i)
+        expected[offset + i] = val.bytes[i % _Size];
+
+    std::vector<unsigned char> buf(n * _Size + offset + 1, 0xEE);
+    ft::simd::fill(&buf[offset], &val, _Size, n);
+    EXPECT_TRUE(buf == expected) << "size=" << _Size << " n=" << n;
+}
+
+TEST(VectorFill, Kernel)
+{
+    const size_t counts[] = { 0, 1, 2, 3, 7, 31, 33, 100, 1000 };
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c)
+    {
+        for (size_t offset = 0; offset < 3; ++offset)
+        {
+            check_fill<1>(counts[c], offset);
+            check_fill<2>(counts[c], offset);
+            check_fill<3>(counts[c], offset);
+            check_fill<4>(counts[c], offset);
+            check_fill<8>(counts[c], offset);
+            check_fill<12>(counts[c], offset);
+            check_fill<16>(counts[c], offset);
+            check_fill<32>(counts[c], offset);
+            check_fill<40>(counts[c], offset);
+        }
+    }
+
+    // past the streaming store threshold, from an unaligned address
+    const size_t big = size_t(16) << 20;
+    check_fill<4>(big / 4 + 5, 3);
+    check_fill<32>(big / 32 + 5, 1);
+}
+
+TEST(VectorFill, FillMembers)
+{
+    ft::vector<double> doubles(1000, 1.5);
+    for (size_t i = 0; i < doubles.size(); ++i)
+        ASSERT_EQ(doubles[i], 1.5);
+
+    // assign replaces every element, not only the new ones
+    ft::vector<int> ints(10, 1);
+    ints.assign(20, 2);
+    ASSERT_EQ(ints.size(), 20);
+    for (size_t i = 0; i < ints.size(); ++i)
+        ASSERT_EQ(ints[i], 2);
+    ints.assign(5, ints[19]);
+    ASSERT_EQ(ints.size(), 5);
+    EXPECT_EQ(ints[4], 2);
+
+    ints.resize(8, 0x01010101);
+    EXPECT_EQ(ints[4], 2);
+    EXPECT_EQ(ints[7], 0x01010101);
+
+    // the value may be an element that the insert moves
+    ints.insert(ints.begin(), 100, ints[7]);
+    ASSERT_EQ(ints.size(), 108);
+    EXPECT_EQ(ints[0], 0x01010101);
+    EXPECT_EQ(ints[99], 0x01010101);
+    EXPECT_EQ(ints[100], 2);
+
+    ft::vector<std::string> strings(3, "a");
+    strings.insert(strings.begin() + 1, 50, strings[2]);
+    ASSERT_EQ(strings.size(), 53);
+    EXPECT_EQ(strings[50], "a");
+}
+
+/// parallel construction
+
+namespace
+{
+
+/// Counts live objects; the copy constructor throws once `budget` copies
+/// were made.
+struct CopyBudget
+{
+    CopyBudget(int v = 0) : val(v) { ++live; }
+    CopyBudget(const CopyBudget& other) : val(other.val)
+    {
+        if (budget.fetch_sub(1) <= 0)
+            throw std::runtime_error("copy budget");
+        ++live;
+    }
+    ~CopyBudget() { --live; }
+
+    int val;
+
+    static std::atomic<long> live;
+    static std::atomic<long> budget;
+};
+
+std::atomic<long> CopyBudget::live(0);
+std::atomic<long> CopyBudget::budget(0);
+
+} // namespace
+
+TEST(VectorParallel, FillAndCopy)
+{
+    ft::thread_pool      pool(4);
+    ft::parallel_policy  par(pool, 0);
+
+    EXPECT_EQ(pool.size(), 4);
+
+    ft::vector<int> ints(100003, 7, par);
+    ASSERT_EQ(ints.size(), 100003);
+    for (size_t i = 0; i < ints.size(); ++i)
+        ASSERT_EQ(ints[i], 7);
+
+    for (size_t i = 0; i < ints.size(); ++i)
+        ints[i] = static_cast<int>(i);
+    ft::vector<int> copy(ints, par);
+    EXPECT_TRUE(copy == ints);
+
+    copy.assign(5, -1, par);
+    ASSERT_EQ(copy.size(), 5);
+    EXPECT_EQ(copy[4], -1);
+    copy.assign(1000, copy[2], par);
+    ASSERT_EQ(copy.size(), 1000);
+    EXPECT_EQ(copy[999], -1);
+    copy.assign(ints, par);
+    EXPECT_TRUE(copy == ints);
+
+    ft::vector<std::string> strings(999, "parallel", par);
+    ft::vector<std::string> strings_copy(strings, par);
+    EXPECT_TRUE(strings_copy == strings);
+    EXPECT_EQ(strings_copy[998], "parallel");
+
+    // fewer chunks than threads and empty vectors
+    ft::vector<int> small(3, 1, par);
+    EXPECT_EQ(small.size(), 3);
+    ft::vector<int> empty(0, 1, par);
+    EXPECT_TRUE(empty.empty());
+}
+
+TEST(VectorParallel, ExceptionSafety)
+{
+    ft::thread_pool      pool(4);
+    ft::parallel_policy  par(pool, 0);
+
+    {
+        CopyBudget val(1);
+        CopyBudget::budget = 500;
+        EXPECT_THROW(ft::vector<CopyBudget>(10000, val, par), std::runtime_error);
+        EXPECT_EQ(CopyBudget::live, 1);
+
+        CopyBudget::budget = 20000;
+        ft::vector<CopyBudget> vec(10000, val, par);
+        EXPECT_EQ(CopyBudget::live, 10001);
+
+        CopyBudget::budget = 9000;
+        EXPECT_THROW(ft::vector<CopyBudget>(vec, par), std::runtime_error);
+        EXPECT_EQ(CopyBudget::live, 10001);
+
+        CopyBudget::budget = 100;
+        ft::vector<CopyBudget> target;
+        EXPECT_THROW(target.assign(vec, par), std::runtime_error);
+        EXPECT_TRUE(target.empty());
+        EXPECT_EQ(CopyBudget::live, 10001);
+    }
+    EXPECT_EQ(CopyBudget::live, 0);
+}
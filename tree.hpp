@@ -1,6 +1,7 @@
 #ifndef TREE_H
 #define TREE_H
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <iterator>
@@ -80,6 +81,11 @@ struct _Rb_tree_header
     move_data(_Rb_tree_header& from)
     {
         header.color = from.header.color;
+        if (!from.header.parent)
+        {
+            reset();
+            return;
+        }
         header.parent = from.header.parent;
         header.left = from.header.left;
         header.right = from.header.right;
@@ -100,6 +106,24 @@ struct _Rb_tree_header
     }
 };
 
+/// Tag for the range constructors and inserts whose input is known to be
+/// sorted by the container's comparator and free of duplicate keys.
+struct sorted_unique_t
+{
+};
+
+static const sorted_unique_t sorted_unique = sorted_unique_t();
+
+/// What a tree's node pool holds: nodes in use, nodes cached for reuse
+/// (freed, or never handed out yet), and the memory behind them.
+struct node_pool_stats
+{
+    size_t live_nodes;
+    size_t cached_nodes;
+    size_t slabs;
+    size_t reserved_bytes;
+};
+
 template <typename _Tp>
 _Tp* addressof(_Tp& arg)
 {
@@ -716,15 +740,42 @@ public:
         insert(first, last);
     }
 
+    /// sorted range constructor
+    template <class InputIterator>
+    _Rb_tree(sorted_unique_t, InputIterator first, InputIterator last,
+             const key_compare& comp = key_compare(),
+             const allocator_type& alloc = allocator_type())
+        : _header(),
+        _node_pool(alloc),
+        _comp(comp)
+    {
+        insert(sorted_unique, first, last);
+    }
+
     /// copy constructor
     _Rb_tree(const _Rb_tree& t)
         : _header(),
         _node_pool(t._node_pool.get_allocator()),
         _comp(t._comp)
     {
+        _node_pool.slab_size(t._node_pool.slab_size());
+        _node_pool.cache_limit(t._node_pool.cache_limit());
         *this = t;
     }
 
+#ifdef FT_CXX11
+    /// move constructor
+    _Rb_tree(_Rb_tree&& t)
+        : _header(),
+        _node_pool(t._node_pool.get_allocator()),
+        _comp(t._comp)
+    {
+        // the nodes belong to the pool they came from, it comes along
+        _node_pool.swap(t._node_pool);
+        _header.move_data(t._header);
+    }
+#endif
+
     ~_Rb_tree()
     {
         _node_pool._destroy(_header.header.parent);
@@ -753,9 +804,24 @@ public:
         return *this;
     }
 
+#ifdef FT_CXX11
+    _Rb_tree&
+    operator=(_Rb_tree&& t)
+    {
+        if (this != &t)
+        {
+            clear();
+            _node_pool.swap(t._node_pool);
+            _header.move_data(t._header);
+            _comp = t._comp;
+        }
+        return *this;
+    }
+#endif
+
     allocator_type get_allocator() const
     {
-        return allocator_type();
+        return allocator_type(_node_pool.get_allocator());
     }
 
     /// iterators
@@ -826,6 +892,45 @@ public:
         return _node_pool.get_allocator().max_size();
     }
 
+    /// Nodes allocated at once when the pool runs dry, at most.
+    size_type
+    node_slab_size() const
+    {
+        return _node_pool.slab_size();
+    }
+
+    void
+    node_slab_size(size_type n)
+    {
+        _node_pool.slab_size(n);
+    }
+
+    /// Freed nodes kept for reuse before the pool starts giving slabs
+    /// back, unlimited by default.
+    size_type
+    node_cache_limit() const
+    {
+        return _node_pool.cache_limit();
+    }
+
+    void
+    node_cache_limit(size_type n)
+    {
+        _node_pool.cache_limit(n);
+    }
+
+    size_type
+    release_unused()
+    {
+        return _node_pool.release_unused();
+    }
+
+    node_pool_stats
+    pool_stats() const
+    {
+        return _node_pool.stats();
+    }
+
     // modifiers
     void
     clear()
@@ -848,15 +953,95 @@ public:
         return iterator(_insert_hint(hint._node, value));
     }
 
+    /// An empty tree given a sorted forward range is built in one go.
     template <class InputIterator>
     void
     insert(InputIterator first, InputIterator last)
     {
+        size_type n;
+        if (empty() && _sorted_unique(first, last, n, ft::iterator_category(first)))
+        {
+            _build_sorted(first, n);
+            return;
+        }
         bool b;
         for ( ; first != last; ++first)
             _insert(*first, b);
     }
 
+    /// The range has to be sorted and without duplicate keys, it is
+    /// not checked.
+    template <class InputIterator>
+    void
+    insert(sorted_unique_t, InputIterator first, InputIterator last)
+    {
+        if (!empty())
+        {
+            insert(first, last);
+            return;
+        }
+        _insert_sorted(first, last, ft::iterator_category(first));
+    }
+
+#ifdef FT_CXX11
+    pair<iterator, bool>
+    insert(value_type&& value)
+    {
+        bool was_inserted;
+        base_ptr x = _insert(std::move(value), was_inserted);
+        return ft::make_pair(iterator(x), was_inserted);
+    }
+
+    iterator
+    insert(iterator hint, value_type&& value)
+    {
+        return iterator(_insert_hint(hint._node, std::move(value)));
+    }
+
+    template <typename... _Args>
+    pair<iterator, bool>
+    emplace(_Args&&... args)
+    {
+        node_ptr z = _node_pool._make_node(std::forward<_Args>(args)...);
+        int side;
+        base_ptr p = _insert_pos(_key(z), side);
+        if (!side)
+        {
+            _node_pool._free_node(z);
+            return ft::make_pair(iterator(p), false);
+        }
+        return ft::make_pair(iterator(_insert_node(p, side, z)), true);
+    }
+
+    template <typename... _Args>
+    iterator
+    emplace_hint(iterator hint, _Args&&... args)
+    {
+        node_ptr z = _node_pool._make_node(std::forward<_Args>(args)...);
+        int side;
+        base_ptr p = _insert_hint_pos(hint._node, _key(z), side);
+        if (!side)
+        {
+            _node_pool._free_node(z);
+            return iterator(p);
+        }
+        return iterator(_insert_node(p, side, z));
+    }
+
+    /// Builds the value from args only when no element has key k.
+    template <typename... _Args>
+    pair<iterator, bool>
+    _try_emplace(const key_type& k, _Args&&... args)
+    {
+        int side;
+        base_ptr p = _insert_pos(k, side);
+        if (!side)
+            return ft::make_pair(iterator(p), false);
+        node_ptr z = _node_pool._make_node(std::forward<_Args>(args)...);
+        return ft::make_pair(iterator(_insert_node(p, side, z)), true);
+    }
+#endif
+
     void
     erase(iterator pos)
     {
@@ -891,6 +1076,8 @@ public:
         _Rb_tree_header src = t._header;
         _header.move_data(src);
         t._header.move_data(dest);
+        _node_pool.swap(t._node_pool);
+        ft::swap(_comp, t._comp);
     }
 
     /// lookup
@@ -1001,71 +1188,185 @@ public:
     }
 
 private:
-    base_ptr
-    _insert_unique(_Rb_tree_node_base* const p, const_reference val)
+    typedef ft::integral_constant<bool,
+        ft::has_compare3<Compare, Key>::value> _has_compare3;
+
+    static const key_type&
+    _key(const_base_ptr x)
     {
-        const bool insert_left = (p == &_header.header
-            || _comp(KeyOfValue()(val),
-            KeyOfValue()(*static_cast<node_ptr>(p)->val_ptr())));
+        return KeyOfValue()(*static_cast<const_node_ptr>(x)->val_ptr());
+    }
 
-        base_ptr x = _node_pool._make_node(val);
-        _Rb_tree_insert_and_rebalance(insert_left, x, p, _header.header);
-        _header.count++;
-        return x;
+    /// Negative, zero or positive as a orders before, with or after b:
+    /// one call to a comparator with compare3, up to two otherwise.
+    int
+    _compare(const key_type& a, const key_type& b) const
+    {
+        return _compare(a, b, _has_compare3());
+    }
+
+    int
+    _compare(const key_type& a, const key_type& b, ft::true_type) const
+    {
+        return _comp.compare3(a, b);
+    }
+
+    int
+    _compare(const key_type& a, const key_type& b, ft::false_type) const
+    {
+        if (_comp(a, b))
+            return -1;
+        return _comp(b, a) ? 1 : 0;
     }
 
+    /// Returns the node holding k (side is 0), or the node a new
+    /// element with key k has to be attached to, on its left when side
+    /// is negative and on its right when it is positive.
     base_ptr
-    _insert(const_reference val, bool& was_inserted)
+    _insert_pos(const key_type& k, int& side)
+    {
+        return _insert_pos(k, side, _has_compare3());
+    }
+
+    /// One three-way comparison a level, stops at an equal key.
+    base_ptr
+    _insert_pos(const key_type& k, int& side, ft::true_type)
     {
         base_ptr x = _header.header.parent;
         base_ptr y = &_header.header;
+        side = -1;
         while (x)
         {
             y = x;
-            if (_comp(KeyOfValue()(val),
-                KeyOfValue()(*static_cast<node_ptr>(x)->val_ptr())))
-            {
+            side = _comp.compare3(k, _key(x));
+            if (side < 0)
                 x = x->left;
-            }
-            else if (_comp(KeyOfValue()(*static_cast<node_ptr>(x)->val_ptr()),
-                KeyOfValue()(val)))
-            {
+            else if (side > 0)
                 x = x->right;
-            }
             else
-            {
-                was_inserted = false;
                 return x;
-            }
         }
-        was_inserted = true;
-        return _insert_unique(y, val);
+        return y;
     }
 
+    /// One comparison a level down to a leaf, then one against the
+    /// predecessor of the slot to rule out an equal key.
     base_ptr
-    _insert_hint(_Rb_tree_node_base* const hint, const_reference val)
+    _insert_pos(const key_type& k, int& side, ft::false_type)
     {
-        bool b;
-        if (hint == &_header.header)
-            return _insert(val, b);
-        if (!_comp(KeyOfValue()(*static_cast<node_ptr>(hint)->val_ptr()),
-            KeyOfValue()(val))
-            && !_comp(KeyOfValue()(val),
-            KeyOfValue()(*static_cast<node_ptr>(hint)->val_ptr())))
+        base_ptr x = _header.header.parent;
+        base_ptr y = &_header.header;
+        bool left = true;
+        while (x)
         {
-            return hint;
+            y = x;
+            left = _comp(k, _key(x));
+            x = left ? x->left : x->right;
         }
-        if (_comp(KeyOfValue()(*static_cast<node_ptr>(
-            _Rb_tree_decrement(hint))->val_ptr()), KeyOfValue()(val))
-            && _comp(KeyOfValue()(val),
-            KeyOfValue()(*static_cast<node_ptr>(
-            _Rb_tree_increment(hint))->val_ptr())))
+        side = left ? -1 : 1;
+        base_ptr before = y;
+        if (left)
         {
-            return _insert_unique(hint, val);
+            if (y == _header.header.left)
+                return y;
+            before = _Rb_tree_decrement(y);
         }
-        return _insert(val, b);
+        if (_comp(_key(before), k))
+            return y;
+        side = 0;
+        return before;
     }
 
+    /// Like _insert_pos, but first tries the slot right before hint,
+    /// then the one right after it: a key that belongs next to hint is
+    /// placed with one or two comparisons. With end() as the hint a key
+    /// greater than every other goes straight after the rightmost node,
+    /// so appending in order costs O(1) amortized.
+    base_ptr
+    _insert_hint_pos(base_ptr hint, const key_type& k, int& side)
+    {
+        base_ptr header = &_header.header;
+        if (hint == header)
+        {
+            side = 1;
+            if (_header.count && _comp(_key(header->right), k))
+                return header->right;
+            return _insert_pos(k, side);
+        }
+        side = _compare(k, _key(hint));
+        if (side < 0)
+        {
+            if (hint == header->left)
+                return hint;
+            base_ptr before = _Rb_tree_decrement(hint);
+            if (!_comp(_key(before), k))
+                return _insert_pos(k, side);
+            // one of the two has a free slot facing the other
+            if (before->right)
+                return hint;
+            side = 1;
+            return before;
+        }
+        if (side > 0)
+        {
+            if (hint == header->right)
+                return hint;
+            base_ptr after = _Rb_tree_increment(hint);
+            if (!_comp(k, _key(after)))
+                return _insert_pos(k, side);
+            if (!hint->right)
+                return hint;
+            side = -1;
+            return after;
+        }
+        return hint;
+    }
+
+    /// Attaches z below p on the side _insert_pos picked.
+    base_ptr
+    _insert_node(base_ptr p, int side, node_ptr z)
+    {
+        const bool insert_left = (p == &_header.header || side < 0);
+
+        _Rb_tree_insert_and_rebalance(insert_left, z, p, _header.header);
+        _header.count++;
+        return z;
+    }
+
+#ifdef FT_CXX11
+    template <typename _Arg>
+    base_ptr
+    _insert(_Arg&& val, bool& was_inserted)
+#else
+    base_ptr
+    _insert(const_reference val, bool& was_inserted)
+#endif
+    {
+        int side;
+        base_ptr p = _insert_pos(KeyOfValue()(val), side);
+        was_inserted = side != 0;
+        if (!side)
+            return p;
+        return _insert_node(p, side, _node_pool._make_node(FT_FORWARD(_Arg, val)));
+    }
+
+#ifdef FT_CXX11
+    template <typename _Arg>
+    base_ptr
+    _insert_hint(base_ptr hint, _Arg&& val)
+#else
+    base_ptr
+    _insert_hint(base_ptr hint, const_reference val)
+#endif
+    {
+        int side;
+        base_ptr p = _insert_hint_pos(hint, KeyOfValue()(val), side);
+        if (!side)
+            return p;
+        return _insert_node(p, side, _node_pool._make_node(FT_FORWARD(_Arg, val)));
+    }
+
+    /// Keys are unique, an equal one is the bound and ends the descent.
     const_base_ptr
     _lower_bound(const Key& key) const
     {
@@ -1073,17 +1374,14 @@ private:
         const_base_ptr y = &_header.header;
         while (x)
         {
-            if (_comp(key, KeyOfValue()(
-                *static_cast<const_node_ptr>(x)->val_ptr())))
+            const int c = _compare(key, _key(x));
+            if (c < 0)
             {
                 y = x;
                 x = x->left;
             }
-            else if (_comp(KeyOfValue()(
-                *static_cast<const_node_ptr>(x)->val_ptr()), key))
-            {
+            else if (c > 0)
                 x = x->right;
-            }
             else
                 return x;
         }
@@ -1112,13 +1410,117 @@ private:
     const_base_ptr
     _find(const Key& key) const
     {
-        const_base_ptr x = _lower_bound(key);
-        if (x == &_header.header
-            || _comp(key,
-            KeyOfValue()(*static_cast<const_node_ptr>(x)->val_ptr())))
+        const_base_ptr x = _header.header.parent;
+        while (x)
+        {
+            const int c = _compare(key, _key(x));
+            if (c < 0)
+                x = x->left;
+            else if (c > 0)
+                x = x->right;
+            else
+                return x;
+        }
+        return &_header.header;
+    }
+
+    /// Whether [first, last) is strictly increasing, n is its length.
+    template <class ForwardIterator>
+    bool
+    _sorted_unique(ForwardIterator first, ForwardIterator last, size_type& n,
+                   ft::forward_iterator_tag) const
+    {
+        n = 0;
+        if (first == last)
+            return true;
+        ForwardIterator prev = first;
+        for (++first, n = 1; first != last; ++first, ++prev, ++n)
+            if (!_comp(KeyOfValue()(*prev), KeyOfValue()(*first)))
+                return false;
+        return true;
+    }
+
+    template <class InputIterator>
+    bool
+    _sorted_unique(InputIterator, InputIterator, size_type&,
+                   ft::input_iterator_tag) const
+    {
+        return false;
+    }
+
+    /// A forward range is counted first and built in one go.
+    template <class ForwardIterator>
+    void
+    _insert_sorted(ForwardIterator first, ForwardIterator last,
+                   ft::forward_iterator_tag)
+    {
+        _build_sorted(first, ft::distance(first, last));
+    }
+
+    /// A single pass range cannot be counted without using it up. Every
+    /// value goes in with an end() hint instead, which is O(1) amortized
+    /// for sorted input.
+    template <class InputIterator>
+    void
+    _insert_sorted(InputIterator first, InputIterator last,
+                   ft::input_iterator_tag)
+    {
+        for ( ; first != last; ++first)
+            _insert_hint(&_header.header, *first);
+    }
+
+    /// Builds an empty tree from the n sorted values at first in O(n):
+    /// every subtree takes the middle value as its root, so all levels
+    /// but the deepest are full. The deepest level is red when it is
+    /// not full and black otherwise, which gives every path the same
+    /// black height.
+    template <class InputIterator>
+    void
+    _build_sorted(InputIterator& first, size_type n)
+    {
+        if (!n)
+            return;
+        size_type depth = 0;
+        while ((size_type(2) << depth) <= n)
+            ++depth;
+        const size_type red_depth = ((n + 1) & n) ? depth : size_type(-1);
+
+        base_ptr root = _build_sorted(first, n, 0, red_depth);
+        root->parent = &_header.header;
+        _header.header.parent = root;
+        _header.header.left = _Rb_tree_node_base::minimum(root);
+        _header.header.right = _Rb_tree_node_base::maximum(root);
+        _header.count = n;
+    }
+
+    template <class InputIterator>
+    base_ptr
+    _build_sorted(InputIterator& first, size_type n, size_type depth,
+                  size_type red_depth)
+    {
+        if (!n)
+            return NULL;
+        const size_type left_n = (n - 1) / 2;
+        base_ptr left = _build_sorted(first, left_n, depth + 1, red_depth);
+        node_ptr x = NULL;
+        try
         {
-            return &_header.header;
+            x = _node_pool._make_node(*first);
+            x->left = left;
+            x->right = NULL;
+            x->color = depth == red_depth ? RED : BLACK;
+            if (left)
+                left->parent = x;
+            ++first;
+            x->right = _build_sorted(first, n - 1 - left_n, depth + 1, red_depth);
+        }
+        catch (...)
+        {
+            _node_pool._free(x ? x : left);
+            throw;
         }
+        if (x->right)
+            x->right->parent = x;
         return x;
     }
 
@@ -1135,22 +1537,46 @@ private:
     }
 
 private:
+    /// Nodes are carved out of slabs in allocation order, so a tree built
+    /// in one go sits in a few contiguous blocks instead of one heap block
+    /// per node. Freed nodes go on a freelist threaded through parent and
+    /// are handed out again first.
+    ///
+    /// Slabs start small and double up to slab_size() nodes. One extra
+    /// node past the end of every slab is not handed out, it records the
+    /// slab's length and the previous slab. Nodes sit one stride apart:
+    /// the node size, rounded up to the alignment the allocator promises,
+    /// so every node keeps that alignment.
+    ///
+    /// release_unused() gives back the slabs none of whose nodes are in
+    /// use; nodes never move, so it cannot do anything about a slab with
+    /// one live node left. Once more than cache_limit() nodes are cached
+    /// the pool does that by itself.
     class _Node_pool
     {
     public:
+        enum { _first_slab = 8 };
+
         _Node_pool(const node_allocator& alloc)
             : _stack_ptr(NULL),
+            _slabs(NULL),
+            _slab_cur(NULL),
+            _slab_end(NULL),
+            _next_slab(_default_slab_size() < _first_slab
+                ? _default_slab_size() : size_type(_first_slab)),
+            _slab_size(_default_slab_size()),
+            _slab_count(0),
+            _capacity(0),
+            _free_count(0),
+            _reserved(0),
+            _cache_limit(size_type(-1)),
+            _trim_at(size_type(-1)),
             _alloc(alloc)
         {}
 
         ~_Node_pool()
         {
-            while (_stack_ptr)
-            {
-                base_ptr tmp = _stack_ptr;
-                _stack_ptr = _stack_ptr->parent;
-                _alloc.deallocate(static_cast<node_ptr>(tmp), 1);
-            }
+            _release_slabs();
         }
 
         node_allocator get_allocator() const
@@ -1158,20 +1584,112 @@ private:
             return _alloc;
         }
 
+        size_type
+        slab_size() const
+        {
+            return _slab_size;
+        }
+
+        void
+        slab_size(size_type n)
+        {
+            _slab_size = n ? n : 1;
+            if (_next_slab > _slab_size)
+                _next_slab = _slab_size;
+        }
+
+        size_type
+        cache_limit() const
+        {
+            return _cache_limit;
+        }
+
+        void
+        cache_limit(size_type n)
+        {
+            _cache_limit = n;
+            _trim_at = n;
+            if (_cached() > _trim_at)
+                _trim();
+        }
+
+        node_pool_stats
+        stats() const
+        {
+            node_pool_stats st;
+            st.cached_nodes = _cached();
+            st.live_nodes = _capacity - st.cached_nodes;
+            st.slabs = _slab_count;
+            st.reserved_bytes = _reserved;
+            return st;
+        }
+
+        /// Deallocates every slab without a live node, returns the bytes
+        /// given back.
+        size_type
+        release_unused()
+        {
+            const node_pool_stats before = stats();
+            if (!before.live_nodes)
+                _release_slabs();
+            else if (before.cached_nodes)
+                _release_empty_slabs();
+            return before.reserved_bytes - stats().reserved_bytes;
+        }
+
+        void
+        swap(_Node_pool& other)
+        {
+            ft::swap(_stack_ptr, other._stack_ptr);
+            ft::swap(_slabs, other._slabs);
+            ft::swap(_slab_cur, other._slab_cur);
+            ft::swap(_slab_end, other._slab_end);
+            ft::swap(_next_slab, other._next_slab);
+            ft::swap(_slab_size, other._slab_size);
+            ft::swap(_slab_count, other._slab_count);
+            ft::swap(_capacity, other._capacity);
+            ft::swap(_free_count, other._free_count);
+            ft::swap(_reserved, other._reserved);
+            ft::swap(_cache_limit, other._cache_limit);
+            ft::swap(_trim_at, other._trim_at);
+            ft::swap(_alloc, other._alloc);
+        }
+
+#ifdef FT_CXX11
+        template <typename... _Args>
+        node_ptr
+        _make_node(_Args&&... args)
+        {
+            node_ptr n = _get_node();
+            try
+            {
+                allocator_type().construct(n->val_ptr(),
+                                           std::forward<_Args>(args)...);
+            }
+            catch (...)
+            {
+                _put_node(n);
+                throw;
+            }
+            return n;
+        }
+#else
         node_ptr
         _make_node(const_reference val)
         {
-            node_ptr n;
-            if (_stack_ptr)
+            node_ptr n = _get_node();
+            try
             {
-                n = static_cast<node_ptr>(_stack_ptr);
-                _stack_ptr = _stack_ptr->parent;
+                allocator_type().construct(n->val_ptr(), val);
+            }
+            catch (...)
+            {
+                _put_node(n);
+                throw;
             }
-            else
-                n = _alloc.allocate(1);
-            allocator_type().construct(n->val_ptr(), val);
             return n;
         }
+#endif
 
         void
         _free(base_ptr x)
@@ -1188,12 +1706,13 @@ private:
         _free_node(base_ptr x)
         {
             _alloc.destroy(static_cast<node_ptr>(x));
-            x->left = NULL;
-            x->right = NULL;
-            x->parent = _stack_ptr;
-            _stack_ptr = x;
+            _put_node(x);
+            const size_type cached = _cached();
+            if (cached > _trim_at || (cached > _cache_limit && cached == _capacity))
+                _trim();
         }
 
+        /// Destroys the values only, the memory goes with the slabs.
         void
         _destroy(base_ptr x)
         {
@@ -1201,20 +1720,222 @@ private:
             {
                 _destroy(x->left);
                 _destroy(x->right);
-                _destroy_node(x);
+                _alloc.destroy(static_cast<node_ptr>(x));
+            }
+        }
+
+    private:
+        /// About 16 KiB worth of nodes.
+        static size_type
+        _default_slab_size()
+        {
+            size_type n = 16384 / _stride();
+            return n < _first_slab ? size_type(_first_slab) : n;
+        }
+
+        /// Bytes from one node of a slab to the next.
+        static size_type
+        _stride()
+        {
+            const size_type node = sizeof(_Rb_tree_node<value_type>);
+            const size_type align = ft::allocator_alignment<node_allocator>::value;
+            return align ? (node + align - 1) / align * align : node;
+        }
+
+        /// Nodes to ask the allocator for to hold n strides and the record.
+        static size_type
+        _slab_nodes(size_type n)
+        {
+            const size_type node = sizeof(_Rb_tree_node<value_type>);
+            return ((n + 1) * _stride() + node - 1) / node;
+        }
+
+        static node_ptr
+        _advance(node_ptr x, std::ptrdiff_t n)
+        {
+            return reinterpret_cast<node_ptr>(
+                reinterpret_cast<char*>(x) + n * std::ptrdiff_t(_stride()));
+        }
+
+        static size_type
+        _distance(const_node_ptr first, const_node_ptr last)
+        {
+            return (reinterpret_cast<const char*>(last)
+                    - reinterpret_cast<const char*>(first)) / _stride();
+        }
+
+        node_ptr
+        _get_node()
+        {
+            if (_stack_ptr)
+            {
+                node_ptr n = static_cast<node_ptr>(_stack_ptr);
+                _stack_ptr = _stack_ptr->parent;
+                --_free_count;
+                return n;
             }
+            if (_slab_cur == _slab_end)
+                _grow();
+            node_ptr n = _slab_cur;
+            _slab_cur = _advance(_slab_cur, 1);
+            return n;
         }
 
         void
-        _destroy_node(base_ptr x)
+        _put_node(base_ptr x)
         {
-            const node_ptr& n = static_cast<node_ptr>(x);
-            _alloc.destroy(n);
-            _alloc.deallocate(n, 1);
+            x->left = NULL;
+            x->right = NULL;
+            x->parent = _stack_ptr;
+            _stack_ptr = x;
+            ++_free_count;
+        }
+
+        /// Called once the cached nodes passed the limit. The next trim
+        /// waits until what is left doubles, so slabs that cannot be given
+        /// back are not scanned again on every erase.
+        void
+        _trim()
+        {
+            try
+            {
+                release_unused();
+            }
+            catch (...)
+            {
+            }
+            const size_type cached = _cached();
+            _trim_at = cached * 2 > _cache_limit ? cached * 2 : _cache_limit;
+        }
+
+        size_type
+        _cached() const
+        {
+            return _free_count + _distance(_slab_cur, _slab_end);
+        }
+
+        void
+        _grow()
+        {
+            size_type n = _next_slab;
+            node_ptr slab = _alloc.allocate(_slab_nodes(n));
+            node_ptr last = _advance(slab, n);
+            last->parent = _slabs;
+            last->left = reinterpret_cast<base_ptr>(n);
+            _slabs = last;
+            _slab_cur = slab;
+            _slab_end = last;
+            _capacity += n;
+            _reserved += _slab_nodes(n) * sizeof(_Rb_tree_node<value_type>);
+            ++_slab_count;
+            if (_next_slab < _slab_size)
+                _next_slab = _next_slab * 2 < _slab_size ? _next_slab * 2 : _slab_size;
+        }
+
+        void
+        _release_slabs()
+        {
+            while (_slabs)
+            {
+                node_ptr  last = static_cast<node_ptr>(_slabs);
+                size_type n = reinterpret_cast<size_type>(last->left);
+                _slabs = last->parent;
+                _alloc.deallocate(_advance(last, -std::ptrdiff_t(n)), _slab_nodes(n));
+            }
+            _stack_ptr = NULL;
+            _slab_cur = NULL;
+            _slab_end = NULL;
+            _next_slab = _first_slab < _slab_size ? size_type(_first_slab) : _slab_size;
+            _slab_count = 0;
+            _capacity = 0;
+            _free_count = 0;
+            _reserved = 0;
+        }
+
+        typedef typename node_allocator::template rebind<size_type>::other _count_allocator;
+
+        /// Counts the cached nodes of every slab by looking each freelist
+        /// node up among the slab ends sorted by address (the record node
+        /// past a slab is its end), then drops the slabs where all of
+        /// them are.
+        void
+        _release_empty_slabs()
+        {
+            const size_type n = _slab_count;
+            _count_allocator count_alloc(_alloc);
+            size_type* ends = count_alloc.allocate(2 * n);
+            size_type* cached = ends + n;
+            size_type  i = 0;
+            for (base_ptr last = _slabs; last; last = last->parent)
+                ends[i++] = reinterpret_cast<size_type>(last);
+            std::sort(ends, ends + n);
+            for (i = 0; i < n; ++i)
+                cached[i] = 0;
+            if (_slab_cur != _slab_end)
+                cached[_slab_of(ends, n, _slab_cur)] += _distance(_slab_cur, _slab_end);
+            for (base_ptr x = _stack_ptr; x; x = x->parent)
+                ++cached[_slab_of(ends, n, x)];
+
+            base_ptr* link = &_stack_ptr;
+            _free_count = 0;
+            for (base_ptr x = _stack_ptr; x; x = x->parent)
+            {
+                if (_empty_slab(ends, cached, _slab_of(ends, n, x)))
+                    continue;
+                *link = x;
+                link = &x->parent;
+                ++_free_count;
+            }
+            *link = NULL;
+            if (_slab_cur != _slab_end
+                && _empty_slab(ends, cached, _slab_of(ends, n, _slab_cur)))
+                _slab_cur = _slab_end = NULL;
+
+            _slabs = NULL;
+            for (i = 0; i < n; ++i)
+            {
+                node_ptr  last = reinterpret_cast<node_ptr>(ends[i]);
+                size_type length = reinterpret_cast<size_type>(last->left);
+                if (cached[i] == length)
+                {
+                    _alloc.deallocate(_advance(last, -std::ptrdiff_t(length)),
+                                      _slab_nodes(length));
+                    _capacity -= length;
+                    _reserved -= _slab_nodes(length) * sizeof(_Rb_tree_node<value_type>);
+                    --_slab_count;
+                    continue;
+                }
+                last->parent = _slabs;
+                _slabs = last;
+            }
+            count_alloc.deallocate(ends, 2 * n);
+        }
+
+        static size_type
+        _slab_of(const size_type* ends, size_type n, const_base_ptr x)
+        {
+            return std::upper_bound(ends, ends + n, reinterpret_cast<size_type>(x)) - ends;
+        }
+
+        static bool
+        _empty_slab(const size_type* ends, const size_type* cached, size_type i)
+        {
+            return cached[i] == reinterpret_cast<size_type>(
+                reinterpret_cast<const_base_ptr>(ends[i])->left);
         }
 
-    private:
         base_ptr       _stack_ptr;
+        base_ptr       _slabs;
+        node_ptr       _slab_cur;
+        node_ptr       _slab_end;
+        size_type      _next_slab;
+        size_type      _slab_size;
+        size_type      _slab_count;
+        size_type      _capacity;
+        size_type      _free_count;
+        size_type      _reserved;
+        size_type      _cache_limit;
+        size_type      _trim_at;
         node_allocator _alloc;
     };
 
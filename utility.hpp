@@ -1,7 +1,26 @@
 #ifndef UTILITY_H
 #define UTILITY_H
 
-// #include <utility>
+// C++11 builds additionally get move semantics and emplace members,
+// C++98 builds keep the copy-only interface.
+#if __cplusplus >= 201103L
+# define FT_CXX11
+#endif
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include "simd.hpp"
+
+#ifdef FT_CXX11
+# include <utility>
+# define FT_MOVE(x) std::move(x)
+# define FT_FORWARD(T, x) std::forward<T>(x)
+#else
+# define FT_MOVE(x) (x)
+# define FT_FORWARD(T, x) (x)
+#endif
 
 namespace ft {
 
@@ -24,6 +43,21 @@ template <class T1, class T2> struct pair
         return *this;
     }
 
+#ifdef FT_CXX11
+    pair(const pair&) = default;
+    pair(pair&&) = default;
+    template<class U, class V>
+    pair(U&& a, V&& b) : first(std::forward<U>(a)), second(std::forward<V>(b)) {}
+    template<class U, class V>
+    pair(pair<U,V>&& pr)
+        : first(std::forward<U>(pr.first)), second(std::forward<V>(pr.second)) {}
+
+    pair& operator=(pair&& pr) {
+        first = std::move(pr.first); second = std::move(pr.second);
+        return *this;
+    }
+#endif
+
     template<class U1, class U2>
     friend bool operator==(const pair<U1,U2>& lhs, const pair<U1,U2>& rhs);
     template<class U1, class U2>
@@ -41,7 +75,7 @@ template <class T1, class T2> struct pair
 template <class T1,class T2>
 pair<T1,T2> make_pair(T1 x, T2 y)
 {
-    return pair<T1, T2>(x, y);
+    return pair<T1, T2>(FT_MOVE(x), FT_MOVE(y));
 }
 
 template<class T1, class T2>
@@ -101,6 +135,9 @@ struct integral_constant
     operator value_type() const { return value; }
 };
 
+template<typename T, T val>
+const bool integral_constant<T, val>::value;
+
 // The type used as a compile-time boolean with true value.
 typedef integral_constant<bool, true>     true_type;
 // The type used as a compile-time boolean with false value.
@@ -116,7 +153,10 @@ template<> struct is_integral<char>               : public true_type { };
 template<> struct is_integral<signed char>        : public true_type { };
 template<> struct is_integral<unsigned char>      : public true_type { };
 template<> struct is_integral<wchar_t>            : public true_type { };
+#ifdef FT_CXX11
 template<> struct is_integral<char16_t>           : public true_type { };
+template<> struct is_integral<char32_t>           : public true_type { };
+#endif
 template<> struct is_integral<short>              : public true_type { };
 template<> struct is_integral<unsigned short>     : public true_type { };
 template<> struct is_integral<int>                : public true_type { };
@@ -126,6 +166,104 @@ template<> struct is_integral<unsigned long>      : public true_type { };
 template<> struct is_integral<long long>          : public true_type { };
 template<> struct is_integral<unsigned long long> : public true_type { };
 
+// is_same / remove_const
+template<class T, class U> struct is_same : public false_type { };
+template<class T> struct is_same<T, T> : public true_type { };
+
+template<class T> struct remove_const { typedef T type; };
+template<class T> struct remove_const<const T> { typedef T type; };
+
+// is_bitwise_comparable
+// True when two values are equal exactly when their bytes are: integers
+// and pointers, not floating point (0.0 == -0.0, NaN != NaN).
+template<class T> struct is_bitwise_comparable : public is_integral<T> { };
+template<class T> struct is_bitwise_comparable<T*> : public true_type { };
+
+// contiguous_iterator
+// Iterators over elements stored back to back in memory; address(it)
+// returns the element it points to. Specialized for ra_iter in iterator.hpp.
+template<class Iter> struct contiguous_iterator : public false_type { };
+template<class T> struct contiguous_iterator<T*> : public true_type
+{
+    typedef T element_type;
+    static T* address(T* p) { return p; }
+};
+
+// is_trivially_copyable
+#if defined(__GNUC__) || defined(__clang__)
+template<class T> struct is_trivially_copyable
+    : public integral_constant<bool, __is_trivially_copyable(T)> { };
+#else
+template<class T> struct is_trivially_copyable : public is_integral<T> { };
+template<class T> struct is_trivially_copyable<T*> : public true_type { };
+#endif
+
+// is_trivial
+#if defined(__GNUC__) || defined(__clang__)
+template<class T> struct is_trivial
+    : public integral_constant<bool, __is_trivial(T)> { };
+#else
+template<class T> struct is_trivial : public is_integral<T> { };
+template<class T> struct is_trivial<T*> : public true_type { };
+#endif
+
+// is_trivially_relocatable
+// True when moving an object to another address and forgetting the old one
+// can be done with a plain byte copy. Specialize it to opt a type in:
+//     namespace ft {
+//     template<> struct is_trivially_relocatable<Mine> : public true_type { };
+//     }
+template<class T> struct is_trivially_relocatable
+    : public integral_constant<bool, is_trivially_copyable<T>::value> { };
+
+// allocator_has_reallocate
+// True when Alloc has a member
+//     pointer reallocate(pointer p, size_type old_n, size_type new_n);
+template<class Alloc> struct allocator_has_reallocate
+{
+private:
+    typedef typename Alloc::pointer   pointer_;
+    typedef typename Alloc::size_type size_type_;
+
+    template<class U, pointer_ (U::*)(pointer_, size_type_, size_type_)>
+    struct check_ { };
+
+    template<class U> static char test_(check_<U, &U::reallocate>*);
+    template<class U> static long test_(...);
+
+public:
+    static const bool value = sizeof(test_<Alloc>(0)) == sizeof(char);
+};
+
+template<class Alloc>
+const bool allocator_has_reallocate<Alloc>::value;
+
+// allocator_alignment
+// Alloc::alignment when Alloc declares one, the boundary it puts every
+// block on; 0 otherwise.
+template<class Alloc> struct allocator_alignment
+{
+private:
+    template<std::size_t> struct check_ { };
+
+    template<class U> static char test_(check_<U::alignment>*);
+    template<class U> static long test_(...);
+
+    template<bool, class U> struct get_ { static const std::size_t value = 0; };
+    template<class U> struct get_<true, U> { static const std::size_t value = U::alignment; };
+
+public:
+    static const std::size_t value =
+        get_<sizeof(test_<Alloc>(0)) == sizeof(char), Alloc>::value;
+};
+
+template<class Alloc>
+const std::size_t allocator_alignment<Alloc>::value;
+
+// log2_
+// Floor of the base 2 logarithm of N, at compile time.
+template<std::size_t N> struct log2_    { static const std::size_t value = 1 + log2_<N / 2>::value; };
+template<>              struct log2_<1> { static const std::size_t value = 0; };
 
 //-----FUNCTIONAL
 template <typename _Arg, typename _Result>
@@ -189,18 +327,132 @@ struct less : public binary_function<_Tp, _Tp, bool>
     }
 };
 
+// has_compare3
+// True when Compare has a member
+//     int compare3(const Key& a, const Key& b) const;
+// that is negative, zero or positive as a orders before, with or after b,
+// in agreement with its operator(). Trees tell the three apart with one
+// call to it instead of two to operator().
+template <class Compare, class Key> struct has_compare3
+{
+private:
+    template <class U, int (U::*)(const Key&, const Key&) const>
+    struct check_ { };
+
+    template <class U> static char test_(check_<U, &U::compare3>*);
+    template <class U> static long test_(...);
+
+public:
+    static const bool value = sizeof(test_<Compare>(0)) == sizeof(char);
+};
+
+template <class Compare, class Key>
+const bool has_compare3<Compare, Key>::value;
+
+// Strings compare three ways out of the box, their traits compare with
+// memcmp for char.
+template <class C, class Traits, class A>
+struct less<std::basic_string<C, Traits, A> >
+    : public binary_function<std::basic_string<C, Traits, A>,
+                             std::basic_string<C, Traits, A>, bool>
+{
+    bool
+    operator()(const std::basic_string<C, Traits, A>& lhs,
+               const std::basic_string<C, Traits, A>& rhs) const
+    {
+        return lhs.compare(rhs) < 0;
+    }
+
+    int
+    compare3(const std::basic_string<C, Traits, A>& lhs,
+             const std::basic_string<C, Traits, A>& rhs) const
+    {
+        return lhs.compare(rhs);
+    }
+};
+
 //-----------ALGORITHM
 template <class T>
 inline void swap (T& a, T& b)
 {
-    T temp = a;
-    a = b;
-    b = temp;
+    T temp = FT_MOVE(a);
+    a = FT_MOVE(b);
+    b = FT_MOVE(temp);
+}
+
+// Shifts the len elements at src to dst within one buffer, the ranges may
+// overlap. Trivially relocatable elements are moved with memmove, others
+// one at a time with alloc, in the order that does not overwrite any
+// element before it is moved.
+template <class Alloc>
+inline void shift_elements_(Alloc&, typename Alloc::pointer dst, typename Alloc::pointer src,
+                            std::ptrdiff_t len, true_type)
+{
+    std::memmove(static_cast<void*>(dst), static_cast<const void*>(src),
+                 len * sizeof(typename Alloc::value_type));
 }
 
+template <class Alloc>
+void shift_elements_(Alloc& alloc, typename Alloc::pointer dst, typename Alloc::pointer src,
+                     std::ptrdiff_t len, false_type)
+{
+    if (dst < src) {
+        for (std::ptrdiff_t i = 0; i < len; ++i) {
+            alloc.construct(dst + i, FT_MOVE(src[i]));
+            alloc.destroy(src + i);
+        }
+    } else if (dst > src) {
+        for (std::ptrdiff_t i = len - 1; i >= 0; --i) {
+            alloc.construct(dst + i, FT_MOVE(src[i]));
+            alloc.destroy(src + i);
+        }
+    }
+}
+
+template <class Alloc>
+inline void shift_elements(Alloc& alloc, typename Alloc::pointer dst,
+                           typename Alloc::pointer src, std::ptrdiff_t len)
+{
+    if (len > 0) {
+        shift_elements_(alloc, dst, src, len,
+                        is_trivially_relocatable<typename Alloc::value_type>());
+    }
+}
+
+// Moves the len elements at src into fresh storage at dst that does not
+// overlap them; memcpy for trivially relocatable elements.
+template <class Alloc>
+inline void relocate_elements(Alloc& alloc, typename Alloc::pointer dst,
+                              typename Alloc::pointer src, std::size_t len)
+{
+    if (!len) {
+        return;
+    }
+    if (is_trivially_relocatable<typename Alloc::value_type>::value) {
+        std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src),
+                    len * sizeof(typename Alloc::value_type));
+    } else {
+        shift_elements_(alloc, dst, src, len, false_type());
+    }
+}
+
+// Ranges over the same bitwise comparable type in contiguous memory are
+// compared with the byte kernels from simd.hpp.
+template <class It1, class It2, bool = contiguous_iterator<It1>::value
+                                    && contiguous_iterator<It2>::value>
+struct bitwise_range_ : public false_type { };
+
+template <class It1, class It2>
+struct bitwise_range_<It1, It2, true> : public integral_constant<bool,
+    is_same<typename remove_const<typename contiguous_iterator<It1>::element_type>::type,
+            typename remove_const<typename contiguous_iterator<It2>::element_type>::type>::value
+    && is_bitwise_comparable<typename remove_const<
+            typename contiguous_iterator<It1>::element_type>::type>::value> { };
+
 template <class InputIterator1, class InputIterator2>
-inline bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
-                                    InputIterator2 first2, InputIterator2 last2)
+inline bool lexicographical_compare_(InputIterator1 first1, InputIterator1 last1,
+                                     InputIterator2 first2, InputIterator2 last2,
+                                     false_type)
 {
     // while (first1!=last1) {
     //     if (first2==last2 || *first2<*first1) return false;
@@ -216,6 +468,34 @@ inline bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
     return first1 == last1 && first2 != last2;
 }
 
+template <class It1, class It2>
+inline bool lexicographical_compare_(It1 first1, It1 last1,
+                                     It2 first2, It2 last2, true_type)
+{
+    std::ptrdiff_t len1 = last1 - first1;
+    std::ptrdiff_t len2 = last2 - first2;
+    std::size_t    len = len1 < len2 ? len1 : len2;
+    std::size_t    size = sizeof(typename contiguous_iterator<It1>::element_type);
+
+    if (!len)
+        return len1 < len2;
+    std::size_t i = simd::mismatch(contiguous_iterator<It1>::address(first1),
+                                   contiguous_iterator<It2>::address(first2),
+                                   len * size) / size;
+    if (i == len)
+        return len1 < len2;
+    return contiguous_iterator<It1>::address(first1)[i]
+         < contiguous_iterator<It2>::address(first2)[i];
+}
+
+template <class InputIterator1, class InputIterator2>
+inline bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+                                    InputIterator2 first2, InputIterator2 last2)
+{
+    return lexicographical_compare_(first1, last1, first2, last2,
+                                    bitwise_range_<InputIterator1, InputIterator2>());
+}
+
 template <class InputIterator1, class InputIterator2, class Compare>
 inline bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
                                     InputIterator2 first2, InputIterator2 last2,
@@ -230,8 +510,8 @@ inline bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
 }
 
 template <class InputIterator1, class InputIterator2>
-inline bool equal(InputIterator1 first1, InputIterator1 last1,
-                  InputIterator2 first2/* , InputIterator2 last2 */)
+inline bool equal_(InputIterator1 first1, InputIterator1 last1,
+                   InputIterator2 first2, false_type)
 {
     for (; first1 != last1; ++first1, ++first2) {
         if (*first1 != *first2) return false;
@@ -239,6 +519,26 @@ inline bool equal(InputIterator1 first1, InputIterator1 last1,
     return true;
 }
 
+template <class It1, class It2>
+inline bool equal_(It1 first1, It1 last1, It2 first2, true_type)
+{
+    std::size_t bytes = (last1 - first1)
+                      * sizeof(typename contiguous_iterator<It1>::element_type);
+
+    return !bytes
+        || simd::mismatch(contiguous_iterator<It1>::address(first1),
+                          contiguous_iterator<It2>::address(first2),
+                          bytes) == bytes;
+}
+
+template <class InputIterator1, class InputIterator2>
+inline bool equal(InputIterator1 first1, InputIterator1 last1,
+                  InputIterator2 first2/* , InputIterator2 last2 */)
+{
+    return equal_(first1, last1, first2,
+                  bitwise_range_<InputIterator1, InputIterator2>());
+}
+
 template <class InputIterator1, class InputIterator2, class BinaryPredicate>
 inline bool equal(InputIterator1 first1, InputIterator1 last1,
                   InputIterator2 first2, BinaryPredicate pred)
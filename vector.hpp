@@ -2,13 +2,19 @@
 #define VECTOR_H
 
 #include <memory>
+#include <cstring>
+#include <new>
+#include <stdexcept>
 
+#include "growth_policy.hpp"
 #include "iterator.hpp"
+#include "parallel.hpp"
 #include "utility.hpp"
 
 namespace ft {
 
-template <class T, class Allocator = std::allocator<T> >
+template <class T, class Allocator = std::allocator<T>,
+          class GrowthPolicy = ft::growth_2x>
 class vector
 {
 public:
@@ -26,6 +32,13 @@ public:
     typedef ft::reverse_iterator<const_iterator>     const_reverse_iterator;
     typedef typename allocator_type::difference_type difference_type;
     typedef std::size_t                              size_type;
+    typedef GrowthPolicy                             growth_policy_type;
+
+    struct footprint_type
+    {
+        size_type used_bytes;     // held by the elements
+        size_type reserved_bytes; // allocated, capacity() elements
+    };
 
 // Constructors
     explicit vector(const allocator_type& alloc = allocator_type());
@@ -36,10 +49,20 @@ public:
                     const allocator_type& alloc = allocator_type(),
                     typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type = 0);
              vector(const vector& x);
+#ifdef FT_CXX11
+             vector(vector&& x);
+             vector(size_type n, const value_type& val,
+                    const ft::parallel_policy& par,
+                    const allocator_type& alloc = allocator_type());
+             vector(const vector& x, const ft::parallel_policy& par);
+#endif
 
     ~vector();
 
     vector& operator=(const vector& x);
+#ifdef FT_CXX11
+    vector& operator=(vector&& x);
+#endif
 
 // Iterators
     iterator               begin()        { return iterator(begin_);                }
@@ -55,9 +78,14 @@ public:
     size_type size() const     { return size_; }
     size_type max_size()       { return alloc_.max_size(); }
     void      resize(size_type n, value_type val = value_type());
+    void      resize_default_init(size_type n);
+    pointer   append_uninitialized(size_type n);
     size_type capacity() const { return capacity_; }
     bool      empty() const    { return !size_; }
     void      reserve(size_type n);
+    void      shrink_to_fit() { shrink_to(size_); }
+    void      shrink_to(size_type n);
+    footprint_type memory_footprint() const;
 
 // Element access
     reference       operator[](size_type n)       { return begin_[n]; }
@@ -74,10 +102,24 @@ public:
     void     assign(InputIterator first, InputIterator last,
                     typename ft::enable_if<
                     !ft::is_integral<InputIterator>::value, bool>::type = 0);
-    void     assign(size_type n, const value_type& val) { resize(n, val); }
+    void     assign(size_type n, const value_type& val);
+#ifdef FT_CXX11
+    void     assign(size_type n, const value_type& val,
+                    const ft::parallel_policy& par);
+    void     assign(const vector& x, const ft::parallel_policy& par);
+#endif
     void     push_back(const value_type& val);
     void     pop_back();
     iterator insert(iterator position, const value_type& val);
+#ifdef FT_CXX11
+    void     push_back(value_type&& val) { emplace_back(std::move(val)); }
+    iterator insert(iterator position, value_type&& val)
+                    { return emplace(position, std::move(val)); }
+    template <class... Args>
+    void     emplace_back(Args&&... args);
+    template <class... Args>
+    iterator emplace(iterator position, Args&&... args);
+#endif
     void     insert(iterator position, size_type n, const value_type& val);
     template <class InputIterator>
     void     insert(iterator position, InputIterator first, InputIterator last,
@@ -91,36 +133,102 @@ public:
 // Allocator
     allocator_type get_allocator() const { return alloc_; }
 
+// Growth policy
+    growth_policy_type&       growth_policy()       { return growth_; }
+    const growth_policy_type& growth_policy() const { return growth_; }
+
 // Non-member function overloads
-    template <class U, class Alloc>
-    friend bool operator==(const vector<U,Alloc>& lhs, const vector<U,Alloc>& rhs);
-    template <class U, class Alloc>
-    friend bool operator!=(const vector<U,Alloc>& lhs, const vector<U,Alloc>& rhs);
-    template <class U, class Alloc>
-    friend bool operator< (const vector<U,Alloc>& lhs, const vector<U,Alloc>& rhs);
-    template <class U, class Alloc>
-    friend bool operator<=(const vector<U,Alloc>& lhs, const vector<U,Alloc>& rhs);
-    template <class U, class Alloc>
-    friend bool operator> (const vector<U,Alloc>& lhs, const vector<U,Alloc>& rhs);
-    template <class U, class Alloc>
-    friend bool operator>=(const vector<U,Alloc>& lhs, const vector<U,Alloc>& rhs);
-    template <class U, class Alloc>
-    friend void swap(vector<U,Alloc>& x, vector<U,Alloc>& y);
+    template <class U, class Alloc, class G>
+    friend bool operator==(const vector<U,Alloc,G>& lhs, const vector<U,Alloc,G>& rhs);
+    template <class U, class Alloc, class G>
+    friend bool operator!=(const vector<U,Alloc,G>& lhs, const vector<U,Alloc,G>& rhs);
+    template <class U, class Alloc, class G>
+    friend bool operator< (const vector<U,Alloc,G>& lhs, const vector<U,Alloc,G>& rhs);
+    template <class U, class Alloc, class G>
+    friend bool operator<=(const vector<U,Alloc,G>& lhs, const vector<U,Alloc,G>& rhs);
+    template <class U, class Alloc, class G>
+    friend bool operator> (const vector<U,Alloc,G>& lhs, const vector<U,Alloc,G>& rhs);
+    template <class U, class Alloc, class G>
+    friend bool operator>=(const vector<U,Alloc,G>& lhs, const vector<U,Alloc,G>& rhs);
+    template <class U, class Alloc, class G>
+    friend void swap(vector<U,Alloc,G>& x, vector<U,Alloc,G>& y);
+    template <class U, class Alloc, class G, class Predicate>
+    friend typename vector<U,Alloc,G>::size_type erase_if(vector<U,Alloc,G>& c, Predicate pred);
+    template <class U, class Alloc, class G>
+    friend typename vector<U,Alloc,G>::size_type erase(vector<U,Alloc,G>& c,
+                                                       const typename vector<U,Alloc,G>::value_type& value);
 
 private:
-    allocator_type alloc_;
-    pointer        begin_;
-    size_type      size_;
-    size_type      capacity_;
+    allocator_type     alloc_;
+    growth_policy_type growth_;
+    pointer            begin_;
+    size_type          size_;
+    size_type          capacity_;
+
+    typedef ft::is_trivially_relocatable<value_type> relocatable_;
+    typedef ft::integral_constant<bool, relocatable_::value
+        && ft::allocator_has_reallocate<allocator_type>::value> reallocatable_;
+
+    size_type next_capacity_(size_type n) const;
 
     void    move_(pointer dst, pointer src, difference_type len);
+    void    relocate_(pointer dst, pointer src, size_type len);
+    void    close_gap_(pointer pos, size_type built, size_type gap, size_type len);
+    bool    reallocate_(size_type n, ft::true_type);
+    bool    reallocate_(size_type, ft::false_type) { return false; }
+    void    construct_fill_(pointer p, size_type n, const value_type& val);
+    void    construct_fill_(pointer p, size_type n, const value_type& val,
+                            ft::true_type);
+    void    construct_fill_(pointer p, size_type n, const value_type& val,
+                            ft::false_type);
+    void    construct_copy_(pointer dst, const_pointer src, size_type n);
+    void    assign_copy_(const_pointer src, size_type n);
+    void    construct_copy_(pointer dst, const_pointer src, size_type n,
+                            ft::true_type);
+    void    construct_copy_(pointer dst, const_pointer src, size_type n,
+                            ft::false_type);
+#ifdef FT_CXX11
+    template <class Chunk>
+    void    parallel_construct_(size_type n, const ft::parallel_policy& par,
+                                Chunk chunk);
+#endif
+    void    default_init_(size_type n, ft::true_type) { size_ = n; }
+    void    default_init_(size_type n, ft::false_type);
+
+    template <class InputIterator>
+    void    range_init_(InputIterator first, InputIterator last,
+                        ft::input_iterator_tag);
+    template <class ForwardIterator>
+    void    range_init_(ForwardIterator first, ForwardIterator last,
+                        ft::forward_iterator_tag);
+    template <class InputIterator>
+    void    range_assign_(InputIterator first, InputIterator last,
+                          ft::input_iterator_tag);
+    template <class ForwardIterator>
+    void    range_assign_(ForwardIterator first, ForwardIterator last,
+                          ft::forward_iterator_tag);
+    template <class InputIterator>
+    void    range_insert_(iterator position, InputIterator first,
+                          InputIterator last, ft::input_iterator_tag);
+    template <class ForwardIterator>
+    void    range_insert_(iterator position, ForwardIterator first,
+                          ForwardIterator last, ft::forward_iterator_tag);
+    template <class Predicate>
+    size_type remove_if_(Predicate pred);
     void    destroy_();
+
+    struct equals_
+    {
+        explicit equals_(const value_type& v) : val(v) {}
+        bool operator()(const value_type& x) const { return x == val; }
+        const value_type& val;
+    };
 };
 
 /***** Constructors *****/
 
-template <class T, class Allocator>
-vector<T, Allocator>::vector(const allocator_type& alloc)
+template <class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector(const allocator_type& alloc)
     : alloc_(alloc)
     , begin_(NULL)
     , size_(0)
@@ -128,40 +236,43 @@ vector<T, Allocator>::vector(const allocator_type& alloc)
 {
 }
 
-template <class T, class Allocator>
-vector<T, Allocator>::vector(size_type n, const value_type& val, const allocator_type& alloc)
+template <class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector(size_type n, const value_type& val, const allocator_type& alloc)
     : alloc_(alloc)
     , begin_(alloc_.allocate(n))
     , size_(0)
     , capacity_(n)
 {
-    while (size_ < n) {
-        alloc_.construct(begin_ + size_++, val);
+    try {
+        construct_fill_(begin_, n, val);
     }
+    catch (...) {
+        alloc_.deallocate(begin_, capacity_);
+        throw;
+    }
+    size_ = n;
 }
 
-template <class T, class Allocator>
+template <class T, class Allocator, class GrowthPolicy>
     template <class InputIterator>
-vector<T, Allocator>::vector(InputIterator first, InputIterator last, const allocator_type& alloc,
+vector<T, Allocator, GrowthPolicy>::vector(InputIterator first, InputIterator last, const allocator_type& alloc,
 typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type)
     : alloc_(alloc)
-    , begin_(alloc_.allocate(last - first))
+    , begin_(NULL)
     , size_(0)
-    , capacity_(last - first)
+    , capacity_(0)
 {
-    for (; first != last; ++first, ++size_) {
-        try {
-            alloc_.construct(begin_ + size_, *first);
-        }
-        catch (...) {
-            destroy_();
-            throw;
-        }
+    try {
+        range_init_(first, last, ft::iterator_category(first));
+    }
+    catch (...) {
+        destroy_();
+        throw;
     }
 }
 
-template <class T, class Allocator>
-vector<T, Allocator>::vector(const vector& x)
+template <class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector(const vector& x)
     : alloc_(x.alloc_)
     , begin_(NULL)
     , size_(0)
@@ -170,50 +281,121 @@ vector<T, Allocator>::vector(const vector& x)
     *this = x;
 }
 
-template <class T, class Allocator>
-vector<T, Allocator>::~vector()
+#ifdef FT_CXX11
+template <class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector(vector&& x)
+    : alloc_(std::move(x.alloc_))
+    , begin_(x.begin_)
+    , size_(x.size_)
+    , capacity_(x.capacity_)
+{
+    x.begin_ = NULL;
+    x.size_ = 0;
+    x.capacity_ = 0;
+}
+#endif
+
+#ifdef FT_CXX11
+template <class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector(size_type n, const value_type& val,
+                                           const ft::parallel_policy& par,
+                                           const allocator_type& alloc)
+    : alloc_(alloc)
+    , begin_(alloc_.allocate(n))
+    , size_(0)
+    , capacity_(n)
+{
+    try {
+        parallel_construct_(n, par, [&](size_type first, size_type last) {
+            construct_fill_(begin_ + first, last - first, val);
+        });
+    }
+    catch (...) {
+        alloc_.deallocate(begin_, capacity_);
+        throw;
+    }
+    size_ = n;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector(const vector& x,
+                                           const ft::parallel_policy& par)
+    : alloc_(x.alloc_)
+    , begin_(NULL)
+    , size_(0)
+    , capacity_(0)
+{
+    try {
+        assign(x, par);
+    }
+    catch (...) {
+        destroy_();
+        throw;
+    }
+}
+#endif
+
+template <class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::~vector()
 {
     destroy_();
 }
 
-template <class T, class Allocator>
-vector<T, Allocator>& vector<T, Allocator>::operator=(const vector& other)
+template <class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>& vector<T, Allocator, GrowthPolicy>::operator=(const vector& other)
 {
     if (this == &other)
         return *this;
-    clear();
     alloc_ = other.alloc_;
-    reserve(other.size_);
-    while (size_ < other.size_) {
-        alloc_.construct(begin_ + size_, other[size_]);
-        ++size_;
-    }
+    assign_copy_(other.begin_, other.size_);
+    return *this;
+}
+
+#ifdef FT_CXX11
+template <class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>& vector<T, Allocator, GrowthPolicy>::operator=(vector&& other)
+{
+    if (this == &other)
+        return *this;
+    destroy_();
+    alloc_ = std::move(other.alloc_);
+    begin_ = other.begin_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    other.begin_ = NULL;
+    other.size_ = 0;
+    other.capacity_ = 0;
     return *this;
 }
+#endif
 
 /***** Capacity *****/
 
-template <class T, class Allocator>
-void vector<T, Allocator>::resize(size_type n, value_type val)
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::resize(size_type n, value_type val)
 {
     while (n < size_) {
         alloc_.destroy(begin_ + --size_);
     }
     reserve(n);
-    while (size_ < n) {
-        alloc_.construct(begin_ + size_++, val);
+    if (size_ < n) {
+        construct_fill_(begin_ + size_, n - size_, val);
+        size_ = n;
     }
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::reserve(size_type n)
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::reserve(size_type n)
 {
     if (n <= capacity_) {
         return;
     }
+    if (capacity_ && reallocate_(next_capacity_(n), reallocatable_())) {
+        growth_.reallocated(0);
+        return;
+    }
     size_type old_cap = capacity_;
-    if (capacity_ && n < capacity_ << 1) capacity_ <<= 1;
-    else capacity_ = n;
+    capacity_ = next_capacity_(n);
     pointer old = begin_;
     try {
         begin_ = alloc_.allocate(capacity_);
@@ -222,22 +404,81 @@ void vector<T, Allocator>::reserve(size_type n)
         destroy_();
         throw;
     }
-    move_(begin_, old, size_);
+    relocate_(begin_, old, size_);
     alloc_.deallocate(old, old_cap);
+    if (old_cap) {
+        growth_.reallocated(size_ * sizeof(value_type));
+    }
+}
+
+// Lowers the capacity to max(n, size()), giving the rest back to the
+// allocator.
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::shrink_to(size_type n)
+{
+    if (n < size_) {
+        n = size_;
+    }
+    if (n >= capacity_) {
+        return;
+    }
+    if (n && reallocate_(n, reallocatable_())) {
+        growth_.reallocated(0);
+        return;
+    }
+    pointer new_begin = n ? alloc_.allocate(n) : NULL;
+    relocate_(new_begin, begin_, size_);
+    alloc_.deallocate(begin_, capacity_);
+    begin_ = new_begin;
+    capacity_ = n;
+    growth_.reallocated(size_ * sizeof(value_type));
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::footprint_type
+vector<T, Allocator, GrowthPolicy>::memory_footprint() const
+{
+    footprint_type fp;
+    fp.used_bytes = size_ * sizeof(value_type);
+    fp.reserved_bytes = capacity_ * sizeof(value_type);
+    return fp;
+}
+
+// Like resize, but new elements are default-initialized: trivial types
+// are left with whatever the memory held, ready to be overwritten by a
+// read() or memcpy.
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::resize_default_init(size_type n)
+{
+    while (n < size_) {
+        alloc_.destroy(begin_ + --size_);
+    }
+    reserve(n);
+    default_init_(n, ft::is_trivial<value_type>());
+}
+
+// Grows the vector by n default-initialized elements and returns the first.
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::pointer
+vector<T, Allocator, GrowthPolicy>::append_uninitialized(size_type n)
+{
+    size_type old_size = size_;
+    resize_default_init(size_ + n);
+    return begin_ + old_size;
 }
 
 /***** Element access *****/
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::reference vector<T, Allocator>::at(size_type n)
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::reference vector<T, Allocator, GrowthPolicy>::at(size_type n)
 {
     if (n < 0 || n >= size_)
         throw std::out_of_range("vector");
     return begin_[n];
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::const_reference vector<T, Allocator>::at(size_type n) const
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::const_reference vector<T, Allocator, GrowthPolicy>::at(size_type n) const
 {
     if (n < 0 || n >= size_)
         throw std::out_of_range("vector");
@@ -246,37 +487,143 @@ typename vector<T, Allocator>::const_reference vector<T, Allocator>::at(size_typ
 
 /***** Modifiers *****/
 
-template <class T, class Allocator>
+template <class T, class Allocator, class GrowthPolicy>
     template <class InputIterator>
-void vector<T, Allocator>::assign(InputIterator first, InputIterator last,
+void vector<T, Allocator, GrowthPolicy>::assign(InputIterator first, InputIterator last,
 typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type)
 {
-    resize(last - first);
-    size_ = 0;
-    while (first != last) {
-        begin_[size_++] = *first;
-        ++first;
+    range_assign_(first, last, ft::iterator_category(first));
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::assign(size_type n, const value_type& val)
+{
+    if (&val >= begin_ && &val < begin_ + size_) {
+        value_type copy(val);
+        assign(n, copy);
+        return;
+    }
+    if (n > capacity_) {
+        clear();
+        reserve(n);
+        construct_fill_(begin_, n, val);
+        size_ = n;
+        return;
+    }
+    for (size_type i = 0; i < n && i < size_; ++i) {
+        begin_[i] = val;
+    }
+    if (n > size_) {
+        construct_fill_(begin_ + size_, n - size_, val);
+        size_ = n;
+    }
+    while (size_ > n) {
+        alloc_.destroy(begin_ + --size_);
+    }
+}
+
+#ifdef FT_CXX11
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::assign(size_type n, const value_type& val,
+                                                const ft::parallel_policy& par)
+{
+    if (&val >= begin_ && &val < begin_ + size_) {
+        value_type copy(val);
+        assign(n, copy, par);
+        return;
     }
+    clear();
+    reserve(n);
+    parallel_construct_(n, par, [&](size_type first, size_type last) {
+        construct_fill_(begin_ + first, last - first, val);
+    });
+    size_ = n;
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::push_back(const value_type& val)
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::assign(const vector& x,
+                                                const ft::parallel_policy& par)
 {
+    if (this == &x) {
+        return;
+    }
+    clear();
+    reserve(x.size_);
+    parallel_construct_(x.size_, par, [&](size_type first, size_type last) {
+        construct_copy_(begin_ + first, x.begin_ + first, last - first);
+    });
+    size_ = x.size_;
+}
+#endif
+
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::push_back(const value_type& val)
+{
+#ifdef FT_CXX11
+    emplace_back(val);
+#else
+    if (size_ == capacity_ && &val >= begin_ && &val < begin_ + size_) {
+        value_type copy(val);
+        reserve(size_ + 1);
+        alloc_.construct(begin_ + size_++, copy);
+        return;
+    }
     reserve(size_ + 1);
     alloc_.construct(begin_ + size_++, val);
+#endif
+}
+
+#ifdef FT_CXX11
+template <class T, class Allocator, class GrowthPolicy>
+    template <class... Args>
+void vector<T, Allocator, GrowthPolicy>::emplace_back(Args&&... args)
+{
+    if (size_ < capacity_) {
+        alloc_.construct(begin_ + size_, std::forward<Args>(args)...);
+        ++size_;
+        return;
+    }
+    if (reallocatable_::value) {
+        // the buffer may be grown in place, args must not refer into it
+        value_type tmp(std::forward<Args>(args)...);
+        reserve(size_ + 1);
+        alloc_.construct(begin_ + size_, std::move(tmp));
+        ++size_;
+        return;
+    }
+    // The new element is built before the old ones are relocated,
+    // so args may still refer to elements of this vector.
+    size_type new_cap = next_capacity_(size_ + 1);
+    pointer   new_begin = alloc_.allocate(new_cap);
+    try {
+        alloc_.construct(new_begin + size_, std::forward<Args>(args)...);
+    }
+    catch (...) {
+        alloc_.deallocate(new_begin, new_cap);
+        throw;
+    }
+    relocate_(new_begin, begin_, size_);
+    alloc_.deallocate(begin_, capacity_);
+    if (capacity_) {
+        growth_.reallocated(size_ * sizeof(value_type));
+    }
+    begin_ = new_begin;
+    capacity_ = new_cap;
+    ++size_;
 }
+#endif
 
-template <class T, class Allocator>
-void vector<T, Allocator>::pop_back()
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::pop_back()
 {
     if (size_) {
         alloc_.destroy(begin_ + --size_);
     }
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::iterator
-vector<T, Allocator>::insert(iterator position, const value_type& val)
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator
+vector<T, Allocator, GrowthPolicy>::insert(iterator position, const value_type& val)
 {
     difference_type shift = &*position - begin_;
 
@@ -288,46 +635,63 @@ vector<T, Allocator>::insert(iterator position, const value_type& val)
     return iterator(pos);
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::insert(iterator position, size_type n, const value_type& val)
+#ifdef FT_CXX11
+template <class T, class Allocator, class GrowthPolicy>
+    template <class... Args>
+typename vector<T, Allocator, GrowthPolicy>::iterator
+vector<T, Allocator, GrowthPolicy>::emplace(iterator position, Args&&... args)
 {
-    difference_type shift = &*position - begin_;
+    difference_type shift = position - begin();
 
-    reserve(size_ + n);
-    pointer pos = begin_ + shift;
-    move_(pos + n, pos, size_ - shift);
-    size_ += n;
-    for (; n != 0; pos++, --n) {
-        alloc_.construct(pos, val);
+    if (position == end()) {
+        emplace_back(std::forward<Args>(args)...);
+        return begin() + shift;
     }
+    value_type tmp(std::forward<Args>(args)...);
+    reserve(size_ + 1);
+    pointer pos = begin_ + shift;
+    move_(pos + 1, pos, size_ - shift);
+    ++size_;
+    alloc_.construct(pos, std::move(tmp));
+    return iterator(pos);
 }
+#endif
 
-template <class T, class Allocator>
-    template <class InputIterator>
-void vector<T, Allocator>::insert(iterator position, InputIterator first, InputIterator last,
-typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type)
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::insert(iterator position, size_type n, const value_type& val)
 {
+    if (&val >= begin_ && &val < begin_ + size_) {
+        value_type copy(val);
+        insert(position, n, copy);
+        return;
+    }
     difference_type shift = &*position - begin_;
-    difference_type n = last - first;
 
     reserve(size_ + n);
     pointer pos = begin_ + shift;
     move_(pos + n, pos, size_ - shift);
-    size_ += n;
-    for (; first != last; ++first, ++pos) {
-        try {
-            alloc_.construct(pos,  *first);
-        }
-        catch (...) {
-            destroy_();
-            throw;
-        }
+    try {
+        construct_fill_(pos, n, val);
+    }
+    catch (...) {
+        // construct_fill_ already destroyed what it built
+        close_gap_(pos, 0, n, size_ - shift);
+        throw;
     }
+    size_ += n;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+    template <class InputIterator>
+void vector<T, Allocator, GrowthPolicy>::insert(iterator position, InputIterator first, InputIterator last,
+typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type)
+{
+    range_insert_(position, first, last, ft::iterator_category(first));
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::iterator
-vector<T, Allocator>::erase(iterator position)
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator
+vector<T, Allocator, GrowthPolicy>::erase(iterator position)
 {
     pointer pos = &*position;
 
@@ -336,30 +700,30 @@ vector<T, Allocator>::erase(iterator position)
     return position;
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::iterator
-vector<T, Allocator>::erase(iterator first, iterator last)
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator
+vector<T, Allocator, GrowthPolicy>::erase(iterator first, iterator last)
 {
     difference_type n = last - first;
 
     for (iterator it = first; it != last; ++it) {
         alloc_.destroy(&*it);
     }
-    move_(&*first, &*first + n, end() - last - 1);
+    move_(&*first, &*last, end() - last);
     size_ -= n;
     return first;
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::swap(vector& x)
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::swap(vector& x)
 {
     ft::swap(begin_, x.begin_);
     ft::swap(size_, x.size_);
     ft::swap(capacity_, x.capacity_);
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::clear()
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::clear()
 {
     while (size_ > 0) {
         alloc_.destroy(begin_ + --size_);
@@ -368,75 +732,442 @@ void vector<T, Allocator>::clear()
 
 /***** Non-member function overloads *****/
 
-template <class U, class Alloc>
-inline bool operator==(const vector<U,Alloc>& lhs, const vector<U,Alloc>& rhs)
+template <class U, class Alloc, class G>
+inline bool operator==(const vector<U,Alloc,G>& lhs, const vector<U,Alloc,G>& rhs)
 {
-    if (lhs.size_ != rhs.size_)
-        return false;
-    for (typename vector<U,Alloc>::size_type i = 0; i < lhs.size_; ++i) {
-        if (lhs[i] != rhs[i])
-            return false;
-    }
-    return true;
+    return lhs.size() == rhs.size()
+        && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class U, class Alloc>
-inline bool operator!=(const vector<U,Alloc>& lhs, const vector<U,Alloc>& rhs)
+template <class U, class Alloc, class G>
+inline bool operator!=(const vector<U,Alloc,G>& lhs, const vector<U,Alloc,G>& rhs)
 {
     return !(lhs == rhs);
 }
 
-template <class U, class Alloc>
-inline bool operator< (const vector<U,Alloc>& lhs, const vector<U,Alloc>& rhs)
+template <class U, class Alloc, class G>
+inline bool operator< (const vector<U,Alloc,G>& lhs, const vector<U,Alloc,G>& rhs)
 {
     return ft::lexicographical_compare(lhs.begin(), lhs.end(),
                                        rhs.begin(), rhs.end());
 }
 
-template <class U, class Alloc>
-inline bool operator<=(const vector<U,Alloc>& lhs, const vector<U,Alloc>& rhs)
+template <class U, class Alloc, class G>
+inline bool operator<=(const vector<U,Alloc,G>& lhs, const vector<U,Alloc,G>& rhs)
 {
     return lhs == rhs || lhs < rhs;
 }
 
-template <class U, class Alloc>
-inline bool operator> (const vector<U,Alloc>& lhs, const vector<U,Alloc>& rhs)
+template <class U, class Alloc, class G>
+inline bool operator> (const vector<U,Alloc,G>& lhs, const vector<U,Alloc,G>& rhs)
 {
     return !(lhs <= rhs);
 }
 
-template <class U, class Alloc>
-inline bool operator>=(const vector<U,Alloc>& lhs, const vector<U,Alloc>& rhs)
+template <class U, class Alloc, class G>
+inline bool operator>=(const vector<U,Alloc,G>& lhs, const vector<U,Alloc,G>& rhs)
 {
     return !(lhs < rhs);
 }
 
-template <class U, class Alloc>
-inline void swap(vector<U,Alloc>& x, vector<U,Alloc>& y)
+template <class U, class Alloc, class G>
+inline void swap(vector<U,Alloc,G>& x, vector<U,Alloc,G>& y)
 {
     x.swap(y);
 }
 
+// Byte vectors as keys order like operator< but compare three ways with
+// memcmp. Only unsigned char, memcmp orders plain char as unsigned.
+template <class Alloc, class G>
+struct less<vector<unsigned char,Alloc,G> >
+    : public binary_function<vector<unsigned char,Alloc,G>,
+                             vector<unsigned char,Alloc,G>, bool>
+{
+    bool operator()(const vector<unsigned char,Alloc,G>& lhs,
+                    const vector<unsigned char,Alloc,G>& rhs) const
+    {
+        return compare3(lhs, rhs) < 0;
+    }
+
+    int compare3(const vector<unsigned char,Alloc,G>& lhs,
+                 const vector<unsigned char,Alloc,G>& rhs) const
+    {
+        const size_t n = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+        const int c = n ? std::memcmp(&lhs[0], &rhs[0], n) : 0;
+        if (c)
+            return c;
+        return lhs.size() < rhs.size() ? -1 : lhs.size() > rhs.size();
+    }
+};
+
+// Removes every element pred holds for in one pass, returns how many.
+template <class U, class Alloc, class G, class Predicate>
+inline typename vector<U,Alloc,G>::size_type erase_if(vector<U,Alloc,G>& c, Predicate pred)
+{
+    return c.remove_if_(pred);
+}
+
+// value is not deduced, so erase(strings, "a") converts it to the element type.
+template <class U, class Alloc, class G>
+typename vector<U,Alloc,G>::size_type erase(vector<U,Alloc,G>& c,
+                                            const typename vector<U,Alloc,G>::value_type& value)
+{
+    if (&value >= c.begin_ && &value < c.begin_ + c.size_) {
+        U copy(value);
+        return c.remove_if_(typename vector<U,Alloc,G>::equals_(copy));
+    }
+    return c.remove_if_(typename vector<U,Alloc,G>::equals_(value));
+}
+
 /***** private *****/
 
-template <class T, class Allocator>
-inline void vector<T, Allocator>::move_(pointer dst, pointer src, difference_type len)
+// One exact allocation when the length is known up front.
+template <class T, class Allocator, class GrowthPolicy>
+    template <class ForwardIterator>
+void vector<T, Allocator, GrowthPolicy>::range_init_(ForwardIterator first,
+                                    ForwardIterator last, ft::forward_iterator_tag)
 {
-    if (dst < src) {
-        for (difference_type i = 0; i < len; ++i) {
-            alloc_.construct(dst + i, src[i]);
-            alloc_.destroy(src + i);
+    capacity_ = ft::distance(first, last);
+    begin_ = alloc_.allocate(capacity_);
+    for (; first != last; ++first, ++size_) {
+        alloc_.construct(begin_ + size_, *first);
+    }
+}
+
+// Single pass ranges are streamed in with the usual geometric growth.
+template <class T, class Allocator, class GrowthPolicy>
+    template <class InputIterator>
+void vector<T, Allocator, GrowthPolicy>::range_init_(InputIterator first,
+                                    InputIterator last, ft::input_iterator_tag)
+{
+    for (; first != last; ++first) {
+        push_back(*first);
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+    template <class ForwardIterator>
+void vector<T, Allocator, GrowthPolicy>::range_assign_(ForwardIterator first,
+                                    ForwardIterator last, ft::forward_iterator_tag)
+{
+    size_type n = ft::distance(first, last);
+    if (n > capacity_) {
+        clear();
+        reserve(n);
+        for (; first != last; ++first, ++size_) {
+            alloc_.construct(begin_ + size_, *first);
+        }
+        return;
+    }
+    size_type i = 0;
+    for (; first != last && i < size_; ++first, ++i) {
+        begin_[i] = *first;
+    }
+    for (; first != last; ++first, ++size_) {
+        alloc_.construct(begin_ + size_, *first);
+    }
+    while (size_ > n) {
+        alloc_.destroy(begin_ + --size_);
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+    template <class InputIterator>
+void vector<T, Allocator, GrowthPolicy>::range_assign_(InputIterator first,
+                                    InputIterator last, ft::input_iterator_tag)
+{
+    size_type i = 0;
+    for (; first != last && i < size_; ++first, ++i) {
+        begin_[i] = *first;
+    }
+    if (first != last) {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+        return;
+    }
+    while (size_ > i) {
+        alloc_.destroy(begin_ + --size_);
+    }
+}
+
+// Single pass ranges are appended in place at the end. Anywhere else they
+// are read into a temporary first, the gap needs their length.
+template <class T, class Allocator, class GrowthPolicy>
+    template <class InputIterator>
+void vector<T, Allocator, GrowthPolicy>::range_insert_(iterator position,
+            InputIterator first, InputIterator last, ft::input_iterator_tag)
+{
+    if (position == end()) {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+        return;
+    }
+    vector tmp(first, last, alloc_);
+    range_insert_(position, tmp.begin(), tmp.end(), ft::random_access_iterator_tag());
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+    template <class ForwardIterator>
+void vector<T, Allocator, GrowthPolicy>::range_insert_(iterator position,
+        ForwardIterator first, ForwardIterator last, ft::forward_iterator_tag)
+{
+    difference_type shift = &*position - begin_;
+    difference_type n = ft::distance(first, last);
+
+    reserve(size_ + n);
+    pointer pos = begin_ + shift;
+    move_(pos + n, pos, size_ - shift);
+    size_type i = 0;
+    try {
+        for (; first != last; ++first, ++i) {
+            alloc_.construct(pos + i, *first);
+        }
+    }
+    catch (...) {
+        close_gap_(pos, i, n, size_ - shift);
+        throw;
+    }
+    size_ += n;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+inline typename vector<T, Allocator, GrowthPolicy>::size_type
+vector<T, Allocator, GrowthPolicy>::next_capacity_(size_type n) const
+{
+    return growth_.grow(capacity_, n, sizeof(value_type));
+}
+
+// Undoes an insert that threw: destroys the built elements of the gap at
+// pos and moves the tail of len elements back over it.
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::close_gap_(pointer pos, size_type built,
+                                                    size_type gap, size_type len)
+{
+    while (built) {
+        alloc_.destroy(pos + --built);
+    }
+    move_(pos, pos + gap, len);
+}
+
+// Shifts [src, src + len) to dst, the ranges may overlap.
+template <class T, class Allocator, class GrowthPolicy>
+inline void vector<T, Allocator, GrowthPolicy>::move_(pointer dst, pointer src, difference_type len)
+{
+    ft::shift_elements(alloc_, dst, src, len);
+}
+
+// Moves [src, src + len) into fresh storage that does not overlap it.
+template <class T, class Allocator, class GrowthPolicy>
+inline void vector<T, Allocator, GrowthPolicy>::relocate_(pointer dst, pointer src, size_type len)
+{
+    ft::relocate_elements(alloc_, dst, src, len);
+}
+
+// Grows the buffer with the allocator's reallocate, false when it declined.
+template <class T, class Allocator, class GrowthPolicy>
+inline bool vector<T, Allocator, GrowthPolicy>::reallocate_(size_type n, ft::true_type)
+{
+    pointer p = alloc_.reallocate(begin_, capacity_, n);
+    if (!p) {
+        return false;
+    }
+    begin_ = p;
+    capacity_ = n;
+    return true;
+}
+
+// Constructs n copies of val at p. Trivially copyable values are written
+// by the fill kernel in simd.hpp: memset when all their bytes are the same,
+// SIMD broadcast stores otherwise.
+template <class T, class Allocator, class GrowthPolicy>
+inline void vector<T, Allocator, GrowthPolicy>::construct_fill_(pointer p, size_type n,
+                                                              const value_type& val)
+{
+    construct_fill_(p, n, val, ft::is_trivially_copyable<value_type>());
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+inline void vector<T, Allocator, GrowthPolicy>::construct_fill_(pointer p, size_type n,
+                                            const value_type& val, ft::true_type)
+{
+    ft::simd::fill(static_cast<void*>(p), static_cast<const void*>(&val),
+                   sizeof(value_type), n);
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::construct_fill_(pointer p, size_type n,
+                                            const value_type& val, ft::false_type)
+{
+    size_type i = 0;
+    try {
+        for (; i < n; ++i) {
+            alloc_.construct(p + i, val);
+        }
+    }
+    catch (...) {
+        while (i) {
+            alloc_.destroy(p + --i);
         }
-    } else if (dst > src) {
-        for (difference_type i = len - 1; i >= 0; --i) {
+        throw;
+    }
+}
+
+// Copy constructs [src, src + n) into dst, memcpy for trivially copyable
+// values.
+template <class T, class Allocator, class GrowthPolicy>
+inline void vector<T, Allocator, GrowthPolicy>::construct_copy_(pointer dst,
+                                            const_pointer src, size_type n)
+{
+    construct_copy_(dst, src, n, ft::is_trivially_copyable<value_type>());
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+inline void vector<T, Allocator, GrowthPolicy>::construct_copy_(pointer dst,
+                            const_pointer src, size_type n, ft::true_type)
+{
+    if (n) {
+        std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src),
+                    n * sizeof(value_type));
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::construct_copy_(pointer dst,
+                            const_pointer src, size_type n, ft::false_type)
+{
+    size_type i = 0;
+    try {
+        for (; i < n; ++i) {
             alloc_.construct(dst + i, src[i]);
-            alloc_.destroy(src + i);
         }
     }
+    catch (...) {
+        while (i) {
+            alloc_.destroy(dst + --i);
+        }
+        throw;
+    }
+}
+
+// Makes the vector a copy of [src, src + n). Live elements are assigned
+// over so they can keep their own storage, only the tail is constructed
+// and only the excess destroyed. A buffer too small is replaced outright.
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::assign_copy_(const_pointer src, size_type n)
+{
+    if (n > capacity_) {
+        clear();
+        reserve(n);
+        construct_copy_(begin_, src, n);
+        size_ = n;
+        return;
+    }
+    size_type live = n < size_ ? n : size_;
+    for (size_type i = 0; i < live; ++i) {
+        begin_[i] = src[i];
+    }
+    if (n > size_) {
+        construct_copy_(begin_ + size_, src + size_, n - size_);
+        size_ = n;
+    }
+    while (size_ > n) {
+        alloc_.destroy(begin_ + --size_);
+    }
+}
+
+#ifdef FT_CXX11
+// Builds the first n elements of the buffer by calling chunk(first, last)
+// for slices of it on the pool. A chunk that throws destroys its own
+// elements; the slices that did finish are destroyed here before the
+// exception is passed on.
+template <class T, class Allocator, class GrowthPolicy>
+    template <class Chunk>
+void vector<T, Allocator, GrowthPolicy>::parallel_construct_(size_type n,
+                                    const ft::parallel_policy& par, Chunk chunk)
+{
+    if (n * sizeof(value_type) < par.threshold || par.pool->size() < 2) {
+        chunk(0, n);
+        return;
+    }
+    const size_type   parts = par.pool->size() * 4;
+    const size_type   step = (n + parts - 1) / parts;
+    ft::vector<char>  built(parts, 0);
+
+    try {
+        par.pool->run(parts, [&](std::size_t i) {
+            size_type first = i * step < n ? i * step : n;
+            size_type last = first + step < n ? first + step : n;
+            chunk(first, last);
+            built[i] = 1;
+        });
+    }
+    catch (...) {
+        for (size_type i = 0; i < parts; ++i) {
+            for (size_type k = i * step; built[i] && k < n && k < (i + 1) * step; ++k) {
+                alloc_.destroy(begin_ + k);
+            }
+        }
+        throw;
+    }
+}
+#endif
+
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::default_init_(size_type n, ft::false_type)
+{
+    while (size_ < n) {
+        ::new (static_cast<void*>(begin_ + size_)) value_type;
+        ++size_;
+    }
 }
 
-template <class T, class Allocator>
-inline void vector<T, Allocator>::destroy_()
+// Calls pred once per element, in order. Each run of kept elements is
+// relocated down over the gap the removed ones left, so the vector is
+// shifted once in total rather than once per removal. If pred throws,
+// the gap is closed before the exception is passed on.
+template <class T, class Allocator, class GrowthPolicy>
+    template <class Predicate>
+typename vector<T, Allocator, GrowthPolicy>::size_type
+vector<T, Allocator, GrowthPolicy>::remove_if_(Predicate pred)
+{
+    pointer end = begin_ + size_;
+    pointer p = begin_;
+    while (p != end && !pred(*p)) {
+        ++p;
+    }
+    pointer out = p;
+    pointer run = p;
+    try {
+        while (p != end) {
+            alloc_.destroy(p++);
+            run = p;
+            while (p != end && !pred(*p)) {
+                ++p;
+            }
+            if (p - run == 1 && relocatable_::value) {
+                // runs between removals are often single elements
+                std::memcpy(static_cast<void*>(out), static_cast<const void*>(run),
+                            sizeof(value_type));
+            } else {
+                move_(out, run, p - run);
+            }
+            out += p - run;
+            run = p;
+        }
+    }
+    catch (...) {
+        move_(out, run, end - run);
+        size_ = (out - begin_) + (end - run);
+        throw;
+    }
+    size_ = out - begin_;
+    return end - out;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+inline void vector<T, Allocator, GrowthPolicy>::destroy_()
 {
     clear();
     alloc_.deallocate(begin_, capacity_);
@@ -447,8 +1178,8 @@ inline void vector<T, Allocator>::destroy_()
 }; // namespace ft
 
 namespace std {
-	template <class T, class A>
-	void swap(ft::vector<T, A> &v1, ft::vector<T, A> &v2 ) {
+	template <class T, class A, class G>
+	void swap(ft::vector<T, A, G> &v1, ft::vector<T, A, G> &v2 ) {
 		v1.swap(v2);
 	}
 
@@ -458,4 +1189,6 @@ namespace std {
 	// }
 }; //namespace std
 
+#include "vector_bool.hpp"
+
 #endif // VECTOR_H
@@ -0,0 +1,870 @@
+#ifndef VECTOR_BOOL_H
+#define VECTOR_BOOL_H
+
+#include <cstring>
+#include <stdexcept>
+
+#include "simd.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+// vector<bool> packs its flags into 64 bit words, bit i of the vector is
+// bit i % 64 of word i / 64. The bits of the last word past size() are
+// kept at zero, so count, find and comparisons work on whole words.
+
+class bit_reference
+{
+public:
+    bit_reference(simd::word* p, unsigned off) : p_(p), mask_(simd::word(1) << off) {}
+
+    operator bool() const { return (*p_ & mask_) != 0; }
+    bool operator~() const { return (*p_ & mask_) == 0; }
+
+    bit_reference& operator=(bool x)
+    {
+        if (x) {
+            *p_ |= mask_;
+        }
+        else {
+            *p_ &= ~mask_;
+        }
+        return *this;
+    }
+    bit_reference& operator=(const bit_reference& x) { return *this = bool(x); }
+
+    void flip() { *p_ ^= mask_; }
+
+    friend void swap(bit_reference a, bit_reference b)
+    {
+        bool tmp = a;
+        a = bool(b);
+        b = tmp;
+    }
+
+private:
+    simd::word* p_;
+    simd::word  mask_;
+};
+
+// Position shared by the two bit iterators: a word and a bit in it.
+class bit_iterator_base
+{
+public:
+    bit_iterator_base(simd::word* p, unsigned off) : p_(p), off_(off) {}
+
+    simd::word* word() const   { return p_;   }
+    unsigned    offset() const { return off_; }
+
+protected:
+    void bump_up_()
+    {
+        if (++off_ == 64) {
+            off_ = 0;
+            ++p_;
+        }
+    }
+    void bump_down_()
+    {
+        if (off_-- == 0) {
+            off_ = 63;
+            --p_;
+        }
+    }
+    void advance_(std::ptrdiff_t n)
+    {
+        std::ptrdiff_t d = static_cast<std::ptrdiff_t>(off_) + n;
+        std::ptrdiff_t w = d >= 0 ? d / 64 : -((63 - d) / 64);
+        p_ += w;
+        off_ = static_cast<unsigned>(d - w * 64);
+    }
+
+    simd::word* p_;
+    unsigned    off_;
+};
+
+inline std::ptrdiff_t operator-(const bit_iterator_base& a, const bit_iterator_base& b)
+{ return (a.word() - b.word()) * 64 + a.offset() - b.offset(); }
+
+inline bool operator==(const bit_iterator_base& a, const bit_iterator_base& b)
+{ return a.word() == b.word() && a.offset() == b.offset(); }
+inline bool operator!=(const bit_iterator_base& a, const bit_iterator_base& b)
+{ return !(a == b); }
+inline bool operator< (const bit_iterator_base& a, const bit_iterator_base& b)
+{ return a.word() < b.word() || (a.word() == b.word() && a.offset() < b.offset()); }
+inline bool operator> (const bit_iterator_base& a, const bit_iterator_base& b)
+{ return b < a; }
+inline bool operator<=(const bit_iterator_base& a, const bit_iterator_base& b)
+{ return !(b < a); }
+inline bool operator>=(const bit_iterator_base& a, const bit_iterator_base& b)
+{ return !(a < b); }
+
+class bit_iterator
+    : public bit_iterator_base
+    , public iterator<random_access_iterator_tag, bool, std::ptrdiff_t, void, bit_reference>
+{
+public:
+    typedef bit_iterator   iterator_type;
+    typedef bit_reference  reference;
+    typedef std::ptrdiff_t difference_type;
+
+    bit_iterator() : bit_iterator_base(NULL, 0) {}
+    bit_iterator(simd::word* p, unsigned off) : bit_iterator_base(p, off) {}
+
+// Dereference
+    reference operator*() const                   { return reference(p_, off_); }
+    reference operator[](difference_type n) const { return *(*this + n);        }
+
+// Increment/decrement
+    bit_iterator& operator++()    { bump_up_();   return *this; }
+    bit_iterator& operator--()    { bump_down_(); return *this; }
+    bit_iterator  operator++(int) { bit_iterator tmp(*this); bump_up_();   return tmp; }
+    bit_iterator  operator--(int) { bit_iterator tmp(*this); bump_down_(); return tmp; }
+
+// Arithmetic
+    bit_iterator& operator+=(difference_type n) { advance_(n);  return *this; }
+    bit_iterator& operator-=(difference_type n) { advance_(-n); return *this; }
+    bit_iterator  operator+(difference_type n) const { bit_iterator tmp(*this); return tmp += n; }
+    bit_iterator  operator-(difference_type n) const { bit_iterator tmp(*this); return tmp -= n; }
+
+    friend bit_iterator operator+(difference_type n, const bit_iterator& it) { return it + n; }
+};
+
+class bit_const_iterator
+    : public bit_iterator_base
+    , public iterator<random_access_iterator_tag, bool, std::ptrdiff_t, void, bool>
+{
+public:
+    typedef bit_const_iterator iterator_type;
+    typedef bool               reference;
+    typedef std::ptrdiff_t     difference_type;
+
+    bit_const_iterator() : bit_iterator_base(NULL, 0) {}
+    bit_const_iterator(const simd::word* p, unsigned off)
+        : bit_iterator_base(const_cast<simd::word*>(p), off) {}
+    bit_const_iterator(const bit_iterator& it) : bit_iterator_base(it.word(), it.offset()) {}
+
+// Dereference
+    reference operator*() const                   { return (*p_ >> off_) & 1; }
+    reference operator[](difference_type n) const { return *(*this + n);      }
+
+// Increment/decrement
+    bit_const_iterator& operator++()    { bump_up_();   return *this; }
+    bit_const_iterator& operator--()    { bump_down_(); return *this; }
+    bit_const_iterator  operator++(int) { bit_const_iterator tmp(*this); bump_up_();   return tmp; }
+    bit_const_iterator  operator--(int) { bit_const_iterator tmp(*this); bump_down_(); return tmp; }
+
+// Arithmetic
+    bit_const_iterator& operator+=(difference_type n) { advance_(n);  return *this; }
+    bit_const_iterator& operator-=(difference_type n) { advance_(-n); return *this; }
+    bit_const_iterator  operator+(difference_type n) const
+    { bit_const_iterator tmp(*this); return tmp += n; }
+    bit_const_iterator  operator-(difference_type n) const
+    { bit_const_iterator tmp(*this); return tmp -= n; }
+
+    friend bit_const_iterator operator+(difference_type n, const bit_const_iterator& it)
+    { return it + n; }
+};
+
+template <class Allocator, class GrowthPolicy>
+class vector<bool, Allocator, GrowthPolicy>
+{
+public:
+
+// Member types
+    typedef bool                                     value_type;
+    typedef Allocator                                allocator_type;
+    typedef ft::bit_reference                        reference;
+    typedef bool                                     const_reference;
+    typedef ft::bit_reference*                       pointer;
+    typedef const bool*                              const_pointer;
+    typedef ft::bit_iterator                         iterator;
+    typedef ft::bit_const_iterator                   const_iterator;
+    typedef ft::reverse_iterator<iterator>           reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator>     const_reverse_iterator;
+    typedef std::ptrdiff_t                           difference_type;
+    typedef std::size_t                              size_type;
+    typedef GrowthPolicy                             growth_policy_type;
+    typedef simd::word                               word_type;
+
+    static const size_type bits_per_word = 64;
+    static const size_type npos = static_cast<size_type>(-1);
+
+// Constructors
+    explicit vector(const allocator_type& alloc = allocator_type());
+    explicit vector(size_type n, const value_type& val = value_type(),
+                    const allocator_type& alloc = allocator_type());
+    template <class InputIterator>
+             vector(InputIterator first, InputIterator last,
+                    const allocator_type& alloc = allocator_type(),
+                    typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type = 0);
+             vector(const vector& x);
+#ifdef FT_CXX11
+             vector(vector&& x);
+#endif
+
+    ~vector();
+
+    vector& operator=(const vector& x);
+#ifdef FT_CXX11
+    vector& operator=(vector&& x);
+#endif
+
+// Iterators
+    iterator               begin()        { return iterator(words_, 0);                 }
+    const_iterator         begin() const  { return const_iterator(words_, 0);           }
+    iterator               end()          { return begin() + size_;                     }
+    const_iterator         end() const    { return begin() + size_;                     }
+    reverse_iterator       rbegin()       { return reverse_iterator(end());             }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end());       }
+    reverse_iterator       rend()         { return reverse_iterator(begin());           }
+    const_reverse_iterator rend() const   { return const_reverse_iterator(begin());     }
+
+// Capacity
+    size_type size() const     { return size_; }
+    size_type max_size() const { return word_allocator_(alloc_).max_size() * bits_per_word; }
+    void      resize(size_type n, value_type val = value_type());
+    size_type capacity() const { return capacity_ * bits_per_word; }
+    bool      empty() const    { return !size_; }
+    void      reserve(size_type n);
+    void      shrink_to_fit();
+
+// Element access
+    reference       operator[](size_type n)       { return reference(words_ + n / 64, n % 64); }
+    const_reference operator[](size_type n) const { return (words_[n / 64] >> n % 64) & 1;    }
+    reference       at(size_type n);
+    const_reference at(size_type n) const;
+    reference       front()       { return (*this)[0];         }
+    const_reference front() const { return (*this)[0];         }
+    reference       back()        { return (*this)[size_ - 1]; }
+    const_reference back() const  { return (*this)[size_ - 1]; }
+
+    // the packed words, word_count() of them
+    word_type*       words()            { return words_; }
+    const word_type* words() const      { return words_; }
+    size_type        word_count() const { return words_for_(size_); }
+
+// Modifiers
+    template <class InputIterator>
+    void     assign(InputIterator first, InputIterator last,
+                    typename ft::enable_if<
+                    !ft::is_integral<InputIterator>::value, bool>::type = 0);
+    void     assign(size_type n, const value_type& val);
+    void     push_back(const value_type& val);
+    void     pop_back();
+    iterator insert(iterator position, const value_type& val);
+    void     insert(iterator position, size_type n, const value_type& val);
+    template <class InputIterator>
+    void     insert(iterator position, InputIterator first, InputIterator last,
+                    typename ft::enable_if<
+                    !ft::is_integral<InputIterator>::value, bool>::type = 0);
+    iterator erase (iterator position);
+    iterator erase (iterator first, iterator last);
+    void     swap  (vector& x);
+    void     clear() { size_ = 0; }
+    void     flip();
+
+    static void swap(reference x, reference y)
+    {
+        bool tmp = x;
+        x = bool(y);
+        y = tmp;
+    }
+
+// Bit operations
+    // Both vectors must have the same size.
+    vector&   operator&=(const vector& x) { bitwise_(simd::bit_and, x); return *this; }
+    vector&   operator|=(const vector& x) { bitwise_(simd::bit_or, x);  return *this; }
+    vector&   operator^=(const vector& x) { bitwise_(simd::bit_xor, x); return *this; }
+    vector    operator~() const           { vector tmp(*this); tmp.flip(); return tmp; }
+
+    // Number of set bits.
+    size_type count() const { return simd::popcount(words_, word_count()); }
+    // Index of the first set bit, npos if there is none.
+    size_type find_first() const { return find_from_(0); }
+    // Index of the first set bit after pos, npos if there is none.
+    size_type find_next(size_type pos) const
+    { return pos + 1 < size_ ? find_from_(pos + 1) : npos; }
+
+// Allocator
+    allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+// Growth policy
+    growth_policy_type&       growth_policy()       { return growth_; }
+    const growth_policy_type& growth_policy() const { return growth_; }
+
+private:
+    typedef typename allocator_type::template rebind<word_type>::other word_allocator_;
+
+    word_allocator_    alloc_;
+    growth_policy_type growth_;
+    word_type*         words_;
+    size_type          size_;
+    size_type          capacity_; // in words
+
+    static size_type words_for_(size_type bits) { return (bits + 63) / 64; }
+    static word_type low_mask_(size_type k)
+    { return k >= 64 ? ~word_type(0) : (word_type(1) << k) - 1; }
+
+    size_type index_(const_iterator it) const { return it - begin(); }
+
+    void      grow_(size_type n);
+    void      zero_words_(size_type from_bits, size_type to_bits);
+    void      zero_tail_();
+    void      fill_(size_type pos, size_type n, bool val);
+    word_type get_(size_type pos, size_type k) const;
+    void      put_(size_type pos, size_type k, word_type v);
+    void      move_bits_(size_type dst, size_type src, size_type len);
+    void      open_gap_(size_type pos, size_type n);
+    void      bitwise_(simd::bit_op op, const vector& x);
+    size_type find_from_(size_type pos) const;
+
+    template <class InputIterator>
+    void    range_insert_(size_type pos, InputIterator first,
+                          InputIterator last, ft::input_iterator_tag);
+    template <class ForwardIterator>
+    void    range_insert_(size_type pos, ForwardIterator first,
+                          ForwardIterator last, ft::forward_iterator_tag);
+    void    destroy_();
+};
+
+template <class Allocator, class GrowthPolicy>
+const typename vector<bool, Allocator, GrowthPolicy>::size_type
+vector<bool, Allocator, GrowthPolicy>::bits_per_word;
+
+template <class Allocator, class GrowthPolicy>
+const typename vector<bool, Allocator, GrowthPolicy>::size_type
+vector<bool, Allocator, GrowthPolicy>::npos;
+
+/***** Constructors *****/
+
+template <class Allocator, class GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>::vector(const allocator_type& alloc)
+    : alloc_(alloc)
+    , words_(NULL)
+    , size_(0)
+    , capacity_(0)
+{
+}
+
+template <class Allocator, class GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>::vector(size_type n, const value_type& val,
+                                              const allocator_type& alloc)
+    : alloc_(alloc)
+    , words_(NULL)
+    , size_(0)
+    , capacity_(0)
+{
+    assign(n, val);
+}
+
+template <class Allocator, class GrowthPolicy>
+    template <class InputIterator>
+vector<bool, Allocator, GrowthPolicy>::vector(InputIterator first, InputIterator last,
+const allocator_type& alloc,
+typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type)
+    : alloc_(alloc)
+    , words_(NULL)
+    , size_(0)
+    , capacity_(0)
+{
+    try {
+        range_insert_(0, first, last, ft::iterator_category(first));
+    }
+    catch (...) {
+        destroy_();
+        throw;
+    }
+}
+
+template <class Allocator, class GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>::vector(const vector& x)
+    : alloc_(x.alloc_)
+    , words_(NULL)
+    , size_(0)
+    , capacity_(0)
+{
+    *this = x;
+}
+
+#ifdef FT_CXX11
+template <class Allocator, class GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>::vector(vector&& x)
+    : alloc_(std::move(x.alloc_))
+    , words_(x.words_)
+    , size_(x.size_)
+    , capacity_(x.capacity_)
+{
+    x.words_ = NULL;
+    x.size_ = 0;
+    x.capacity_ = 0;
+}
+#endif
+
+template <class Allocator, class GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>::~vector()
+{
+    destroy_();
+}
+
+template <class Allocator, class GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>&
+vector<bool, Allocator, GrowthPolicy>::operator=(const vector& other)
+{
+    if (this == &other)
+        return *this;
+    size_ = 0;
+    reserve(other.size_);
+    if (other.size_) {
+        std::memcpy(words_, other.words_, other.word_count() * sizeof(word_type));
+    }
+    size_ = other.size_;
+    return *this;
+}
+
+#ifdef FT_CXX11
+template <class Allocator, class GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>&
+vector<bool, Allocator, GrowthPolicy>::operator=(vector&& other)
+{
+    if (this == &other)
+        return *this;
+    destroy_();
+    alloc_ = std::move(other.alloc_);
+    words_ = other.words_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    other.words_ = NULL;
+    other.size_ = 0;
+    other.capacity_ = 0;
+    return *this;
+}
+#endif
+
+/***** Capacity *****/
+
+template <class Allocator, class GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::resize(size_type n, value_type val)
+{
+    if (n <= size_) {
+        size_ = n;
+        zero_tail_();
+        return;
+    }
+    reserve(n);
+    zero_words_(size_, n);
+    fill_(size_, n - size_, val);
+    size_ = n;
+}
+
+template <class Allocator, class GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::reserve(size_type n)
+{
+    if (words_for_(n) > capacity_) {
+        grow_(growth_.grow(capacity_, words_for_(n), sizeof(word_type)));
+    }
+}
+
+template <class Allocator, class GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::shrink_to_fit()
+{
+    if (word_count() < capacity_) {
+        grow_(word_count());
+    }
+}
+
+/***** Element access *****/
+
+template <class Allocator, class GrowthPolicy>
+typename vector<bool, Allocator, GrowthPolicy>::reference
+vector<bool, Allocator, GrowthPolicy>::at(size_type n)
+{
+    if (n >= size_) {
+        throw std::out_of_range("vector");
+    }
+    return (*this)[n];
+}
+
+template <class Allocator, class GrowthPolicy>
+typename vector<bool, Allocator, GrowthPolicy>::const_reference
+vector<bool, Allocator, GrowthPolicy>::at(size_type n) const
+{
+    if (n >= size_) {
+        throw std::out_of_range("vector");
+    }
+    return (*this)[n];
+}
+
+/***** Modifiers *****/
+
+template <class Allocator, class GrowthPolicy>
+    template <class InputIterator>
+void vector<bool, Allocator, GrowthPolicy>::assign(InputIterator first, InputIterator last,
+typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type)
+{
+    size_ = 0;
+    range_insert_(0, first, last, ft::iterator_category(first));
+}
+
+template <class Allocator, class GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::assign(size_type n, const value_type& val)
+{
+    size_ = 0;
+    resize(n, val);
+}
+
+template <class Allocator, class GrowthPolicy>
+inline void vector<bool, Allocator, GrowthPolicy>::push_back(const value_type& val)
+{
+    if (size_ % 64 == 0) {
+        reserve(size_ + 1);
+        words_[size_ / 64] = val;
+    }
+    else if (val) {
+        words_[size_ / 64] |= word_type(1) << size_ % 64;
+    }
+    ++size_;
+}
+
+template <class Allocator, class GrowthPolicy>
+inline void vector<bool, Allocator, GrowthPolicy>::pop_back()
+{
+    --size_;
+    words_[size_ / 64] &= ~(word_type(1) << size_ % 64);
+}
+
+template <class Allocator, class GrowthPolicy>
+typename vector<bool, Allocator, GrowthPolicy>::iterator
+vector<bool, Allocator, GrowthPolicy>::insert(iterator position, const value_type& val)
+{
+    size_type pos = index_(position);
+    insert(position, 1, val);
+    return begin() + pos;
+}
+
+template <class Allocator, class GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::insert(iterator position, size_type n,
+                                                   const value_type& val)
+{
+    size_type pos = index_(position);
+    open_gap_(pos, n);
+    fill_(pos, n, val);
+}
+
+template <class Allocator, class GrowthPolicy>
+    template <class InputIterator>
+void vector<bool, Allocator, GrowthPolicy>::insert(iterator position,
+            InputIterator first, InputIterator last,
+            typename ft::enable_if<!ft::is_integral<InputIterator>::value, bool>::type)
+{
+    range_insert_(index_(position), first, last, ft::iterator_category(first));
+}
+
+template <class Allocator, class GrowthPolicy>
+typename vector<bool, Allocator, GrowthPolicy>::iterator
+vector<bool, Allocator, GrowthPolicy>::erase(iterator position)
+{
+    return erase(position, position + 1);
+}
+
+// The bits past last move down in word sized chunks.
+template <class Allocator, class GrowthPolicy>
+typename vector<bool, Allocator, GrowthPolicy>::iterator
+vector<bool, Allocator, GrowthPolicy>::erase(iterator first, iterator last)
+{
+    size_type pos = index_(first);
+    size_type tail = index_(last);
+
+    move_bits_(pos, tail, size_ - tail);
+    size_ -= tail - pos;
+    zero_tail_();
+    return begin() + pos;
+}
+
+template <class Allocator, class GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::swap(vector& x)
+{
+    ft::swap(alloc_, x.alloc_);
+    ft::swap(growth_, x.growth_);
+    ft::swap(words_, x.words_);
+    ft::swap(size_, x.size_);
+    ft::swap(capacity_, x.capacity_);
+}
+
+template <class Allocator, class GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::flip()
+{
+    for (size_type i = 0; i < word_count(); ++i) {
+        words_[i] = ~words_[i];
+    }
+    zero_tail_();
+}
+
+/***** Non-member function overloads *****/
+
+// Whole words compare at once, the bits past size() are zero in both.
+template <class Alloc, class G>
+inline bool operator==(const vector<bool,Alloc,G>& lhs, const vector<bool,Alloc,G>& rhs)
+{
+    std::size_t bytes = lhs.word_count() * sizeof(simd::word);
+    return lhs.size() == rhs.size()
+        && simd::mismatch(lhs.words(), rhs.words(), bytes) == bytes;
+}
+
+// The first differing word decides, at its lowest differing bit.
+template <class Alloc, class G>
+inline bool operator< (const vector<bool,Alloc,G>& lhs, const vector<bool,Alloc,G>& rhs)
+{
+    std::size_t common = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+    for (std::size_t i = 0; i * 64 < common; ++i) {
+        simd::word diff = lhs.words()[i] ^ rhs.words()[i];
+        if (!diff) {
+            continue;
+        }
+        std::size_t bit = i * 64 + simd::ctz_word(diff);
+        if (bit >= common) {
+            break;
+        }
+        return !lhs[bit];
+    }
+    return lhs.size() < rhs.size();
+}
+
+template <class Alloc, class G>
+inline vector<bool,Alloc,G> operator&(const vector<bool,Alloc,G>& lhs, const vector<bool,Alloc,G>& rhs)
+{
+    vector<bool,Alloc,G> tmp(lhs);
+    return tmp &= rhs;
+}
+
+template <class Alloc, class G>
+inline vector<bool,Alloc,G> operator|(const vector<bool,Alloc,G>& lhs, const vector<bool,Alloc,G>& rhs)
+{
+    vector<bool,Alloc,G> tmp(lhs);
+    return tmp |= rhs;
+}
+
+template <class Alloc, class G>
+inline vector<bool,Alloc,G> operator^(const vector<bool,Alloc,G>& lhs, const vector<bool,Alloc,G>& rhs)
+{
+    vector<bool,Alloc,G> tmp(lhs);
+    return tmp ^= rhs;
+}
+
+// Kept bits are written down over the removed ones, then the tail is
+// cut off once.
+template <class Alloc, class G, class Predicate>
+typename vector<bool,Alloc,G>::size_type erase_if(vector<bool,Alloc,G>& c, Predicate pred)
+{
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < c.size(); ++i) {
+        bool bit = c[i];
+        if (!pred(bit)) {
+            c[out++] = bit;
+        }
+    }
+    std::size_t removed = c.size() - out;
+    c.erase(c.begin() + out, c.end());
+    return removed;
+}
+
+template <class Alloc, class G>
+typename vector<bool,Alloc,G>::size_type erase(vector<bool,Alloc,G>& c, const bool& value)
+{
+    // what is left is a run of !value bits
+    std::size_t kept = value ? c.size() - c.count() : c.count();
+    std::size_t removed = c.size() - kept;
+    c.assign(kept, !value);
+    return removed;
+}
+
+/***** private *****/
+
+// Moves the words to a buffer of n words, n >= word_count().
+template <class Allocator, class GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::grow_(size_type n)
+{
+    word_type* words = n ? alloc_.allocate(n) : NULL;
+    if (size_) {
+        std::memcpy(words, words_, word_count() * sizeof(word_type));
+    }
+    if (words_) {
+        alloc_.deallocate(words_, capacity_);
+    }
+    if (capacity_) {
+        growth_.reallocated(word_count() * sizeof(word_type));
+    }
+    words_ = words;
+    capacity_ = n;
+}
+
+// Clears the words that hold bits [from_bits, to_bits) and no earlier bit.
+template <class Allocator, class GrowthPolicy>
+inline void vector<bool, Allocator, GrowthPolicy>::zero_words_(size_type from_bits,
+                                                              size_type to_bits)
+{
+    size_type first = words_for_(from_bits);
+    size_type last = words_for_(to_bits);
+    if (last > first) {
+        std::memset(words_ + first, 0, (last - first) * sizeof(word_type));
+    }
+}
+
+template <class Allocator, class GrowthPolicy>
+inline void vector<bool, Allocator, GrowthPolicy>::zero_tail_()
+{
+    if (size_ % 64) {
+        words_[size_ / 64] &= low_mask_(size_ % 64);
+    }
+}
+
+// Sets or clears bits [pos, pos + n), a partial word at each end and
+// memset in between.
+template <class Allocator, class GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::fill_(size_type pos, size_type n, bool val)
+{
+    while (n && pos % 64) {
+        size_type k = 64 - pos % 64 < n ? 64 - pos % 64 : n;
+        put_(pos, k, val ? low_mask_(k) : 0);
+        pos += k;
+        n -= k;
+    }
+    if (n >= 64) {
+        std::memset(words_ + pos / 64, val ? 0xFF : 0, n / 64 * sizeof(word_type));
+        pos += n / 64 * 64;
+        n %= 64;
+    }
+    if (n) {
+        put_(pos, n, val ? low_mask_(n) : 0);
+    }
+}
+
+// The k <= 64 bits starting at pos, in the low bits of the result.
+template <class Allocator, class GrowthPolicy>
+inline typename vector<bool, Allocator, GrowthPolicy>::word_type
+vector<bool, Allocator, GrowthPolicy>::get_(size_type pos, size_type k) const
+{
+    size_type off = pos % 64;
+    word_type v = words_[pos / 64] >> off;
+    if (off + k > 64) {
+        v |= words_[pos / 64 + 1] << (64 - off);
+    }
+    return v & low_mask_(k);
+}
+
+// Writes the k <= 64 low bits of v at pos.
+template <class Allocator, class GrowthPolicy>
+inline void vector<bool, Allocator, GrowthPolicy>::put_(size_type pos, size_type k,
+                                                       word_type v)
+{
+    size_type off = pos % 64;
+    word_type mask = low_mask_(k);
+    word_type* w = words_ + pos / 64;
+
+    w[0] = (w[0] & ~(mask << off)) | (v << off);
+    if (off + k > 64) {
+        word_type spill = low_mask_(off + k - 64);
+        w[1] = (w[1] & ~spill) | (v >> (64 - off));
+    }
+}
+
+// Copies bits [src, src + len) to dst, 64 at a time. The ranges may
+// overlap: the copy runs away from the side it writes to.
+template <class Allocator, class GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::move_bits_(size_type dst, size_type src,
+                                                      size_type len)
+{
+    if (dst < src) {
+        for (size_type i = 0; i < len; i += 64) {
+            size_type k = len - i < 64 ? len - i : 64;
+            put_(dst + i, k, get_(src + i, k));
+        }
+    }
+    else if (dst > src) {
+        for (size_type i = len; i > 0; ) {
+            size_type k = i < 64 ? i : 64;
+            i -= k;
+            put_(dst + i, k, get_(src + i, k));
+        }
+    }
+}
+
+// Makes room for n bits at pos; the bits of the gap are unspecified.
+template <class Allocator, class GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::open_gap_(size_type pos, size_type n)
+{
+    reserve(size_ + n);
+    zero_words_(size_, size_ + n);
+    move_bits_(pos + n, pos, size_ - pos);
+    size_ += n;
+}
+
+template <class Allocator, class GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::bitwise_(simd::bit_op op, const vector& x)
+{
+    if (x.size_ != size_) {
+        throw std::invalid_argument("vector<bool>: sizes differ");
+    }
+    simd::bitwise(op, words_, x.words_, word_count());
+}
+
+// Skips zero words whole and finds the bit in the first other one.
+template <class Allocator, class GrowthPolicy>
+typename vector<bool, Allocator, GrowthPolicy>::size_type
+vector<bool, Allocator, GrowthPolicy>::find_from_(size_type pos) const
+{
+    size_type i = pos / 64;
+    size_type n = word_count();
+    if (i >= n) {
+        return npos;
+    }
+    word_type w = words_[i] & ~low_mask_(pos % 64);
+    while (!w) {
+        if (++i == n) {
+            return npos;
+        }
+        w = words_[i];
+    }
+    return i * 64 + simd::ctz_word(w);
+}
+
+template <class Allocator, class GrowthPolicy>
+    template <class InputIterator>
+void vector<bool, Allocator, GrowthPolicy>::range_insert_(size_type pos,
+            InputIterator first, InputIterator last, ft::input_iterator_tag)
+{
+    if (pos == size_) {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+        return;
+    }
+    vector tmp(first, last, allocator_type(alloc_));
+    range_insert_(pos, tmp.begin(), tmp.end(), ft::random_access_iterator_tag());
+}
+
+template <class Allocator, class GrowthPolicy>
+    template <class ForwardIterator>
+void vector<bool, Allocator, GrowthPolicy>::range_insert_(size_type pos,
+            ForwardIterator first, ForwardIterator last, ft::forward_iterator_tag)
+{
+    open_gap_(pos, ft::distance(first, last));
+    for (iterator it = begin() + pos; first != last; ++first, ++it) {
+        *it = bool(*first);
+    }
+}
+
+template <class Allocator, class GrowthPolicy>
+inline void vector<bool, Allocator, GrowthPolicy>::destroy_()
+{
+    if (words_) {
+        alloc_.deallocate(words_, capacity_);
+    }
+    words_ = NULL;
+    size_ = 0;
+    capacity_ = 0;
+}
+
+}; // namespace ft
+
+#endif // VECTOR_BOOL_H